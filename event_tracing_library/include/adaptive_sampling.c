@@ -0,0 +1,126 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+#include "adaptive_sampling.h"
+
+// Two-sided 95% critical values of the Student's t distribution, indexed by the degrees of freedom minus one
+static const double t_table[ADAPTIVE_T_TABLE_SIZE] = {
+  12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+  2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+/**
+ * @brief Creates an adaptive_sampling struct, ready for the first point.
+ * @param target_ci The target half-width of the confidence interval, as a fraction of the mean (e.g. 0.05 for 5%).
+ * @param warmup The number of warm-up repetitions of each point.
+ * @param max_repetitions The maximum number of measured repetitions of each point. It is raised to ADAPTIVE_MIN_REPETITIONS if lower.
+ * @return A pointer to a newly created adaptive_sampling struct. This structure must be deallocated using the
+ * "destroy_adaptive_sampling()" function when you're done with it.
+*/
+adaptive_sampling* create_adaptive_sampling(double target_ci, int warmup, int max_repetitions){
+  adaptive_sampling* sampling;
+
+  sampling = (adaptive_sampling*)calloc(1, sizeof(*sampling));
+  if(sampling == NULL){
+    fprintf(stderr, "create_adaptive_sampling: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  sampling->target_ci = target_ci;
+  sampling->warmup = warmup;
+  sampling->max_repetitions = max_repetitions > ADAPTIVE_MIN_REPETITIONS ? max_repetitions : ADAPTIVE_MIN_REPETITIONS;
+  return sampling;
+}
+
+/**
+ * @brief Starts a new point, discarding the repetitions of the previous one.
+ * @param sampling A pointer to an adaptive_sampling struct.
+*/
+void adaptive_sampling_reset(adaptive_sampling* sampling){
+  sampling->n_warmup = 0;
+  sampling->n = 0;
+  sampling->mean = 0;
+  sampling->m2 = 0;
+  sampling->status = ADAPTIVE_RUNNING;
+}
+
+/**
+ * @brief Tells whether the next repetition of the point in progress is a warm-up, counting it if so. A warm-up repetition must be
+ * run without being measured nor logged.
+ * @param sampling A pointer to an adaptive_sampling struct.
+ * @return 1 if the next repetition is a warm-up, 0 otherwise.
+*/
+short adaptive_sampling_warmup(adaptive_sampling* sampling){
+  if(sampling->n_warmup >= sampling->warmup)
+    return 0;
+  sampling->n_warmup++;
+  return 1;
+}
+
+/**
+ * @brief Computes the 95% confidence interval of the mean of the metric of the point in progress. It has zero width until two
+ * repetitions have been measured.
+ * @param sampling A pointer to an adaptive_sampling struct.
+ * @param low A pointer to the variable where to store the lower bound.
+ * @param high A pointer to the variable where to store the upper bound.
+*/
+void adaptive_sampling_interval(const adaptive_sampling* sampling, double* low, double* high){
+  double critical, half_width = 0;
+  int df = sampling->n - 1;
+
+  if(df > 0){
+    critical = df <= ADAPTIVE_T_TABLE_SIZE ? t_table[df - 1] : ADAPTIVE_Z_95;
+    half_width = critical * sqrt(sampling->m2 / df / sampling->n);
+  }
+  *low = sampling->mean - half_width;
+  *high = sampling->mean + half_width;
+}
+
+/**
+ * @brief Adds the metric of a measured repetition to the point in progress and checks whether the point is done. It sets the
+ * extra metrics of an exec_info struct named "ci_repetition" (the number of the repetition in the point, from 1), "warmup_repetitions",
+ * "ci_low" and "ci_high" (the bounds of the confidence interval of the repetitions measured so far, rounded to the unit of the
+ * metric) and "ci_status" (ADAPTIVE_RUNNING, or the reason why the point is done). The last repetition of a point carries its
+ * final number of repetitions and confidence interval.
+ * @param sampling A pointer to an adaptive_sampling struct.
+ * @param value The metric of the repetition.
+ * @param e_info A pointer to an exec_info struct. Set it to NULL in order to only update the fields of the struct.
+ * @return 1 if the point is done, 0 otherwise.
+*/
+short adaptive_sampling_add(adaptive_sampling* sampling, double value, exec_info* e_info){
+  double delta, low, high;
+
+  sampling->n++;
+  delta = value - sampling->mean;
+  sampling->mean += delta / sampling->n;
+  sampling->m2 += delta * (value - sampling->mean);
+  adaptive_sampling_interval(sampling, &low, &high);
+
+  // A metric that is always 0, such as the switches of a short job, has a zero width interval and is done as well
+  if(sampling->n >= ADAPTIVE_MIN_REPETITIONS && (high - low) / 2 <= sampling->target_ci * fabs(sampling->mean))
+    sampling->status = ADAPTIVE_REACHED;
+  else if(sampling->n >= sampling->max_repetitions)
+    sampling->status = ADAPTIVE_MAX_REACHED;
+
+  if(e_info != NULL){
+    exec_info_set_metric(e_info, "ci_repetition", sampling->n);
+    exec_info_set_metric(e_info, "warmup_repetitions", sampling->n_warmup);
+    exec_info_set_metric(e_info, "ci_low", llround(low));
+    exec_info_set_metric(e_info, "ci_high", llround(high));
+    exec_info_set_metric(e_info, "ci_status", sampling->status);
+  }
+  return sampling->status != ADAPTIVE_RUNNING;
+}
+
+/**
+ * @brief Frees up the memory allocated for an adaptive_sampling struct.
+ * @param sampling A pointer to an adaptive_sampling struct.
+*/
+void destroy_adaptive_sampling(adaptive_sampling* sampling){
+  free(sampling);
+}
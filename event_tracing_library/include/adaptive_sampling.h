@@ -0,0 +1,84 @@
+#ifndef ADAPTIVE_SAMPLING_H_
+#define ADAPTIVE_SAMPLING_H_
+
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+
+#define ADAPTIVE_MIN_REPETITIONS 3		///>Minimum number of measured repetitions of a point before its confidence interval is checked.
+#define ADAPTIVE_T_TABLE_SIZE 30			///>Number of degrees of freedom whose Student's t critical value is tabulated.
+#define ADAPTIVE_Z_95 1.960						///>Critical value of the normal distribution, used beyond ADAPTIVE_T_TABLE_SIZE degrees of freedom.
+#define ADAPTIVE_RUNNING 0						///>Status of a point whose repetitions are still running.
+#define ADAPTIVE_REACHED 1						///>Status of a point whose confidence interval reached the target.
+#define ADAPTIVE_MAX_REACHED 2				///>Status of a point stopped at the maximum number of repetitions without reaching the target.
+
+/**
+ * @brief A structure that repeats the jobs of a point (the same workload, parameter and policy) until the 95% confidence interval
+ * of the mean of a metric is narrower than a target fraction of the mean, or until a maximum number of repetitions. The first
+ * repetitions of each point are warm-ups, discarded so that cold caches and page faults don't widen the interval. The mean and the
+ * variance are updated online with Welford's algorithm, and the interval uses the Student's t distribution.
+*/
+typedef struct adaptive_sampling{
+	double target_ci; ///> The target half-width of the confidence interval, as a fraction of the mean.
+	int warmup; ///> The number of warm-up repetitions of each point.
+	int max_repetitions; ///> The maximum number of measured repetitions of each point.
+	int n_warmup; ///> The number of warm-up repetitions of the point in progress.
+	int n; ///> The number of measured repetitions of the point in progress.
+	double mean; ///> The mean of the metric of the point in progress.
+	double m2; ///> The sum of the squared differences from the mean of the point in progress.
+	short status; ///> ADAPTIVE_RUNNING, ADAPTIVE_REACHED or ADAPTIVE_MAX_REACHED.
+} adaptive_sampling;
+
+/**
+ * @brief Creates an adaptive_sampling struct, ready for the first point.
+ * @param target_ci The target half-width of the confidence interval, as a fraction of the mean (e.g. 0.05 for 5%).
+ * @param warmup The number of warm-up repetitions of each point.
+ * @param max_repetitions The maximum number of measured repetitions of each point. It is raised to ADAPTIVE_MIN_REPETITIONS if lower.
+ * @return A pointer to a newly created adaptive_sampling struct. This structure must be deallocated using the
+ * "destroy_adaptive_sampling()" function when you're done with it.
+*/
+adaptive_sampling* create_adaptive_sampling(double target_ci, int warmup, int max_repetitions);
+
+/**
+ * @brief Starts a new point, discarding the repetitions of the previous one.
+ * @param sampling A pointer to an adaptive_sampling struct.
+*/
+void adaptive_sampling_reset(adaptive_sampling* sampling);
+
+/**
+ * @brief Tells whether the next repetition of the point in progress is a warm-up, counting it if so. A warm-up repetition must be
+ * run without being measured nor logged.
+ * @param sampling A pointer to an adaptive_sampling struct.
+ * @return 1 if the next repetition is a warm-up, 0 otherwise.
+*/
+short adaptive_sampling_warmup(adaptive_sampling* sampling);
+
+/**
+ * @brief Adds the metric of a measured repetition to the point in progress and checks whether the point is done. It sets the
+ * extra metrics of an exec_info struct named "ci_repetition" (the number of the repetition in the point, from 1), "warmup_repetitions",
+ * "ci_low" and "ci_high" (the bounds of the confidence interval of the repetitions measured so far, rounded to the unit of the
+ * metric) and "ci_status" (ADAPTIVE_RUNNING, or the reason why the point is done). The last repetition of a point carries its
+ * final number of repetitions and confidence interval.
+ * @param sampling A pointer to an adaptive_sampling struct.
+ * @param value The metric of the repetition.
+ * @param e_info A pointer to an exec_info struct. Set it to NULL in order to only update the fields of the struct.
+ * @return 1 if the point is done, 0 otherwise.
+*/
+short adaptive_sampling_add(adaptive_sampling* sampling, double value, exec_info* e_info);
+
+/**
+ * @brief Computes the 95% confidence interval of the mean of the metric of the point in progress. It has zero width until two
+ * repetitions have been measured.
+ * @param sampling A pointer to an adaptive_sampling struct.
+ * @param low A pointer to the variable where to store the lower bound.
+ * @param high A pointer to the variable where to store the upper bound.
+*/
+void adaptive_sampling_interval(const adaptive_sampling* sampling, double* low, double* high);
+
+/**
+ * @brief Frees up the memory allocated for an adaptive_sampling struct.
+ * @param sampling A pointer to an adaptive_sampling struct.
+*/
+void destroy_adaptive_sampling(adaptive_sampling* sampling);
+
+#endif
@@ -0,0 +1,225 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include "buffer_monitor.h"
+
+/**
+ * @brief Creates a buffer_monitor struct for the ring buffers of a tracing_session.
+ * @param session A pointer to a tracing_session struct.
+ * @return A pointer to a newly created buffer_monitor struct. This structure must be deallocated using the "destroy_buffer_monitor()"
+ * function when you're done with it.
+*/
+buffer_monitor* create_buffer_monitor(tracing_session* session){
+  buffer_monitor* monitor;
+  char stats_path[PATH_MAX];
+
+  monitor = (buffer_monitor*)calloc(1, sizeof(*monitor));
+  if(monitor == NULL){
+    fprintf(stderr, "create_buffer_monitor: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  monitor->session = session;
+  monitor->n_cpus = sysconf(_SC_NPROCESSORS_CONF);
+  monitor->stats_fd = (int*)calloc(monitor->n_cpus, sizeof(*monitor->stats_fd));
+  monitor->start = (buffer_cpu_stats*)calloc(monitor->n_cpus, sizeof(*monitor->start));
+  monitor->current = (buffer_cpu_stats*)calloc(monitor->n_cpus, sizeof(*monitor->current));
+  monitor->lost = (__u64*)calloc(monitor->n_cpus, sizeof(*monitor->lost));
+  if(monitor->stats_fd == NULL || monitor->start == NULL || monitor->current == NULL || monitor->lost == NULL){
+    fprintf(stderr, "create_buffer_monitor: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  for(int cpu = 0; cpu < monitor->n_cpus; cpu++){
+    // An offline CPU has no per_cpu directory: it never records events
+    snprintf(stats_path, PATH_MAX, BUFFER_STATS_PATH, session->tracing_path, cpu);
+    monitor->stats_fd[cpu] = open(stats_path, O_RDONLY | O_CLOEXEC);
+  }
+  return monitor;
+}
+
+/**
+ * @brief Reads the statistics of the ring buffers of all the CPUs into an array.
+ * @param monitor A pointer to a buffer_monitor struct.
+ * @param stats The array of "n_cpus" buffer_cpu_stats structs to fill.
+*/
+static void read_stats(buffer_monitor* monitor, buffer_cpu_stats* stats){
+  char buffer[STR_BUFFER_SIZE];
+  char* line;
+  char* save_ptr;
+  char* value;
+  ssize_t bytes_read;
+
+  for(int cpu = 0; cpu < monitor->n_cpus; cpu++){
+    bzero(&stats[cpu], sizeof(stats[cpu]));
+    if(monitor->stats_fd[cpu] == -1)
+      continue;
+    bytes_read = pread(monitor->stats_fd[cpu], buffer, sizeof(buffer) - 1, 0);
+    if(bytes_read == -1){
+      fprintf(stderr, "buffer_monitor: error reading the statistics of the CPU %d. Aborting ...\n", cpu);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    buffer[bytes_read] = '\0';
+
+    // Each line looks like "overrun: 42"
+    for(line = strtok_r(buffer, "\n", &save_ptr); line != NULL; line = strtok_r(NULL, "\n", &save_ptr)){
+      value = strchr(line, ':');
+      if(value == NULL)
+        continue;
+      *value++ = '\0';
+      if(strcmp(line, "entries") == 0)
+        stats[cpu].entries = strtoull(value, NULL, 10);
+      else if(strcmp(line, "overrun") == 0)
+        stats[cpu].overrun = strtoull(value, NULL, 10);
+      else if(strcmp(line, "commit overrun") == 0)
+        stats[cpu].commit_overrun = strtoull(value, NULL, 10);
+      else if(strcmp(line, "bytes") == 0)
+        stats[cpu].bytes = strtoull(value, NULL, 10);
+      else if(strcmp(line, "dropped events") == 0)
+        stats[cpu].dropped_events = strtoull(value, NULL, 10);
+      else if(strcmp(line, "read events") == 0)
+        stats[cpu].read_events = strtoull(value, NULL, 10);
+    }
+  }
+}
+
+/**
+ * @brief Returns the current CLOCK_MONOTONIC time in nanoseconds.
+ * @return The current time in nanoseconds.
+*/
+static __u64 monotonic_time(void){
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief Returns the number of events written to the ring buffer of a CPU since it was created: the ones still in the buffer, the
+ * ones already read and the ones lost.
+ * @param stats A pointer to the buffer_cpu_stats struct of the CPU.
+ * @return The number of events written.
+*/
+static __u64 written_events(const buffer_cpu_stats* stats){
+  return stats->entries + stats->read_events + stats->overrun + stats->commit_overrun + stats->dropped_events;
+}
+
+/**
+ * @brief Starts a warm-up: the events recorded from now until "buffer_monitor_autotune()" are used to measure the event rate. The
+ * events to trace must already be enabled, and the warm-up should run the same kind of work as the jobs.
+ * @param monitor A pointer to a buffer_monitor struct.
+*/
+void buffer_monitor_warmup_start(buffer_monitor* monitor){
+  read_stats(monitor, monitor->start);
+  monitor->start_time = monotonic_time();
+}
+
+/**
+ * @brief Ends the warm-up and sizes the per-CPU ring buffers, writing the buffer_size_kb file of the session. The size is the data
+ * written by the busiest CPU per second, multiplied by the time the ring buffer must hold without being consumed and by BUFFER_HEADROOM,
+ * clamped between BUFFER_MIN_SIZE_KB and BUFFER_MAX_SIZE_KB.
+ * @param monitor A pointer to a buffer_monitor struct.
+ * @param retention_seconds The time in seconds the ring buffer must hold the events without being read, such as the expected duration
+ * of all the jobs if the trace is read only at the end, or the drain interval if it is streamed.
+ * @return The size chosen for each per-CPU ring buffer in KB.
+*/
+unsigned long buffer_monitor_autotune(buffer_monitor* monitor, double retention_seconds){
+  double elapsed_seconds;
+  double event_size;
+  double rate;
+  double max_rate = 0;
+  double size_kb;
+  unsigned long buffer_kb;
+  char str[32];
+
+  read_stats(monitor, monitor->current);
+  elapsed_seconds = (monotonic_time() - monitor->start_time) / 1e9;
+  if(elapsed_seconds <= 0)
+    elapsed_seconds = 1e-9;
+
+  // The busiest CPU decides the size, since buffer_size_kb is the same for every CPU
+  for(int cpu = 0; cpu < monitor->n_cpus; cpu++){
+    if(monitor->current[cpu].entries != 0)
+      event_size = (double)monitor->current[cpu].bytes / monitor->current[cpu].entries;
+    else
+      event_size = BUFFER_DEFAULT_EVENT_SIZE;
+    rate = (written_events(&monitor->current[cpu]) - written_events(&monitor->start[cpu])) * event_size / elapsed_seconds;
+    if(rate > max_rate)
+      max_rate = rate;
+  }
+
+  size_kb = max_rate * retention_seconds * BUFFER_HEADROOM / 1024;
+  if(size_kb < BUFFER_MIN_SIZE_KB)
+    buffer_kb = BUFFER_MIN_SIZE_KB;
+  else if(size_kb > BUFFER_MAX_SIZE_KB)
+    buffer_kb = BUFFER_MAX_SIZE_KB;
+  else
+    buffer_kb = ((unsigned long)size_kb + 3) / 4 * 4; // The ring buffer is made of 4 KB pages
+
+  sprintf(str, "%lu", buffer_kb);
+  SET_BUFFER_SIZE_SESSION(monitor->session, str);
+  return buffer_kb;
+}
+
+/**
+ * @brief Reads the statistics of the ring buffers at the beginning of a job.
+ * @param monitor A pointer to a buffer_monitor struct.
+*/
+void buffer_monitor_job_start(buffer_monitor* monitor){
+  read_stats(monitor, monitor->start);
+}
+
+/**
+ * @brief Reads the statistics of the ring buffers at the end of a job and computes the events lost by each CPU during the job, as the
+ * sum of the increases of overrun, commit overrun and dropped events. It sets the "lost_events" extra metric of an exec_info struct
+ * to the total and the "lost_cpu_mask" one to the mask of the CPUs that lost events (only the first 63 CPUs are represented).
+ * @param monitor A pointer to a buffer_monitor struct.
+ * @param e_info A pointer to an exec_info struct. Set it to NULL in order to only compute the "lost" field of the struct.
+ * @return The total number of events lost during the job.
+*/
+__u64 buffer_monitor_job_end(buffer_monitor* monitor, exec_info* e_info){
+  buffer_cpu_stats* start;
+  buffer_cpu_stats* end;
+  __u64 total = 0;
+  long long cpu_mask = 0;
+
+  read_stats(monitor, monitor->current);
+  for(int cpu = 0; cpu < monitor->n_cpus; cpu++){
+    start = &monitor->start[cpu];
+    end = &monitor->current[cpu];
+    monitor->lost[cpu] = (end->overrun - start->overrun) + (end->commit_overrun - start->commit_overrun) +
+                         (end->dropped_events - start->dropped_events);
+    total += monitor->lost[cpu];
+    if(monitor->lost[cpu] != 0 && cpu < 63)
+      cpu_mask |= 1LL << cpu;
+  }
+  if(e_info != NULL){
+    exec_info_set_metric(e_info, "lost_events", total);
+    exec_info_set_metric(e_info, "lost_cpu_mask", cpu_mask);
+  }
+  return total;
+}
+
+/**
+ * @brief Closes the statistics files and frees up the memory allocated for a buffer_monitor struct.
+ * @param monitor A pointer to a buffer_monitor struct.
+*/
+void destroy_buffer_monitor(buffer_monitor* monitor){
+  for(int cpu = 0; cpu < monitor->n_cpus; cpu++){
+    if(monitor->stats_fd[cpu] != -1)
+      close(monitor->stats_fd[cpu]);
+  }
+  free(monitor->stats_fd);
+  free(monitor->start);
+  free(monitor->current);
+  free(monitor->lost);
+  free(monitor);
+}
@@ -0,0 +1,89 @@
+#ifndef BUFFER_MONITOR_H_
+#define BUFFER_MONITOR_H_
+
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+
+#define BUFFER_STATS_PATH "%s/per_cpu/cpu%d/stats"	///>Path to the statistics file of the ring buffer of a CPU, given the tracefs root and the CPU.
+#define BUFFER_MIN_SIZE_KB BUFFER_SIZE_KB						///>Smallest per-CPU ring buffer size chosen by "buffer_monitor_autotune()".
+#define BUFFER_MAX_SIZE_KB 262144										///>Largest per-CPU ring buffer size chosen by "buffer_monitor_autotune()".
+#define BUFFER_HEADROOM 2														///>Factor applied to the measured event rate to absorb bursts.
+#define BUFFER_DEFAULT_EVENT_SIZE 64								///>Event size in bytes assumed when the warm-up leaves no event in the ring buffer to measure it.
+
+/**
+ * @brief The counters of the statistics file of the ring buffer of a CPU.
+*/
+typedef struct buffer_cpu_stats{
+	__u64 entries; ///> Events currently in the ring buffer.
+	__u64 overrun; ///> Events overwritten because the ring buffer was full.
+	__u64 commit_overrun; ///> Events lost because of a wrap while they were being written.
+	__u64 bytes; ///> Bytes currently in the ring buffer.
+	__u64 dropped_events; ///> Events dropped because the ring buffer was full and it doesn't overwrite.
+	__u64 read_events; ///> Events already consumed by a reader.
+} buffer_cpu_stats;
+
+/**
+ * @brief A structure that reads the statistics of the per-CPU ring buffers of a tracing_session, in order to size them from the event
+ * rate measured during a warm-up and to account, for each job, the events lost by each CPU. A job that lost sched_switch events has
+ * wrong metrics that look valid, so the lost events are logged along with its execution information.
+*/
+typedef struct buffer_monitor{
+	tracing_session* session; ///> The session whose ring buffers are monitored.
+	int n_cpus; ///> Number of configured CPUs.
+	int* stats_fd; ///> File descriptors of the statistics files, -1 for the offline CPUs.
+	buffer_cpu_stats* start; ///> The statistics of each CPU at the beginning of the job in progress, or of the warm-up.
+	buffer_cpu_stats* current; ///> The statistics of each CPU read at the last boundary.
+	__u64* lost; ///> The events lost by each CPU during the last job.
+	__u64 start_time; ///> CLOCK_MONOTONIC time in nanoseconds of the beginning of the warm-up.
+} buffer_monitor;
+
+/**
+ * @brief Creates a buffer_monitor struct for the ring buffers of a tracing_session.
+ * @param session A pointer to a tracing_session struct.
+ * @return A pointer to a newly created buffer_monitor struct. This structure must be deallocated using the "destroy_buffer_monitor()"
+ * function when you're done with it.
+*/
+buffer_monitor* create_buffer_monitor(tracing_session* session);
+
+/**
+ * @brief Starts a warm-up: the events recorded from now until "buffer_monitor_autotune()" are used to measure the event rate. The
+ * events to trace must already be enabled, and the warm-up should run the same kind of work as the jobs.
+ * @param monitor A pointer to a buffer_monitor struct.
+*/
+void buffer_monitor_warmup_start(buffer_monitor* monitor);
+
+/**
+ * @brief Ends the warm-up and sizes the per-CPU ring buffers, writing the buffer_size_kb file of the session. The size is the data
+ * written by the busiest CPU per second, multiplied by the time the ring buffer must hold without being consumed and by BUFFER_HEADROOM,
+ * clamped between BUFFER_MIN_SIZE_KB and BUFFER_MAX_SIZE_KB.
+ * @param monitor A pointer to a buffer_monitor struct.
+ * @param retention_seconds The time in seconds the ring buffer must hold the events without being read, such as the expected duration
+ * of all the jobs if the trace is read only at the end, or the drain interval if it is streamed.
+ * @return The size chosen for each per-CPU ring buffer in KB.
+*/
+unsigned long buffer_monitor_autotune(buffer_monitor* monitor, double retention_seconds);
+
+/**
+ * @brief Reads the statistics of the ring buffers at the beginning of a job.
+ * @param monitor A pointer to a buffer_monitor struct.
+*/
+void buffer_monitor_job_start(buffer_monitor* monitor);
+
+/**
+ * @brief Reads the statistics of the ring buffers at the end of a job and computes the events lost by each CPU during the job, as the
+ * sum of the increases of overrun, commit overrun and dropped events. It sets the "lost_events" extra metric of an exec_info struct
+ * to the total and the "lost_cpu_mask" one to the mask of the CPUs that lost events (only the first 63 CPUs are represented).
+ * @param monitor A pointer to a buffer_monitor struct.
+ * @param e_info A pointer to an exec_info struct. Set it to NULL in order to only compute the "lost" field of the struct.
+ * @return The total number of events lost during the job.
+*/
+__u64 buffer_monitor_job_end(buffer_monitor* monitor, exec_info* e_info);
+
+/**
+ * @brief Closes the statistics files and frees up the memory allocated for a buffer_monitor struct.
+ * @param monitor A pointer to a buffer_monitor struct.
+*/
+void destroy_buffer_monitor(buffer_monitor* monitor);
+
+#endif
@@ -0,0 +1,199 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include "cpu_affinity.h"
+
+/**
+ * @brief Parses a list of CPUs in the format of the cpuset files, such as "0-3,6,8-9".
+ * @param cpu_list A pointer to the string that contains the list.
+ * @param set A pointer to the cpu_set_t where to store the CPUs of the list.
+ * @return The number of CPUs in the list, -1 if the list is not valid.
+*/
+int parse_cpu_list(const char* cpu_list, cpu_set_t* set){
+  const char* ptr = cpu_list;
+  char* end_ptr;
+  long first, last;
+
+  CPU_ZERO(set);
+  while(*ptr != '\0'){
+    first = strtol(ptr, &end_ptr, 10);
+    if(end_ptr == ptr || first < 0 || first >= CPU_SETSIZE)
+      return -1;
+    last = first;
+    ptr = end_ptr;
+    if(*ptr == '-'){
+      last = strtol(ptr + 1, &end_ptr, 10);
+      if(end_ptr == ptr + 1 || last < first || last >= CPU_SETSIZE)
+        return -1;
+      ptr = end_ptr;
+    }
+    for(long cpu = first; cpu <= last; cpu++){
+      CPU_SET(cpu, set);
+    }
+    if(*ptr == ',' && *(ptr + 1) != '\0')
+      ptr++;
+    else if(*ptr != '\0')
+      return -1;
+  }
+  return CPU_COUNT(set) > 0 ? CPU_COUNT(set) : -1;
+}
+
+/**
+ * @brief Computes the mask of the first 63 CPUs of a set, logged as an extra metric.
+ * @param set A pointer to a cpu_set_t.
+ * @return The mask of the CPUs.
+*/
+static long long cpu_mask(const cpu_set_t* set){
+  long long mask = 0;
+
+  for(int cpu = 0; cpu < 63; cpu++){
+    if(CPU_ISSET(cpu, set))
+      mask |= 1LL << cpu;
+  }
+  return mask;
+}
+
+/**
+ * @brief Sets the CPU affinity of a process with sched_setaffinity(), so that it runs only on the CPUs of a set.
+ * @param pid The pid of the process. Set it to 0 in order to use the calling thread.
+ * @param set A pointer to the cpu_set_t that contains the allowed CPUs.
+ * @param e_info A pointer to an exec_info struct. It is used to set its "cpu_mask" extra metric to the mask of the allowed CPUs
+ * (only the first 63 CPUs are represented). If it is set to NULL, the function will ignore this parameter.
+*/
+void set_cpu_affinity(pid_t pid, const cpu_set_t* set, exec_info* e_info){
+  if(sched_setaffinity(pid, sizeof(*set), set) == -1){
+    fprintf(stderr, "set_cpu_affinity: error setting the CPU affinity. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  if(e_info != NULL)
+    exec_info_set_metric(e_info, "cpu_mask", cpu_mask(set));
+}
+
+/**
+ * @brief Reads the idle time and the total time of each CPU from the AFFINITY_STAT_PATH file, in clock ticks.
+ * @param idle The array of "n_cpus" elements where to store the idle time (idle and iowait states) of each CPU.
+ * @param total The array of "n_cpus" elements where to store the total time of each CPU. It is 0 for the offline CPUs.
+ * @param n_cpus The number of elements of the arrays.
+*/
+static void read_cpu_times(__u64* idle, __u64* total, int n_cpus){
+  char line[STR_BUFFER_SIZE];
+  unsigned long long times[8];
+  FILE* file;
+  int cpu;
+
+  memset(total, 0, n_cpus * sizeof(*total));
+  file = fopen(AFFINITY_STAT_PATH, "r");
+  if(file == NULL){
+    fprintf(stderr, "find_idle_cpu: error opening \"%s\" file. Aborting ...\n", AFFINITY_STAT_PATH);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  // The lines look like "cpu3 user nice system idle iowait irq softirq steal ...", after the "cpu" line of the whole system
+  while(fgets(line, sizeof(line), file) != NULL){
+    if(sscanf(line, "cpu%d %llu %llu %llu %llu %llu %llu %llu %llu", &cpu, &times[0], &times[1], &times[2], &times[3], &times[4],
+              &times[5], &times[6], &times[7]) != 9 || cpu < 0 || cpu >= n_cpus)
+      continue;
+    idle[cpu] = times[3] + times[4];
+    total[cpu] = 0;
+    for(int i = 0; i < 8; i++){
+      total[cpu] += times[i];
+    }
+  }
+  fclose(file);
+}
+
+/**
+ * @brief Finds the idlest CPU of a set, observing the time spent by each CPU in the idle state for a while. The calling thread
+ * sleeps during the observation, so it doesn't keep busy its own CPU.
+ * @param candidates A pointer to the cpu_set_t that contains the CPUs to observe.
+ * @param sample_ns The observation time in nanoseconds.
+ * @param idle_permille A pointer to an integer where to store the idle time of the chosen CPU, in thousandths of the observation
+ * time. It can be NULL.
+ * @return The idlest CPU, -1 if none of the candidates is online. A CPU whose counters didn't advance during the observation is
+ * skipped, since its idle time is unknown. The counters advance by clock ticks, so the observation should last many of them.
+*/
+int find_idle_cpu(const cpu_set_t* candidates, __u64 sample_ns, int* idle_permille){
+  int n_cpus = sysconf(_SC_NPROCESSORS_CONF);
+  __u64 *idle_start, *total_start, *idle_end, *total_end;
+  struct timespec ts;
+  int best_cpu = -1;
+  int best_permille = -1;
+  int permille;
+
+  idle_start = (__u64*)calloc(n_cpus * 4, sizeof(__u64));
+  if(idle_start == NULL){
+    fprintf(stderr, "find_idle_cpu: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  total_start = idle_start + n_cpus;
+  idle_end = total_start + n_cpus;
+  total_end = idle_end + n_cpus;
+
+  read_cpu_times(idle_start, total_start, n_cpus);
+  ts.tv_sec = sample_ns / 1000000000ULL;
+  ts.tv_nsec = sample_ns % 1000000000ULL;
+  while(nanosleep(&ts, &ts) == -1 && errno == EINTR);
+  read_cpu_times(idle_end, total_end, n_cpus);
+
+  for(int cpu = 0; cpu < n_cpus; cpu++){
+    if(!CPU_ISSET(cpu, candidates) || total_start[cpu] == 0 || total_end[cpu] <= total_start[cpu])
+      continue;
+    permille = (int)(1000 * (idle_end[cpu] - idle_start[cpu]) / (total_end[cpu] - total_start[cpu]));
+    if(permille > best_permille){
+      best_permille = permille;
+      best_cpu = cpu;
+    }
+  }
+  free(idle_start);
+  if(idle_permille != NULL)
+    *idle_permille = best_permille;
+  return best_cpu;
+}
+
+/**
+ * @brief Pins a process to the idlest CPU of a set, as found by "find_idle_cpu()" with AFFINITY_IDLE_SAMPLE_NS. A warning is printed
+ * if its idle time is below AFFINITY_IDLE_THRESHOLD, since the job is going to share the CPU.
+ * @param pid The pid of the process. Set it to 0 in order to use the calling thread.
+ * @param candidates A pointer to the cpu_set_t that contains the CPUs where the process can run.
+ * @param e_info A pointer to an exec_info struct. It is used to set its "cpu_mask" extra metric, as "set_cpu_affinity()" does,
+ * and its "cpu_idle_permille" extra metric to the idle time of the chosen CPU. If it is set to NULL, the function will ignore
+ * this parameter.
+ * @return The chosen CPU.
+*/
+int pin_idle_cpu(pid_t pid, const cpu_set_t* candidates, exec_info* e_info){
+  cpu_set_t set;
+  int idle_permille;
+  int cpu;
+
+  cpu = find_idle_cpu(candidates, AFFINITY_IDLE_SAMPLE_NS, &idle_permille);
+  if(cpu == -1){
+    fprintf(stderr, "pin_idle_cpu: none of the CPUs is online or has been observed. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  if(idle_permille < AFFINITY_IDLE_THRESHOLD)
+    fprintf(stderr, "pin_idle_cpu: warning, no CPU is idle, the idlest one (CPU %d) has been idle for %d.%d%% of the time\n",
+            cpu, idle_permille / 10, idle_permille % 10);
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  set_cpu_affinity(pid, &set, e_info);
+  if(e_info != NULL)
+    exec_info_set_metric(e_info, "cpu_idle_permille", idle_permille);
+  return cpu;
+}
+
+/**
+ * @brief Records the CPU the calling thread is running on as an extra metric of an exec_info struct.
+ * @param e_info A pointer to an exec_info struct.
+ * @param name A pointer to the name of the metric, such as "start_cpu" or "end_cpu". It is not copied.
+*/
+void record_current_cpu(exec_info* e_info, const char* name){
+  exec_info_set_metric(e_info, name, sched_getcpu());
+}
@@ -0,0 +1,61 @@
+#ifndef CPU_AFFINITY_H_
+#define CPU_AFFINITY_H_
+
+#include <sched.h>
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+
+#define AFFINITY_STAT_PATH "/proc/stat"				///>Path to the file with the time spent by each CPU in each state.
+#define AFFINITY_IDLE_SAMPLE_NS 200000000			///>Default time in nanoseconds during which the CPUs are observed by "find_idle_cpu()", 20 ticks of 10 ms.
+#define AFFINITY_IDLE_THRESHOLD 950						///>Idle time, in thousandths of the observed time, above which a CPU is considered idle.
+
+/**
+ * @brief Parses a list of CPUs in the format of the cpuset files, such as "0-3,6,8-9".
+ * @param cpu_list A pointer to the string that contains the list.
+ * @param set A pointer to the cpu_set_t where to store the CPUs of the list.
+ * @return The number of CPUs in the list, -1 if the list is not valid.
+*/
+int parse_cpu_list(const char* cpu_list, cpu_set_t* set);
+
+/**
+ * @brief Sets the CPU affinity of a process with sched_setaffinity(), so that it runs only on the CPUs of a set.
+ * @param pid The pid of the process. Set it to 0 in order to use the calling thread.
+ * @param set A pointer to the cpu_set_t that contains the allowed CPUs.
+ * @param e_info A pointer to an exec_info struct. It is used to set its "cpu_mask" extra metric to the mask of the allowed CPUs
+ * (only the first 63 CPUs are represented). If it is set to NULL, the function will ignore this parameter.
+*/
+void set_cpu_affinity(pid_t pid, const cpu_set_t* set, exec_info* e_info);
+
+/**
+ * @brief Finds the idlest CPU of a set, observing the time spent by each CPU in the idle state for a while. The calling thread
+ * sleeps during the observation, so it doesn't keep busy its own CPU.
+ * @param candidates A pointer to the cpu_set_t that contains the CPUs to observe.
+ * @param sample_ns The observation time in nanoseconds.
+ * @param idle_permille A pointer to an integer where to store the idle time of the chosen CPU, in thousandths of the observation
+ * time. It can be NULL.
+ * @return The idlest CPU, -1 if none of the candidates is online. A CPU whose counters didn't advance during the observation is
+ * skipped, since its idle time is unknown. The counters advance by clock ticks, so the observation should last many of them.
+*/
+int find_idle_cpu(const cpu_set_t* candidates, __u64 sample_ns, int* idle_permille);
+
+/**
+ * @brief Pins a process to the idlest CPU of a set, as found by "find_idle_cpu()" with AFFINITY_IDLE_SAMPLE_NS. A warning is printed
+ * if its idle time is below AFFINITY_IDLE_THRESHOLD, since the job is going to share the CPU.
+ * @param pid The pid of the process. Set it to 0 in order to use the calling thread.
+ * @param candidates A pointer to the cpu_set_t that contains the CPUs where the process can run.
+ * @param e_info A pointer to an exec_info struct. It is used to set its "cpu_mask" extra metric, as "set_cpu_affinity()" does,
+ * and its "cpu_idle_permille" extra metric to the idle time of the chosen CPU. If it is set to NULL, the function will ignore
+ * this parameter.
+ * @return The chosen CPU.
+*/
+int pin_idle_cpu(pid_t pid, const cpu_set_t* candidates, exec_info* e_info);
+
+/**
+ * @brief Records the CPU the calling thread is running on as an extra metric of an exec_info struct.
+ * @param e_info A pointer to an exec_info struct.
+ * @param name A pointer to the name of the metric, such as "start_cpu" or "end_cpu". It is not copied.
+*/
+void record_current_cpu(exec_info* e_info, const char* name);
+
+#endif
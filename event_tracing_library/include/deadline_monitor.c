@@ -0,0 +1,121 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/types.h>
+#include "deadline_monitor.h"
+
+// The runtime overruns signaled by the kernel with SIGXCPU, updated by the signal handler
+static volatile sig_atomic_t overrun_signals = 0;
+
+/**
+ * @brief The SIGXCPU handler: it only counts the signals, since a throttled job must go on.
+ * @param signum The number of the signal.
+*/
+static void overrun_handler(int signum){
+  (void)signum;
+  overrun_signals++;
+}
+
+/**
+ * @brief Returns the time of a clock in nanoseconds.
+ * @param clock_id The clock to read.
+ * @return The time in nanoseconds.
+*/
+static __u64 clock_time(clockid_t clock_id){
+  struct timespec ts;
+
+  if(clock_gettime(clock_id, &ts) == -1){
+    fprintf(stderr, "deadline_monitor: error reading the clock %d. Aborting ...\n", (int)clock_id);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief Creates a deadline_monitor struct for the reservation of the calling thread, installing a SIGXCPU handler that counts the
+ * runtime overruns signaled by the kernel. Only one deadline_monitor struct can exist at a time.
+ * @param runtime The runtime of the reservation in nanoseconds.
+ * @param deadline The relative deadline of the reservation in nanoseconds. Set it to 0 in order to use the period.
+ * @param period The period of the reservation in nanoseconds. Set it to 0 in order to use the deadline.
+ * @return A pointer to a newly created deadline_monitor struct. This structure must be deallocated using the
+ * "destroy_deadline_monitor()" function when you're done with it.
+*/
+deadline_monitor* create_deadline_monitor(__u64 runtime, __u64 deadline, __u64 period){
+  deadline_monitor* monitor;
+  struct sigaction action;
+
+  monitor = (deadline_monitor*)calloc(1, sizeof(*monitor));
+  if(monitor == NULL){
+    fprintf(stderr, "create_deadline_monitor: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  monitor->runtime = runtime;
+  monitor->deadline = deadline != 0 ? deadline : period;
+  monitor->period = period != 0 ? period : deadline;
+
+  bzero(&action, sizeof(action));
+  action.sa_handler = overrun_handler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if(sigaction(SIGXCPU, &action, &monitor->old_action) == -1){
+    fprintf(stderr, "create_deadline_monitor: error installing the SIGXCPU handler. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  return monitor;
+}
+
+/**
+ * @brief Marks the beginning of a job, which is considered released at this time.
+ * @param monitor A pointer to a deadline_monitor struct.
+*/
+void deadline_monitor_job_start(deadline_monitor* monitor){
+  monitor->job_signals = overrun_signals;
+  monitor->job_release = clock_time(CLOCK_MONOTONIC);
+  monitor->job_cpu_time = clock_time(CLOCK_THREAD_CPUTIME_ID);
+}
+
+/**
+ * @brief Marks the end of a job, before the sched_yield() that ends its period. It sets the extra metrics of an exec_info struct:
+ * "dl_miss" and "dl_overrun" (1 if the job missed its deadline or overran its runtime, 0 otherwise), "dl_response_time" and
+ * "dl_cpu_time" (the time elapsed since the release and the CPU time consumed, in nanoseconds), "dl_lateness" (the response time
+ * minus the deadline, negative when the job finished in time) and "dl_throttled" (the SIGXCPU signals received during the job).
+ * @param monitor A pointer to a deadline_monitor struct.
+ * @param e_info A pointer to an exec_info struct. Set it to NULL in order to only update the counters of the struct.
+ * @return 1 if the job missed its deadline or overran its runtime, 0 otherwise.
+*/
+int deadline_monitor_job_end(deadline_monitor* monitor, exec_info* e_info){
+  __u64 cpu_time = clock_time(CLOCK_THREAD_CPUTIME_ID) - monitor->job_cpu_time;
+  __u64 response_time = clock_time(CLOCK_MONOTONIC) - monitor->job_release;
+  long throttled = overrun_signals - monitor->job_signals;
+  int miss = response_time > monitor->deadline;
+  int overrun = cpu_time > monitor->runtime || throttled > 0;
+
+  monitor->n_jobs++;
+  monitor->n_misses += miss;
+  monitor->n_overruns += overrun;
+  if(e_info != NULL){
+    exec_info_set_metric(e_info, "dl_miss", miss);
+    exec_info_set_metric(e_info, "dl_overrun", overrun);
+    exec_info_set_metric(e_info, "dl_response_time", response_time);
+    exec_info_set_metric(e_info, "dl_cpu_time", cpu_time);
+    exec_info_set_metric(e_info, "dl_lateness", (long long)response_time - (long long)monitor->deadline);
+    exec_info_set_metric(e_info, "dl_throttled", throttled);
+  }
+  return miss || overrun;
+}
+
+/**
+ * @brief Restores the previous SIGXCPU action and frees up the memory allocated for a deadline_monitor struct.
+ * @param monitor A pointer to a deadline_monitor struct.
+*/
+void destroy_deadline_monitor(deadline_monitor* monitor){
+  sigaction(SIGXCPU, &monitor->old_action, NULL);
+  free(monitor);
+}
@@ -0,0 +1,63 @@
+#ifndef DEADLINE_MONITOR_H_
+#define DEADLINE_MONITOR_H_
+
+#include <signal.h>
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+
+/**
+ * @brief A structure that checks, for each job of a SCHED_DEADLINE thread, whether it finished within its relative deadline and
+ * whether it consumed more CPU time than its runtime. A job is expected to start at the beginning of a period and to end with
+ * sched_yield(), which gives up the runtime left until the next period. The runtime overruns are detected both from the thread CPU
+ * time and from the SIGXCPU signals sent by the kernel when the reservation has been set with the SCHED_FLAG_DL_OVERRUN flag, since
+ * the kernel throttles the thread without telling it otherwise.
+*/
+typedef struct deadline_monitor{
+	__u64 runtime; ///> The runtime of the reservation in nanoseconds.
+	__u64 deadline; ///> The relative deadline of the reservation in nanoseconds.
+	__u64 period; ///> The period of the reservation in nanoseconds.
+	__u64 job_release; ///> CLOCK_MONOTONIC time in nanoseconds of the beginning of the job in progress.
+	__u64 job_cpu_time; ///> CLOCK_THREAD_CPUTIME_ID time in nanoseconds at the beginning of the job in progress.
+	long job_signals; ///> Number of SIGXCPU signals received before the beginning of the job in progress.
+	int n_jobs; ///> Number of jobs checked.
+	int n_misses; ///> Number of jobs that missed their deadline.
+	int n_overruns; ///> Number of jobs that overran their runtime.
+	struct sigaction old_action; ///> The SIGXCPU action replaced by the monitor, restored when it is destroyed.
+} deadline_monitor;
+
+/**
+ * @brief Creates a deadline_monitor struct for the reservation of the calling thread, installing a SIGXCPU handler that counts the
+ * runtime overruns signaled by the kernel. Only one deadline_monitor struct can exist at a time.
+ * @param runtime The runtime of the reservation in nanoseconds.
+ * @param deadline The relative deadline of the reservation in nanoseconds. Set it to 0 in order to use the period.
+ * @param period The period of the reservation in nanoseconds. Set it to 0 in order to use the deadline.
+ * @return A pointer to a newly created deadline_monitor struct. This structure must be deallocated using the
+ * "destroy_deadline_monitor()" function when you're done with it.
+*/
+deadline_monitor* create_deadline_monitor(__u64 runtime, __u64 deadline, __u64 period);
+
+/**
+ * @brief Marks the beginning of a job, which is considered released at this time.
+ * @param monitor A pointer to a deadline_monitor struct.
+*/
+void deadline_monitor_job_start(deadline_monitor* monitor);
+
+/**
+ * @brief Marks the end of a job, before the sched_yield() that ends its period. It sets the extra metrics of an exec_info struct:
+ * "dl_miss" and "dl_overrun" (1 if the job missed its deadline or overran its runtime, 0 otherwise), "dl_response_time" and
+ * "dl_cpu_time" (the time elapsed since the release and the CPU time consumed, in nanoseconds), "dl_lateness" (the response time
+ * minus the deadline, negative when the job finished in time) and "dl_throttled" (the SIGXCPU signals received during the job).
+ * @param monitor A pointer to a deadline_monitor struct.
+ * @param e_info A pointer to an exec_info struct. Set it to NULL in order to only update the counters of the struct.
+ * @return 1 if the job missed its deadline or overran its runtime, 0 otherwise.
+*/
+int deadline_monitor_job_end(deadline_monitor* monitor, exec_info* e_info);
+
+/**
+ * @brief Restores the previous SIGXCPU action and frees up the memory allocated for a deadline_monitor struct.
+ * @param monitor A pointer to a deadline_monitor struct.
+*/
+void destroy_deadline_monitor(deadline_monitor* monitor);
+
+#endif
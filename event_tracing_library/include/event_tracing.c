@@ -1,656 +1,1236 @@
-#define _GNU_SOURCE
-#include <stdio.h>
-#include <stdlib.h>
-#include <limits.h>
-#include <math.h>
-#include <time.h>
-#include <fcntl.h>
-#include <errno.h>
-#include <string.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <unistd.h>
-#include <sched.h>
-#include "event_tracing.h"
-
-
-#ifdef __x86_64__
-#define __NR_sched_setattr		314
-#define __NR_sched_getattr		315
-#endif
-
-#ifdef __i386__
-#define __NR_sched_setattr		351
-#define __NR_sched_getattr		352
-#endif
-
-#ifdef __arm__
-#define __NR_sched_setattr		380
-#define __NR_sched_getattr		381
-#endif
-
-
-/**
- * @brief Creates an exec_info struct that will store job execution data.
- * @param job_number  An integer value that identifies a job during a program execution.
- * @param parameter A long integer value representing the parameter utilized for the job identified by the "job_number" parameter.
- * @param details A pointer to a string useful to store additional data about execution or job details. If no details
- * are needed, set this parameter to NULL.
- * @return A pointer to the newly created exec_info struct correctly initialized. This structure must be deallocated using
- * the "destroy_exec_info()" function when you're done with it.
-*/
-exec_info* create_exec_info(int job_number, long parameter, char* details){
-  exec_info* e_info;
-  struct sched_attr* s_attr;
-  e_info = (exec_info*)malloc(sizeof(*e_info));
-  bzero(e_info, sizeof(*e_info));
-
-  e_info->id = generate_execution_identifier(0);
-
-  s_attr = get_scheduler_attr(0);
-  switch (s_attr->sched_policy){
-    case SCHED_FIFO:
-      e_info->sched_policy = "SCHED_FIFO";
-      break;
-    case SCHED_RR:
-      e_info->sched_policy = "SCHED_RR";
-      break;
-    case SCHED_BATCH:
-      e_info->sched_policy = "SCHED_BATCH";
-      break;
-    case SCHED_IDLE:
-      e_info->sched_policy = "SCHED_IDLE";
-      break;
-    case SCHED_DEADLINE:
-      e_info->sched_policy = "SCHED_DEADLINE";
-      break;
-    case SCHED_OTHER:
-      e_info->sched_policy = "SCHED_OTHER";
-      break;
-    default:
-      e_info->sched_policy = "UNDEFINED";
-      break;
-  }
-  e_info->sched_priority = s_attr->sched_priority;
-  e_info->details = details;
-  free(s_attr);
-  return e_info;
-}
-
-/**
- * @brief Frees up the memory allocated for the exec_info struct pointed by the "e_info" parameter.
- * @param e_info A pointer to an exec_info struct.
-*/
-void destroy_exec_info(exec_info* e_info){
-  free(e_info->id);
-  free(e_info);
-}
-
-/**
- * @brief Sets a custom filter for an event in order to change the trace output based
- * on that filter.
- * @param subsystem A pointer to a string that specifies subsystem's name of the event.
- * @param event A pointer to a string that specifies the event's name.
- * @param filter_str A pointer to a string that specifies the filter value to use. If the RESET flag is used in
- * the "flag" parameter, this parameter could be NULL.
- * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to set
- * the filter and the RESET macro to reset it. 
-*/
-void set_event_filter_custom(const char* subsystem, const char* event, const char* filter_str, short flag){
-  char* filter_path;
-  int filter_path_len;
-
-  filter_path_len = strlen(EVENTS_PATH) + 1 + strlen(subsystem) + 1 + strlen(event) + strlen("/filter") + 1;
-  filter_path = (char*)calloc(sizeof(*filter_path), filter_path_len);
-  if(filter_path == NULL){
-    fprintf(stderr, "set_event_filter_custom: error allocating memory. Aborting ...\n");
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-
-  if(sprintf(filter_path, "/sys/kernel/tracing/events/%s/%s/filter", subsystem, event) < 0){
-    fprintf(stderr, "set_event_filter_custom: error creating filter. Aborting ...\n");
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-  if(flag == SET)
-    tracing_write(filter_path, filter_str);
-  else
-    tracing_write(filter_path, "0");
-  free(filter_path);
-}
-
-/**
- * @brief Sets a default filter predefined in the library for an event specified by the "event_flag" parameter,
- * in order to change the trace output based on that filter.
- * @param pid The pid of the process used to filter events related to that process.
- * @param event_flag A short integer value indicating the event type. Possible values can be: E_SCHED_SWITCH, 
- * E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
- * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to 
- * set the filter and the RESET macro to reset it. 
-*/
-void set_event_filter(pid_t pid, short event_flag, short flag){
-  int str_max_size = ceil(log10(INT_MAX))*2 + 25;
-  char filter_str[str_max_size];
-
-  switch(event_flag){
-    case E_SCHED_SWITCH:
-      if(flag == SET)
-        sprintf(filter_str, "prev_pid==%d || next_pid==%d", pid, pid);
-      else
-        sprintf(filter_str, "0");
-      tracing_write(SCHED_SWITCH_FILTER_PATH, filter_str);
-      break;
-    case E_SCHED_WAKEUP:
-      if(flag == SET)
-        sprintf(filter_str, "pid==%d", pid);
-      else
-        sprintf(filter_str, "0");
-      tracing_write(SCHED_WAKEUP_FILTER_PATH, filter_str);
-      break;
-    case E_SCHED_MIGRATE_TASK:
-      if(flag == SET)
-        sprintf(filter_str, "pid==%d", pid);
-      else
-        sprintf(filter_str, "0");
-      tracing_write(SCHED_MIGRATE_TASK_FILTER_PATH, filter_str);
-      break;
-    default:
-      fprintf(stderr, "set_event_filter: invalid event_flag (event_flag not found). Aborting ...\n");
-      exit(EXIT_FAILURE);
-      break;
-  }
-}
-
-/**
- * @brief A redefinition of the sched_setattr() system call in the Linux kernel. It invokes the system call 
- * using its index in the kernel system call table. The sched_setattr() system call sets the scheduling policy 
- * and attributes for the thread specified by pid. If pid is 0, the calling thread's scheduling policy and 
- * attributes are set.
- * @param pid The pid of the process. Set it to 0 in order to set the scheduler attributes of the
- * calling process.
- * @param attr A pointer to a sched_attr struct which contains the scheduler attributes to be set
- * @param flags An unsigned integer value used to specify some flags that can be ORed togheter.
-*/
-int sched_setattr(pid_t pid, const struct sched_attr *attr, unsigned int flags){
-	return syscall(__NR_sched_setattr, pid, attr, flags);
-}
-
-/**
- * @brief A redefinition of the sched_getattr() system call in the Linux kernel. It invokes the system call
- * call using its index into the kernel system call table. The sched_getattr() system call fetches the scheduling policy 
- * and the associated attributes for the thread whose ID is specified in pid. If pid equals zero, the scheduling policy 
- * and attributes of the calling thread will be retrieved.
- * @param pid The pid of the process. Set it to 0 in order to retrieve the scheduler attributes of the
- * calling process.
- * @param attr A pointer to a sched_attr strhct which will be filled with the current scheduler attributes of the process
- * identified by the "pid" parameter.
- * @param size The size of the sched_attr struct as known to user space.
- * @param flags An unsigned integer value provided to allow for future extensions to the interface; in the current 
- * implementation it must be specified as 0.
-*/
-int sched_getattr(pid_t pid, struct sched_attr *attr, unsigned int size, unsigned int flags){
-  return syscall(__NR_sched_getattr, pid, attr, size, flags);
-}
-
-/**
- * @brief Allows specifying scheduler priority and policy of a process identified by the "pid" parameter.
- * @param pid The pid of the process whose scheduling policy and priority we want to change.
- * @param policy An integer value that specifies the scheduling policy, as one of the 
- * following SCHED_* values: SCHED_OTHER, SCHED_FIFO, SCHED_RR, SCHED_BATCH and SCHED_IDLE.
- * @param priority An integer value that specifies the static priority to be set when specifying sched_policy as SCHED_FIFO
- * or SCHED_RR. The allowed range of priorities for these policies is between 1 (low priority) and 99 
- * (high priority). For other policies, this field must be specified as 0.
- * @param e_info A pointer to an exec_info struct. It is used to update the "sched_policy" and "sched_priority" fields of
- * the exec_info struct according to the specified parameters. If it is set to NULL, the function will ignore this parameter.
-*/
-void set_scheduler_policy(pid_t pid, __u32 policy, __u32 priority, exec_info* e_info){
-  struct sched_attr attr = {0};
-  int max_priority = sched_get_priority_max(policy);
-  int min_priority = sched_get_priority_min(policy);
-
-  if(priority < min_priority){
-    priority = min_priority;
-  }
-
-  if(priority > max_priority){
-    priority = max_priority;
-  }
-
-  if(e_info != NULL){
-    switch (policy){
-      case SCHED_FIFO:
-        e_info->sched_policy = "SCHED_FIFO";
-        break;
-      case SCHED_RR:
-        e_info->sched_policy = "SCHED_RR";
-        break;
-      case SCHED_BATCH:
-        e_info->sched_policy = "SCHED_BATCH";
-        break;
-      case SCHED_IDLE:
-        e_info->sched_policy = "SCHED_IDLE";
-        break;
-      case SCHED_DEADLINE:
-        e_info->sched_policy = "SCHED_DEADLINE";
-        break;
-      case SCHED_OTHER:
-        e_info->sched_policy = "SCHED_OTHER";
-        break;
-      default:
-        e_info->sched_policy = "UNDEFINED";
-        break;
-    }
-    e_info->sched_priority = priority; 
-  }
-
-  attr.size = sizeof(attr);
-  attr.sched_policy = policy;
-  attr.sched_priority = priority;
-  attr.sched_flags = 0;
-  if(sched_setattr(pid, &attr, 0) < 0){
-    fprintf(stderr, "set_scheduler_policy: error setting the scheduler attributes. Aborting ...\n");
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-}
-
-/**
- * @brief Allows to retrieve the scheduling policy and attributes of the scheduler for the specified process.
- * @param pid The pid of the process whose scheduling policy and scheduling attributes we want to retrieve.
- * @return A pointer to a newly created sched_attr struct containing all scheduler data retrived. This structure
- * must be freed after you're done with it.
-*/
-struct sched_attr* get_scheduler_attr(pid_t pid){
-  struct sched_attr* attr = (struct sched_attr*)malloc(sizeof(*attr));
-  bzero(attr, sizeof(*attr));
-
-  if(sched_getattr(pid, attr, sizeof(*attr), 0) < 0){
-    fprintf(stderr, "get_scheduler_policy: error retrieving the scheduler attributes. Aborting ...\n");
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-  return attr;
-}
-
-/**
- * @brief Allows to enable or disable the recording of all events contained in the specified subsystem.
- * @param subsystem A pointer to a string that specifies subsystem name.
- * @param op A short integer value that can be DISABLE (0) or ENABLE (1) and it will disable or enable the
- * recording of all subsystem event respectively.
-*/
-void event_record_subsystem(const char* subsystem, short op){
-  char* enable_path;
-  int enable_path_len;
-  char op_character[2] = {0};
-
-  op_character[0] = op + '0';
-  if(op == ENABLE || op == DISABLE){
-    enable_path_len = strlen(EVENTS_PATH) + 1 + strlen(subsystem) + 1 + strlen("/enable") + 1;
-    enable_path = (char*)calloc(sizeof(*enable_path), enable_path_len);
-    if(enable_path == NULL){
-      fprintf(stderr, "event_record_custom: error allocating memory. Aborting ...\n");
-      PRINT_ERROR;
-      exit(EXIT_FAILURE);
-    }
-    tracing_write(enable_path, op_character);
-    free(enable_path);
-  }else{
-    fprintf(stderr, "event_record_custom: invalid op. Aborting ...\n");
-    exit(EXIT_FAILURE);
-  }
-}
-
-/**
- * @brief Allows to enable or disable the recording of an event contained in the specified subsystem.
- * @param subsystem A pointer to a string that specifies subsystem name of the event.
- * @param event A pointer to a string that specifies the event's name. Set it to NULL if you want to use a default 
- * filter.
- * @param op A short integer value that can be DISABLE (0) or ENABLE (1) and it will disable or enable the event 
- * recording respectively.
-*/
-void event_record_custom(const char* subsystem, const char* event, short op){
-  char* enable_path;
-  int enable_path_len;
-  char op_character[2] = {0};
-
-  op_character[0] = op + '0';
-  if(op == ENABLE || op == DISABLE){
-    enable_path_len = strlen(EVENTS_PATH) + 1 + strlen(subsystem) + 1 + strlen(event) + strlen("/enable") + 1;
-    enable_path = (char*)calloc(sizeof(*enable_path), enable_path_len);
-    if(enable_path == NULL){
-      fprintf(stderr, "event_record_custom: error allocating memory. Aborting ...\n");
-      PRINT_ERROR;
-      exit(EXIT_FAILURE);
-    }
-    tracing_write(enable_path, op_character);
-    free(enable_path);
-  }else{
-    fprintf(stderr, "event_record_custom: invalid op. Aborting ...\n");
-    exit(EXIT_FAILURE);
-  }
-}
-
-/**
- * @brief Allows to enable or disable the recording of some specific event defined in the library.
- * @param event_flag is short value indicating the event and it's used to enable or disable the recording that event
- * in the kernel trace. Possible values can be: E_SCHED_SWITCH, E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
- * @param op is short value that can be DISABLE or ENABLE and it will disable or enable the event recording respectively.
-*/
-void event_record(short event_flag, short op){
-  char op_character[2] = {0};
-
-  op_character[0] = op + '0';
-  if(op == ENABLE || op == DISABLE){
-    switch(event_flag){
-    case E_SCHED_SWITCH:
-      tracing_write(SCHED_SWITCH_ENABLE_PATH, op_character);
-      break;
-    case E_SCHED_WAKEUP:
-      tracing_write(SCHED_WAKEUP_ENABLE_PATH, op_character);
-      break;
-    case E_SCHED_MIGRATE_TASK:
-      tracing_write(SCHED_MIGRATE_TASK_ENABLE_PATH, op_character);
-      break;
-    default:
-      fprintf(stderr, "event_record: invalid event_flag (event_flag not found). Aborting ...\n");
-      exit(EXIT_FAILURE);
-      break;
-    }
-  }else{
-    fprintf(stderr, "event_record: invalid op. Aborting ...\n");
-    exit(EXIT_FAILURE);
-  } 
-}
-
-/**
- * @brief Writes the beginning or the end of a job, identified by the "job_number" parameter,
- * on the kernel trace.
- * @param job_number An integer value that identifies a job during a program execution.
- * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
- * The START flag is used to mark the beginning of the job identified by the "job_number" parameter. The STOP flag
- * is used to mark the end of the job identified by the "job_number" parameter.
-*/
-void trace_mark_job(int job_number, short flag){
-  int str_max_size = ceil(log10(INT_MAX)) + 11;
-  char str[str_max_size];
-
-  if(flag == START){
-    sprintf(str, "start_job=%d", job_number);
-    tracing_write(TRACE_MARKER_PATH, str);
-  }else if(flag == STOP){
-    sprintf(str, "end_job=%d", job_number);
-    tracing_write(TRACE_MARKER_PATH, str);
-  }else{
-    fprintf(stderr, "trace_mark: invalid flag\n");
-  }
-}
-
-/**
- * @brief Saves the job execution information to a specific file within a specified directory.
- * @param dir_path The path to a directory where to save various job executions and trace results. It will create a subfolder in this path
- * specific to this execution (if it doesn't already exist), and then it will create or update the "exec.txt" file by appending an new entry of 
- * the current job execution information. The "dir_path" parameter must be the same as the one provided in the "log_trace()" in order to save
- * job execution information along with its kernel trace.
- * @param identifier The user-defined string that identifies the program execution. It can be obtained by calling the "generate_execution_identifier"
- * function. It should match the identifier field contained in the struct pointed by the "info" parameter, if that field exists in the struct.
- * @param info A pointer to a user-defined struct that contains information about an execution. It can also be a default exec_info struct. The 
- * default structure exec_info has the following predefined fields related to the execution: "id", "job_number", "parameter", "details", 
- * "sched_policy" and "sched_priority". To desire the use of the default struct, allocate that structure and pass a pointer to that structure.
- * @param info_to_str A user-defined function that allows to create a comma separeted string based on the fields contained in the struct pointed 
- * by "info" parameter. If the "info" parameter is pointer to an exec_info struct, set this parameter to NULL.
- * @param flag A short integer value used to specify whether the interal library structure exec_info is being used to store job data or if 
- * a user-defined structure is being used for this purpose. To specify the first behavior, set the value of this 
- * parameter to DEFAULT_INFO and pass an exec_info struct in "info" parameter. To specify the second behavior, set the value of this parameter
- * to USER_INFO and pass your defined structure and function in "info" and "info_to_str" parameters respectively.
-*/
-void log_execution_info(const char* dir_path, const char* identifier, void* info, char* (*info_to_str)(void*), short flag){
-  int fd;
-  char* str;
-  char* dir_file_path;
-  int dir_file_path_len;
-  char* file_path;
-  int file_path_len;
-  size_t bytes_written;
-
-  if(flag == USER_INFO && info_to_str != NULL){
-    str = info_to_str(info);
-  }else if(flag == DEFAULT_INFO){
-    str = exec_info_to_str(info);
-  }else{
-    fprintf(stderr, "log_execution_info: invalid flag. Aborting ...\n");
-    exit(EXIT_FAILURE);
-  }
-
-  //Verify that the path provided by the user actually exists, if not creates it
-  if(access(dir_path, F_OK) == -1) {
-    if(mkdir(dir_path, 0777) == -1){
-      fprintf(stderr, "log_execution_info: error creating the folder \"%s\". Aborting ...\n", dir_path);
-      PRINT_ERROR;
-      exit(EXIT_FAILURE);
-    }
-  }
-
-  //Create the subfolder containing execution information
-  dir_file_path_len = strlen(dir_path) + 1 + strlen(identifier) + 1;
-  dir_file_path = (char*)calloc(dir_file_path_len, sizeof(*dir_file_path));
-  if(dir_file_path == NULL){
-    fprintf(stderr, "log_execution_info: error allocating memory. Aborting ...\n");
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-  sprintf(dir_file_path, "%s/%s", dir_path, identifier);
-  if(access(dir_file_path, F_OK) == -1) {
-    if(mkdir(dir_file_path, 0777) == -1){
-      fprintf(stderr, "log_execution_info: error creating the folder \"%s\". Aborting ...\n", dir_file_path);
-      PRINT_ERROR;
-      exit(EXIT_FAILURE);
-    }
-  }
-
-  file_path_len = dir_file_path_len + 9; // strlen("/exec.txt") == 9. The '\0' character already counted in dir_file_path_len 
-  file_path = (char*)calloc(file_path_len, sizeof(*file_path));
-  if(file_path == NULL){
-    fprintf(stderr, "log_execution_info: error allocating memory. Aborting ...\n");
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-  sprintf(file_path, "%s/exec.txt", dir_file_path);
-
-  fd = open(file_path, O_WRONLY | O_CREAT | O_APPEND, 0777);
-  if(fd == -1){
-    fprintf(stderr, "log_execution_info: error opening \"%s\" file. Aborting ...\n", file_path);
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-
-  bytes_written = write(fd, str, strlen(str));
-  if(bytes_written == -1){
-    fprintf(stderr, "log_execution_info: error writing to \"%s\" file. Aborting ...\n", file_path);
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-  
-  close(fd);
-  free(str);
-  free(dir_file_path);
-  free(file_path);
-}
-
-
-/**
- * @brief Saves the kernel trace to a specific file within a specified directory.
- * @param dir_path The path to a directory where to save various job executions and trace results. It will create a subfolder in this path
- * specific to this execution (if it doesn't already exist), and then it will create the "trace.txt" file which contains the kernel trace of
- * this program execution. The "dir_path" parameter must be the same as the one provided in the "log_execution_info()" in order to save
- * the kernel trace along with its jobs execution information.
- * @param identifier The user-defined string that identifies the program execution. It can be obtained by calling
- * the "generate_execution_identifier()" function. It should match the identifier provided in the "log_execution_info()"
- * during this program execution.
- * @param mode A short integer value that allows you to specify whether to use the trace_pipe or trace file to obtain kernel 
- * trace. To desire the first behaviour set this parameter to USE_TRACE_PIPE, to desire the second behaviour set this
- * parameter to USE_TRACE
-*/
-void log_trace(const char* dir_path, char* identifier, short mode){
-  int fd_read, fd_write;
-  char buffer[STR_BUFFER_SIZE];
-  char* dir_file_path;
-  int dir_file_path_len;
-  char* file_path;
-  int file_path_len;
-
-  if(mode == USE_TRACE_PIPE){
-    fd_read = open(TRACE_PIPE_PATH, O_RDONLY | O_NONBLOCK);
-  }else{
-    fd_read = open(TRACE_PATH, O_RDWR);
-  }
-
-  if(fd_read == -1){
-    if(mode == USE_TRACE_PIPE){
-      fprintf(stderr, "log_trace: error opening \"%s\" file. Aborting ...\n", TRACE_PIPE_PATH);
-    }else{
-      fprintf(stderr, "log_trace: error opening \"%s\" file. Aborting ...\n", TRACE_PATH);
-    }
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-
-  //Verify that the path provided by the user actually exists. If it doesn't exist, create it.
-  if(access(dir_path, F_OK) == -1) {
-    if(mkdir(dir_path, 0777) == -1){
-      fprintf(stderr, "log_execution_info: error creating the folder \"%s\". Aborting ...\n", dir_path);
-      PRINT_ERROR;
-      exit(EXIT_FAILURE);
-    }
-  }
-
-  //Create the subfolder containing the kernel trace only if it hasn't already been created
-  dir_file_path_len = strlen(dir_path) + 1 + strlen(identifier) + 1;
-  dir_file_path = (char*)calloc(dir_file_path_len, sizeof(*dir_file_path));
-  if(dir_file_path == NULL){
-    fprintf(stderr, "log_execution_info: error allocating memory. Aborting ...\n");
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-  sprintf(dir_file_path, "%s/%s", dir_path, identifier);
-  if(access(dir_file_path, F_OK) == -1) {
-    if(mkdir(dir_file_path, 0777) == -1){
-      fprintf(stderr, "log_execution_info: error creating the folder \"%s\". Aborting ...\n", dir_file_path);
-      PRINT_ERROR;
-      exit(EXIT_FAILURE);
-    }
-  }
-
-  file_path_len = dir_file_path_len + 10; // strlen("/trace.txt") == 10. The '\0' character already counted in dir_file_path_len 
-  file_path = (char*)calloc(file_path_len, sizeof(*file_path));
-  if(file_path == NULL){
-    fprintf(stderr, "log_execution_info: error allocating memory. Aborting ...\n");
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-  sprintf(file_path, "%s/trace.txt", dir_file_path);
-
-  fd_write = open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0777);
-  if(fd_write == -1){
-    fprintf(stderr, "log_trace: error opening \"%s\" file. Aborting ...\n", file_path);
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-
-  ssize_t bytes_read;
-  while ((bytes_read = read(fd_read, buffer, STR_BUFFER_SIZE)) > 0) {
-    if(write(fd_write, buffer, bytes_read) != bytes_read) {
-      fprintf(stderr, "log_trace: error writing to \"%s\" file. Aborting ...\n", file_path);
-      PRINT_ERROR;
-      exit(EXIT_FAILURE);
-    }
-  }
-
-  if(mode == USE_TRACE) CLEAN_TRACE
-  
-  // Close both files
-  close(fd_read);
-  close(fd_write);
-  free(dir_file_path);
-  free(file_path);
-}
-
-/**
- * @brief Writes a string to the specified file within the tracing infrastructure directory.
- * @param file_path The path to a file of the tracing infrastructure file.
- * @param str A pointer to a string that will be written to the file located in the path specified by 
- * "file_path" parameter.
-*/
-void tracing_write(const char* file_path, const char* str){
-  int fd;
-  size_t bytes_written;
-
-  if(str != NULL){
-    fd = open(file_path, O_WRONLY);
-    if(fd == -1){
-      fprintf(stderr, "tracing_write: error opening \"%s\" file. Aborting ...\n", file_path);
-      PRINT_ERROR;
-      exit(EXIT_FAILURE);
-    }
-
-    bytes_written = write(fd, str, strlen(str));
-    if(bytes_written == -1){
-      fprintf(stderr, "tracing_write: error writing to \"%s\" file. Aborting ...\n", file_path);
-      PRINT_ERROR;
-      exit(EXIT_FAILURE);
-    }
-    close(fd);
-  }
-}
-
-/**
- * @brief Generates an identifier based on the timestamp that can be used for the entire program execution.
- * @param reset A short integer value used to determine whether to create a new identifier or use the one previously created if it exists.
- * To obtain a new identifier use the value 1 for this parameter. To obtain the identifier previously created use the value 0 for this
- * parameter.
- * @return A pointer to a string identifier of the program execution. It must be freed after use.
-*/
-char* generate_execution_identifier(short reset){
-  time_t current_time;
-  struct tm *tm;
-  static char* identifier = NULL;
-  if(reset || identifier == NULL){
-    identifier = (char*)calloc(MAX_IDENTIFIER_SIZE, sizeof(*identifier));
-    current_time = time(NULL);
-    tm = localtime(&current_time);
-    strftime(identifier, MAX_IDENTIFIER_SIZE, "%Y%m%d%H%M%S", tm);
-  }
-  return identifier;
-}
-
-/**
- * @brief Structures and format the information contained within the exec_info struct into a comma separated string.
- * @param info A pointer to an exec_info struct.
- * @return A pointer to the comma separeted string containing all the fields of the exec_info struct.
-*/
-char* exec_info_to_str(void* info){
-  char* str;
-  int str_len;
-  int int_max_size = ceil(log10(INT_MAX)) + 1;
-  int long_max_size = ceil(log10(LONG_MAX)) + 1;
-  exec_info* e_info = (exec_info*)info;
-  
-  if(e_info->details != NULL)
-    str_len = strlen(e_info->id) + 2 + int_max_size + 2 + long_max_size + 2 + strlen(e_info->sched_policy) + 2 + int_max_size + 2 + strlen(e_info->details) + 2;
-  else
-    str_len = strlen(e_info->id) + 2 + int_max_size + 2 + long_max_size + 2 + strlen(e_info->sched_policy) + 2 + int_max_size + 2 + 10 + 2 ;
-
-  str = (char*)calloc(str_len, sizeof(*str));
-  if(str == NULL){
-    fprintf(stderr, "exec_info_to_str: error allocating memory. Aborting ...\n");
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-  
-  if(e_info->details != NULL)
-    sprintf(str, "%s, %d, %ld, %s, %d, %s\n", e_info->id, e_info->job_number, e_info->parameter, e_info->sched_policy, e_info->sched_priority, e_info->details);
-  else
-    sprintf(str, "%s, %d, %ld, %s, %d, No details\n", e_info->id, e_info->job_number, e_info->parameter, e_info->sched_policy, e_info->sched_priority);
-
-  return str;
-}
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sched.h>
+#include <dirent.h>
+#include <pthread.h>
+#include "event_tracing.h"
+#include "raw_trace.h"
+#include "trace_container.h"
+#include "light_metrics.h"
+
+
+#ifdef __x86_64__
+#define __NR_sched_setattr		314
+#define __NR_sched_getattr		315
+#endif
+
+#ifdef __i386__
+#define __NR_sched_setattr		351
+#define __NR_sched_getattr		352
+#endif
+
+#ifdef __arm__
+#define __NR_sched_setattr		380
+#define __NR_sched_getattr		381
+#endif
+
+
+/**
+ * @brief Creates an exec_info struct that will store job execution data.
+ * @param job_number  An integer value that identifies a job during a program execution.
+ * @param parameter A long integer value representing the parameter utilized for the job identified by the "job_number" parameter.
+ * @param details A pointer to a string useful to store additional data about execution or job details. If no details
+ * are needed, set this parameter to NULL.
+ * @return A pointer to the newly created exec_info struct correctly initialized. This structure must be deallocated using
+ * the "destroy_exec_info()" function when you're done with it.
+*/
+exec_info* create_exec_info(int job_number, long parameter, char* details){
+  exec_info* e_info;
+  struct sched_attr* s_attr;
+  e_info = (exec_info*)malloc(sizeof(*e_info));
+  bzero(e_info, sizeof(*e_info));
+
+  e_info->id = generate_execution_identifier(0);
+
+  s_attr = get_scheduler_attr(0);
+  switch (s_attr->sched_policy){
+    case SCHED_FIFO:
+      e_info->sched_policy = "SCHED_FIFO";
+      break;
+    case SCHED_RR:
+      e_info->sched_policy = "SCHED_RR";
+      break;
+    case SCHED_BATCH:
+      e_info->sched_policy = "SCHED_BATCH";
+      break;
+    case SCHED_IDLE:
+      e_info->sched_policy = "SCHED_IDLE";
+      break;
+    case SCHED_DEADLINE:
+      e_info->sched_policy = "SCHED_DEADLINE";
+      break;
+    case SCHED_OTHER:
+      e_info->sched_policy = "SCHED_OTHER";
+      break;
+    default:
+      e_info->sched_policy = "UNDEFINED";
+      break;
+  }
+  e_info->sched_priority = s_attr->sched_priority;
+  e_info->details = details;
+  free(s_attr);
+  return e_info;
+}
+
+/**
+ * @brief Frees up the memory allocated for the exec_info struct pointed by the "e_info" parameter.
+ * @param e_info A pointer to an exec_info struct.
+*/
+void destroy_exec_info(exec_info* e_info){
+  free(e_info->id);
+  free(e_info);
+}
+
+/**
+ * @brief Sets the value of an extra metric of an exec_info struct, adding the metric if it isn't already set. The metrics keep
+ * their values across jobs until they are set again or removed with "exec_info_clear_metrics()".
+ * @param e_info A pointer to an exec_info struct.
+ * @param name A pointer to the name of the metric. The string is not copied, so it must outlive the struct, as a string literal does.
+ * @param value The value of the metric.
+*/
+void exec_info_set_metric(exec_info* e_info, const char* name, long long value){
+  int i;
+
+  for(i = 0; i < e_info->n_metrics && strcmp(e_info->metrics[i].name, name) != 0; i++);
+  if(i == e_info->n_metrics){
+    if(e_info->n_metrics == MAX_EXEC_METRICS){
+      fprintf(stderr, "exec_info_set_metric: too many metrics, \"%s\" can't be added. Aborting ...\n", name);
+      exit(EXIT_FAILURE);
+    }
+    e_info->metrics[i].name = name;
+    e_info->n_metrics++;
+  }
+  e_info->metrics[i].value = value;
+}
+
+/**
+ * @brief Removes all the extra metrics of an exec_info struct.
+ * @param e_info A pointer to an exec_info struct.
+*/
+void exec_info_clear_metrics(exec_info* e_info){
+  e_info->n_metrics = 0;
+}
+
+/**
+ * @brief Sets a custom filter for an event in order to change the trace output based
+ * on that filter.
+ * @param subsystem A pointer to a string that specifies subsystem's name of the event.
+ * @param event A pointer to a string that specifies the event's name.
+ * @param filter_str A pointer to a string that specifies the filter value to use. If the RESET flag is used in
+ * the "flag" parameter, this parameter could be NULL.
+ * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to set
+ * the filter and the RESET macro to reset it. 
+*/
+void set_event_filter_custom(const char* subsystem, const char* event, const char* filter_str, short flag){
+  char* filter_path;
+  int filter_path_len;
+
+  filter_path_len = strlen(EVENTS_PATH) + 1 + strlen(subsystem) + 1 + strlen(event) + strlen("/filter") + 1;
+  filter_path = (char*)calloc(sizeof(*filter_path), filter_path_len);
+  if(filter_path == NULL){
+    fprintf(stderr, "set_event_filter_custom: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  if(sprintf(filter_path, "/sys/kernel/tracing/events/%s/%s/filter", subsystem, event) < 0){
+    fprintf(stderr, "set_event_filter_custom: error creating filter. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  if(flag == SET)
+    tracing_write(filter_path, filter_str);
+  else
+    tracing_write(filter_path, "0");
+  free(filter_path);
+}
+
+/**
+ * @brief Sets a default filter predefined in the library for an event specified by the "event_flag" parameter,
+ * in order to change the trace output based on that filter.
+ * @param pid The pid of the process used to filter events related to that process.
+ * @param event_flag A short integer value indicating the event type. Possible values can be: E_SCHED_SWITCH, 
+ * E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to 
+ * set the filter and the RESET macro to reset it. 
+*/
+void set_event_filter(pid_t pid, short event_flag, short flag){
+  int str_max_size = ceil(log10(INT_MAX))*2 + 25;
+  char filter_str[str_max_size];
+
+  switch(event_flag){
+    case E_SCHED_SWITCH:
+      if(flag == SET)
+        sprintf(filter_str, "prev_pid==%d || next_pid==%d", pid, pid);
+      else
+        sprintf(filter_str, "0");
+      tracing_write(SCHED_SWITCH_FILTER_PATH, filter_str);
+      break;
+    case E_SCHED_WAKEUP:
+      if(flag == SET)
+        sprintf(filter_str, "pid==%d", pid);
+      else
+        sprintf(filter_str, "0");
+      tracing_write(SCHED_WAKEUP_FILTER_PATH, filter_str);
+      break;
+    case E_SCHED_MIGRATE_TASK:
+      if(flag == SET)
+        sprintf(filter_str, "pid==%d", pid);
+      else
+        sprintf(filter_str, "0");
+      tracing_write(SCHED_MIGRATE_TASK_FILTER_PATH, filter_str);
+      break;
+    default:
+      fprintf(stderr, "set_event_filter: invalid event_flag (event_flag not found). Aborting ...\n");
+      exit(EXIT_FAILURE);
+      break;
+  }
+}
+
+/**
+ * @brief A redefinition of the sched_setattr() system call in the Linux kernel. It invokes the system call 
+ * using its index in the kernel system call table. The sched_setattr() system call sets the scheduling policy 
+ * and attributes for the thread specified by pid. If pid is 0, the calling thread's scheduling policy and 
+ * attributes are set.
+ * @param pid The pid of the process. Set it to 0 in order to set the scheduler attributes of the
+ * calling process.
+ * @param attr A pointer to a sched_attr struct which contains the scheduler attributes to be set
+ * @param flags An unsigned integer value used to specify some flags that can be ORed togheter.
+*/
+int sched_setattr(pid_t pid, const struct sched_attr *attr, unsigned int flags){
+	return syscall(__NR_sched_setattr, pid, attr, flags);
+}
+
+/**
+ * @brief A redefinition of the sched_getattr() system call in the Linux kernel. It invokes the system call
+ * call using its index into the kernel system call table. The sched_getattr() system call fetches the scheduling policy 
+ * and the associated attributes for the thread whose ID is specified in pid. If pid equals zero, the scheduling policy 
+ * and attributes of the calling thread will be retrieved.
+ * @param pid The pid of the process. Set it to 0 in order to retrieve the scheduler attributes of the
+ * calling process.
+ * @param attr A pointer to a sched_attr strhct which will be filled with the current scheduler attributes of the process
+ * identified by the "pid" parameter.
+ * @param size The size of the sched_attr struct as known to user space.
+ * @param flags An unsigned integer value provided to allow for future extensions to the interface; in the current 
+ * implementation it must be specified as 0.
+*/
+int sched_getattr(pid_t pid, struct sched_attr *attr, unsigned int size, unsigned int flags){
+  return syscall(__NR_sched_getattr, pid, attr, size, flags);
+}
+
+/**
+ * @brief Allows specifying scheduler priority and policy of a process identified by the "pid" parameter.
+ * @param pid The pid of the process whose scheduling policy and priority we want to change.
+ * @param policy An integer value that specifies the scheduling policy, as one of the 
+ * following SCHED_* values: SCHED_OTHER, SCHED_FIFO, SCHED_RR, SCHED_BATCH and SCHED_IDLE. The SCHED_DEADLINE policy
+ * needs a runtime, a deadline and a period, so it must be set with the "set_deadline_policy()" function.
+ * @param priority An integer value that specifies the static priority to be set when specifying sched_policy as SCHED_FIFO
+ * or SCHED_RR. The allowed range of priorities for these policies is between 1 (low priority) and 99 
+ * (high priority). For other policies, this field must be specified as 0.
+ * @param e_info A pointer to an exec_info struct. It is used to update the "sched_policy" and "sched_priority" fields of
+ * the exec_info struct according to the specified parameters. If it is set to NULL, the function will ignore this parameter.
+*/
+void set_scheduler_policy(pid_t pid, __u32 policy, __u32 priority, exec_info* e_info){
+  struct sched_attr attr = {0};
+  int max_priority = sched_get_priority_max(policy);
+  int min_priority = sched_get_priority_min(policy);
+
+  if(priority < min_priority){
+    priority = min_priority;
+  }
+
+  if(priority > max_priority){
+    priority = max_priority;
+  }
+
+  if(e_info != NULL){
+    switch (policy){
+      case SCHED_FIFO:
+        e_info->sched_policy = "SCHED_FIFO";
+        break;
+      case SCHED_RR:
+        e_info->sched_policy = "SCHED_RR";
+        break;
+      case SCHED_BATCH:
+        e_info->sched_policy = "SCHED_BATCH";
+        break;
+      case SCHED_IDLE:
+        e_info->sched_policy = "SCHED_IDLE";
+        break;
+      case SCHED_DEADLINE:
+        e_info->sched_policy = "SCHED_DEADLINE";
+        break;
+      case SCHED_OTHER:
+        e_info->sched_policy = "SCHED_OTHER";
+        break;
+      default:
+        e_info->sched_policy = "UNDEFINED";
+        break;
+    }
+    e_info->sched_priority = priority; 
+  }
+
+  if(policy == SCHED_DEADLINE){
+    fprintf(stderr, "set_scheduler_policy: the SCHED_DEADLINE policy needs a runtime, a deadline and a period, use set_deadline_policy(). Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+
+  attr.size = sizeof(attr);
+  attr.sched_policy = policy;
+  attr.sched_priority = priority;
+  attr.sched_flags = 0;
+  if(sched_setattr(pid, &attr, 0) < 0){
+    fprintf(stderr, "set_scheduler_policy: error setting the scheduler attributes. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Allows to set the SCHED_DEADLINE policy for a process identified by the "pid" parameter. The process gets "runtime"
+ * nanoseconds of CPU time every "period" nanoseconds, to be used within "deadline" nanoseconds from the beginning of each period.
+ * The kernel admits the reservation only if 0 < runtime <= deadline <= period and the total bandwidth of the deadline tasks fits
+ * the CPUs, so this function aborts if the parameters are refused.
+ * @param pid The pid of the process whose scheduling policy we want to change. Set it to 0 in order to use the calling thread.
+ * @param runtime The runtime in nanoseconds. It must be at least 1024 nanoseconds.
+ * @param deadline The relative deadline in nanoseconds. Set it to 0 in order to use the period.
+ * @param period The period in nanoseconds. Set it to 0 in order to use the deadline.
+ * @param flags The SCHED_FLAG_* values ORed together, such as SCHED_FLAG_DL_OVERRUN to receive a SIGXCPU signal whenever the
+ * process overruns its runtime. Set it to 0 in order to use none of them.
+ * @param e_info A pointer to an exec_info struct. It is used to update the "sched_policy" and "sched_priority" fields of the
+ * exec_info struct, and to set its "dl_runtime", "dl_deadline" and "dl_period" extra metrics. If it is set to NULL, the
+ * function will ignore this parameter.
+*/
+void set_deadline_policy(pid_t pid, __u64 runtime, __u64 deadline, __u64 period, __u64 flags, exec_info* e_info){
+  struct sched_attr attr = {0};
+
+  if(deadline == 0)
+    deadline = period;
+  if(period == 0)
+    period = deadline;
+  if(runtime < SCHED_DL_MIN_RUNTIME || runtime > deadline || deadline > period){
+    fprintf(stderr, "set_deadline_policy: invalid reservation, it must be %d <= runtime <= deadline <= period. Aborting ...\n", SCHED_DL_MIN_RUNTIME);
+    exit(EXIT_FAILURE);
+  }
+
+  if(e_info != NULL){
+    e_info->sched_policy = "SCHED_DEADLINE";
+    e_info->sched_priority = 0;
+    exec_info_set_metric(e_info, "dl_runtime", runtime);
+    exec_info_set_metric(e_info, "dl_deadline", deadline);
+    exec_info_set_metric(e_info, "dl_period", period);
+  }
+
+  attr.size = sizeof(attr);
+  attr.sched_policy = SCHED_DEADLINE;
+  attr.sched_flags = flags;
+  attr.sched_runtime = runtime;
+  attr.sched_deadline = deadline;
+  attr.sched_period = period;
+  if(sched_setattr(pid, &attr, 0) < 0){
+    // EBUSY means that the admission control refused the bandwidth, EPERM that the CPU affinity is not the whole root domain
+    fprintf(stderr, "set_deadline_policy: error setting the scheduler attributes. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Allows to retrieve the scheduling policy and attributes of the scheduler for the specified process.
+ * @param pid The pid of the process whose scheduling policy and scheduling attributes we want to retrieve.
+ * @return A pointer to a newly created sched_attr struct containing all scheduler data retrived. This structure
+ * must be freed after you're done with it.
+*/
+struct sched_attr* get_scheduler_attr(pid_t pid){
+  struct sched_attr* attr = (struct sched_attr*)malloc(sizeof(*attr));
+  bzero(attr, sizeof(*attr));
+
+  if(sched_getattr(pid, attr, sizeof(*attr), 0) < 0){
+    fprintf(stderr, "get_scheduler_policy: error retrieving the scheduler attributes. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  return attr;
+}
+
+/**
+ * @brief Allows to enable or disable the recording of all events contained in the specified subsystem.
+ * @param subsystem A pointer to a string that specifies subsystem name.
+ * @param op A short integer value that can be DISABLE (0) or ENABLE (1) and it will disable or enable the
+ * recording of all subsystem event respectively.
+*/
+void event_record_subsystem(const char* subsystem, short op){
+  char* enable_path;
+  int enable_path_len;
+  char op_character[2] = {0};
+
+  op_character[0] = op + '0';
+  if(op == ENABLE || op == DISABLE){
+    enable_path_len = strlen(EVENTS_PATH) + 1 + strlen(subsystem) + 1 + strlen("/enable") + 1;
+    enable_path = (char*)calloc(sizeof(*enable_path), enable_path_len);
+    if(enable_path == NULL){
+      fprintf(stderr, "event_record_custom: error allocating memory. Aborting ...\n");
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    tracing_write(enable_path, op_character);
+    free(enable_path);
+  }else{
+    fprintf(stderr, "event_record_custom: invalid op. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Allows to enable or disable the recording of an event contained in the specified subsystem.
+ * @param subsystem A pointer to a string that specifies subsystem name of the event.
+ * @param event A pointer to a string that specifies the event's name. Set it to NULL if you want to use a default 
+ * filter.
+ * @param op A short integer value that can be DISABLE (0) or ENABLE (1) and it will disable or enable the event 
+ * recording respectively.
+*/
+void event_record_custom(const char* subsystem, const char* event, short op){
+  char* enable_path;
+  int enable_path_len;
+  char op_character[2] = {0};
+
+  op_character[0] = op + '0';
+  if(op == ENABLE || op == DISABLE){
+    enable_path_len = strlen(EVENTS_PATH) + 1 + strlen(subsystem) + 1 + strlen(event) + strlen("/enable") + 1;
+    enable_path = (char*)calloc(sizeof(*enable_path), enable_path_len);
+    if(enable_path == NULL){
+      fprintf(stderr, "event_record_custom: error allocating memory. Aborting ...\n");
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    tracing_write(enable_path, op_character);
+    free(enable_path);
+  }else{
+    fprintf(stderr, "event_record_custom: invalid op. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Allows to enable or disable the recording of some specific event defined in the library.
+ * @param event_flag is short value indicating the event and it's used to enable or disable the recording that event
+ * in the kernel trace. Possible values can be: E_SCHED_SWITCH, E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param op is short value that can be DISABLE or ENABLE and it will disable or enable the event recording respectively.
+*/
+void event_record(short event_flag, short op){
+  char op_character[2] = {0};
+
+  op_character[0] = op + '0';
+  if(op == ENABLE || op == DISABLE){
+    switch(event_flag){
+    case E_SCHED_SWITCH:
+      tracing_write(SCHED_SWITCH_ENABLE_PATH, op_character);
+      break;
+    case E_SCHED_WAKEUP:
+      tracing_write(SCHED_WAKEUP_ENABLE_PATH, op_character);
+      break;
+    case E_SCHED_MIGRATE_TASK:
+      tracing_write(SCHED_MIGRATE_TASK_ENABLE_PATH, op_character);
+      break;
+    default:
+      fprintf(stderr, "event_record: invalid event_flag (event_flag not found). Aborting ...\n");
+      exit(EXIT_FAILURE);
+      break;
+    }
+  }else{
+    fprintf(stderr, "event_record: invalid op. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  } 
+}
+
+// Whether the trace_marker file is writable, checked once by the first thread that needs it
+static pthread_once_t tracefs_once = PTHREAD_ONCE_INIT;
+static short tracefs_writable = 0;
+
+/**
+ * @brief Checks whether the trace_marker file is writable. It is called once through "pthread_once()".
+*/
+static void check_tracefs(void){
+  tracefs_writable = access(TRACE_MARKER_PATH, W_OK) == 0;
+}
+
+/**
+ * @brief Checks once whether the tracefs can be used by the calling process, that is whether its trace_marker file is writable.
+ * It is not when the tracefs is not mounted or when the process doesn't have root privileges.
+ * @return 1 if the tracefs is available, 0 otherwise.
+*/
+short tracefs_available(void){
+  pthread_once(&tracefs_once, check_tracefs);
+  return tracefs_writable;
+}
+
+/**
+ * @brief Writes the beginning or the end of a job, identified by the "job_number" parameter,
+ * on the kernel trace. If the tracefs is not available, the job is measured by the unprivileged backend of "light_metrics.h"
+ * instead, and its metrics are written by the next call to "log_execution_info()".
+ * @param job_number An integer value that identifies a job during a program execution.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+ * The START flag is used to mark the beginning of the job identified by the "job_number" parameter. The STOP flag
+ * is used to mark the end of the job identified by the "job_number" parameter.
+*/
+void trace_mark_job(int job_number, short flag){
+  int str_max_size = ceil(log10(INT_MAX)) + 11;
+  char str[str_max_size];
+
+  if(!tracefs_available() && (flag == START || flag == STOP)){
+    light_mark_job(job_number, flag);
+    return;
+  }
+  if(flag == START){
+    sprintf(str, "start_job=%d", job_number);
+    tracing_write(TRACE_MARKER_PATH, str);
+  }else if(flag == STOP){
+    sprintf(str, "end_job=%d", job_number);
+    tracing_write(TRACE_MARKER_PATH, str);
+  }else{
+    fprintf(stderr, "trace_mark: invalid flag\n");
+  }
+}
+
+/**
+ * @brief Saves the job execution information to a specific file within a specified directory.
+ * @param dir_path The path to a directory where to save various job executions and trace results. It will create a subfolder in this path
+ * specific to this execution (if it doesn't already exist), and then it will create or update the "exec.txt" file by appending an new entry of 
+ * the current job execution information. The "dir_path" parameter must be the same as the one provided in the "log_trace()" in order to save
+ * job execution information along with its kernel trace.
+ * @param identifier The user-defined string that identifies the program execution. It can be obtained by calling the "generate_execution_identifier"
+ * function. It should match the identifier field contained in the struct pointed by the "info" parameter, if that field exists in the struct.
+ * @param info A pointer to a user-defined struct that contains information about an execution. It can also be a default exec_info struct. The 
+ * default structure exec_info has the following predefined fields related to the execution: "id", "job_number", "parameter", "details", 
+ * "sched_policy" and "sched_priority". To desire the use of the default struct, allocate that structure and pass a pointer to that structure.
+ * @param info_to_str A user-defined function that allows to create a comma separeted string based on the fields contained in the struct pointed 
+ * by "info" parameter. If the "info" parameter is pointer to an exec_info struct, set this parameter to NULL.
+ * @param flag A short integer value used to specify whether the interal library structure exec_info is being used to store job data or if 
+ * a user-defined structure is being used for this purpose. To specify the first behavior, set the value of this 
+ * parameter to DEFAULT_INFO and pass an exec_info struct in "info" parameter. To specify the second behavior, set the value of this parameter
+ * to USER_INFO and pass your defined structure and function in "info" and "info_to_str" parameters respectively.
+ * If the tracefs is not available, the metrics of the last job measured by "trace_mark_job()" are appended to the "metrics.txt" file too.
+*/
+void log_execution_info(const char* dir_path, const char* identifier, void* info, char* (*info_to_str)(void*), short flag){
+  int fd;
+  char* str;
+  char* dir_file_path;
+  int dir_file_path_len;
+  char* file_path;
+  int file_path_len;
+  size_t bytes_written;
+
+  if(flag == USER_INFO && info_to_str != NULL){
+    str = info_to_str(info);
+  }else if(flag == DEFAULT_INFO){
+    str = exec_info_to_str(info);
+  }else{
+    fprintf(stderr, "log_execution_info: invalid flag. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+
+  //Verify that the path provided by the user actually exists, if not creates it
+  if(access(dir_path, F_OK) == -1) {
+    if(mkdir(dir_path, 0777) == -1){
+      fprintf(stderr, "log_execution_info: error creating the folder \"%s\". Aborting ...\n", dir_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  //Create the subfolder containing execution information
+  dir_file_path_len = strlen(dir_path) + 1 + strlen(identifier) + 1;
+  dir_file_path = (char*)calloc(dir_file_path_len, sizeof(*dir_file_path));
+  if(dir_file_path == NULL){
+    fprintf(stderr, "log_execution_info: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  sprintf(dir_file_path, "%s/%s", dir_path, identifier);
+  if(access(dir_file_path, F_OK) == -1) {
+    if(mkdir(dir_file_path, 0777) == -1){
+      fprintf(stderr, "log_execution_info: error creating the folder \"%s\". Aborting ...\n", dir_file_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  file_path_len = dir_file_path_len + 9; // strlen("/exec.txt") == 9. The '\0' character already counted in dir_file_path_len 
+  file_path = (char*)calloc(file_path_len, sizeof(*file_path));
+  if(file_path == NULL){
+    fprintf(stderr, "log_execution_info: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  sprintf(file_path, "%s/exec.txt", dir_file_path);
+
+  fd = open(file_path, O_WRONLY | O_CREAT | O_APPEND, 0777);
+  if(fd == -1){
+    fprintf(stderr, "log_execution_info: error opening \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  bytes_written = write(fd, str, strlen(str));
+  if(bytes_written == -1){
+    fprintf(stderr, "log_execution_info: error writing to \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  
+  close(fd);
+  if(!tracefs_available())
+    light_log_job(dir_file_path, identifier);
+  free(str);
+  free(dir_file_path);
+  free(file_path);
+}
+
+
+/**
+ * @brief Saves the kernel trace of a tracefs, or of one of its instances, to an execution directory.
+ * @param tracing_path The path to the root directory of the tracefs or of the instance.
+ * @param dir_file_path The path to the execution directory. It must already exist.
+ * @param mode USE_TRACE_PIPE, USE_TRACE, USE_TRACE_RAW or USE_TRACE_CONTAINER, as in "log_trace()".
+*/
+static void save_trace(const char* tracing_path, const char* dir_file_path, short mode){
+  int fd_read, fd_write;
+  char buffer[STR_BUFFER_SIZE];
+  char read_path[PATH_MAX];
+  char file_path[PATH_MAX];
+  ssize_t bytes_read;
+
+  if(mode == USE_TRACE_RAW || mode == USE_TRACE_CONTAINER){
+    capture_raw_trace(tracing_path, dir_file_path);
+    if(mode == USE_TRACE_CONTAINER)
+      write_trace_container(dir_file_path, 1);
+    return;
+  }
+
+  if(mode == USE_TRACE_PIPE){
+    snprintf(read_path, PATH_MAX, "%s/trace_pipe", tracing_path);
+    fd_read = open(read_path, O_RDONLY | O_NONBLOCK);
+  }else{
+    snprintf(read_path, PATH_MAX, "%s/trace", tracing_path);
+    fd_read = open(read_path, O_RDWR);
+  }
+  if(fd_read == -1){
+    fprintf(stderr, "log_trace: error opening \"%s\" file. Aborting ...\n", read_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  snprintf(file_path, PATH_MAX, "%s/trace.txt", dir_file_path);
+  fd_write = open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0777);
+  if(fd_write == -1){
+    fprintf(stderr, "log_trace: error opening \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  while ((bytes_read = read(fd_read, buffer, STR_BUFFER_SIZE)) > 0) {
+    if(write(fd_write, buffer, bytes_read) != bytes_read) {
+      fprintf(stderr, "log_trace: error writing to \"%s\" file. Aborting ...\n", file_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // Opening the trace file with the O_TRUNC flag clears the ring buffer, as the CLEAN_TRACE macro does
+  if(mode == USE_TRACE)
+    close(open(read_path, O_WRONLY | O_TRUNC));
+
+  // Close both files
+  close(fd_read);
+  close(fd_write);
+}
+
+/**
+ * @brief Saves the kernel trace to a specific file within a specified directory.
+ * @param dir_path The path to a directory where to save various job executions and trace results. It will create a subfolder in this path
+ * specific to this execution (if it doesn't already exist), and then it will create the "trace.txt" file which contains the kernel trace of
+ * this program execution. The "dir_path" parameter must be the same as the one provided in the "log_execution_info()" in order to save
+ * the kernel trace along with its jobs execution information.
+ * @param identifier The user-defined string that identifies the program execution. It can be obtained by calling
+ * the "generate_execution_identifier()" function. It should match the identifier provided in the "log_execution_info()"
+ * during this program execution.
+ * @param mode A short integer value that allows you to specify whether to use the trace_pipe or trace file to obtain kernel 
+ * trace. To desire the first behaviour set this parameter to USE_TRACE_PIPE, to desire the second behaviour set this
+ * parameter to USE_TRACE. Set it to USE_TRACE_RAW to save instead the binary per-CPU traces in "trace_cpuN.raw" files, along
+ * with the format files needed to decode them with the functions of "raw_trace.h". Set it to USE_TRACE_CONTAINER to convert the
+ * binary per-CPU traces into the compact "trace.bin" container described in "trace_container.h". If the tracefs is not available
+ * there is no trace to save, and only the subfolder is created.
+*/
+void log_trace(const char* dir_path, char* identifier, short mode){
+  char* dir_file_path;
+
+  //Create the folder and the subfolder containing the kernel trace only if they haven't already been created
+  dir_file_path = create_execution_directory(dir_path, identifier);
+  if(tracefs_available())
+    save_trace(TRACING_PATH, dir_file_path, mode);
+  free(dir_file_path);
+}
+
+/**
+ * @brief Writes a string to the specified file within the tracing infrastructure directory.
+ * @param file_path The path to a file of the tracing infrastructure file.
+ * @param str A pointer to a string that will be written to the file located in the path specified by 
+ * "file_path" parameter.
+*/
+void tracing_write(const char* file_path, const char* str){
+  int fd;
+  size_t bytes_written;
+
+  if(str != NULL){
+    fd = open(file_path, O_WRONLY);
+    if(fd == -1){
+      fprintf(stderr, "tracing_write: error opening \"%s\" file. Aborting ...\n", file_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+
+    bytes_written = write(fd, str, strlen(str));
+    if(bytes_written == -1){
+      fprintf(stderr, "tracing_write: error writing to \"%s\" file. Aborting ...\n", file_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    close(fd);
+  }
+}
+
+/**
+ * @brief Writes a string to a tracing infrastructure file already opened, such as the ones kept by a tracing_session struct.
+ * @param fd The file descriptor of a file of the tracing infrastructure opened in write mode.
+ * @param str A pointer to a string that will be written to the file referred by the "fd" parameter.
+*/
+void tracing_write_fd(int fd, const char* str){
+  if(str != NULL){
+    if(write(fd, str, strlen(str)) == -1){
+      fprintf(stderr, "tracing_write_fd: error writing to the file descriptor %d. Aborting ...\n", fd);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+/**
+ * @brief Opens a file of the tracefs whose path is relative to the root directory of the session.
+ * @param session A pointer to a tracing_session struct whose "tracing_path" field is already set.
+ * @param relative_path A pointer to a string that specifies the path of the file relative to the tracefs root directory.
+ * @param flags The flags used to open the file.
+ * @return The file descriptor of the opened file.
+*/
+static int open_session_file(tracing_session* session, const char* relative_path, int flags){
+  char* file_path;
+  int file_path_len;
+  int fd;
+
+  file_path_len = strlen(session->tracing_path) + 1 + strlen(relative_path) + 1;
+  file_path = (char*)calloc(file_path_len, sizeof(*file_path));
+  if(file_path == NULL){
+    fprintf(stderr, "create_tracing_session: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  sprintf(file_path, "%s/%s", session->tracing_path, relative_path);
+
+  fd = open(file_path, flags);
+  if(fd == -1){
+    fprintf(stderr, "create_tracing_session: error opening \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  free(file_path);
+  return fd;
+}
+
+/**
+ * @brief Creates a tracing_session struct opening once all the tracefs files used by the library, that will be kept
+ * open until the "destroy_tracing_session()" function is called.
+ * @param tracing_path The path to the root directory of the tracefs. Set it to NULL in order to use the default one (TRACING_PATH).
+ * @return A pointer to the newly created tracing_session struct. This structure must be deallocated using the
+ * "destroy_tracing_session()" function when you're done with it.
+*/
+tracing_session* create_tracing_session(const char* tracing_path){
+  tracing_session* session;
+  const char* events[N_EVENTS] = {"sched_switch", "sched_wakeup", "sched_migrate_task"};
+  char relative_path[PATH_MAX];
+
+  session = (tracing_session*)malloc(sizeof(*session));
+  if(session == NULL){
+    fprintf(stderr, "create_tracing_session: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  bzero(session, sizeof(*session));
+
+  session->tracing_path = strdup(tracing_path != NULL ? tracing_path : TRACING_PATH);
+  if(session->tracing_path == NULL){
+    fprintf(stderr, "create_tracing_session: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  session->tracing_on_fd = open_session_file(session, "tracing_on", O_WRONLY);
+  session->trace_marker_fd = open_session_file(session, "trace_marker", O_WRONLY);
+  sprintf(relative_path, "%s/trace_marker_raw", session->tracing_path);
+  session->trace_marker_raw_fd = open(relative_path, O_WRONLY);
+  session->buffer_size_kb_fd = open_session_file(session, "buffer_size_kb", O_WRONLY);
+  for(int i = 0; i < N_EVENTS; i++){
+    sprintf(relative_path, "events/sched/%s/enable", events[i]);
+    session->enable_fd[i] = open_session_file(session, relative_path, O_WRONLY);
+    sprintf(relative_path, "events/sched/%s/filter", events[i]);
+    session->filter_fd[i] = open_session_file(session, relative_path, O_WRONLY);
+  }
+  return session;
+}
+
+/**
+ * @brief Creates a private instance of the tracefs (a subdirectory of TRACING_INSTANCES_PATH) and a tracing_session that uses it.
+ * The instance has its own ring buffer, tracing_on, trace_marker, event enable and filter files, so that concurrent executions
+ * that use different instances don't clobber each other's trace, filters or buffer size.
+ * @param instance_name The name of the instance, such as the execution identifier. An instance with the same name must not exist.
+ * @return A pointer to a newly created tracing_session struct. It must be deallocated using the "destroy_tracing_session()"
+ * function, which also removes the instance and its ring buffer.
+*/
+tracing_session* create_instance_session(const char* instance_name){
+  tracing_session* session;
+  char instance_path[PATH_MAX];
+
+  snprintf(instance_path, PATH_MAX, "%s/%s", TRACING_INSTANCES_PATH, instance_name);
+  if(mkdir(instance_path, 0755) == -1){
+    fprintf(stderr, "create_instance_session: error creating the instance \"%s\". Aborting ...\n", instance_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  session = create_tracing_session(instance_path);
+  session->is_instance = 1;
+  return session;
+}
+
+/**
+ * @brief Closes all the files kept open by a tracing_session struct and frees up the memory allocated for it. If the session
+ * has been created by "create_instance_session()", the instance is removed too.
+ * @param session A pointer to a tracing_session struct.
+*/
+void destroy_tracing_session(tracing_session* session){
+  close(session->tracing_on_fd);
+  close(session->trace_marker_fd);
+  if(session->trace_marker_raw_fd != -1)
+    close(session->trace_marker_raw_fd);
+  close(session->buffer_size_kb_fd);
+  for(int i = 0; i < N_EVENTS; i++){
+    close(session->enable_fd[i]);
+    close(session->filter_fd[i]);
+  }
+  // The kernel refuses to remove an instance while its files are open
+  if(session->is_instance && rmdir(session->tracing_path) == -1){
+    fprintf(stderr, "destroy_tracing_session: error removing the instance \"%s\". Aborting ...\n", session->tracing_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  free(session->tracing_path);
+  free(session);
+}
+
+/**
+ * @brief Same as "log_trace()", but it saves the kernel trace of the tracefs, or of the private instance, used by a tracing_session.
+ * @param session A pointer to a tracing_session struct.
+ * @param dir_path The path to a directory where to save various job executions and trace results.
+ * @param identifier The string that identifies the program execution.
+ * @param mode USE_TRACE_PIPE, USE_TRACE, USE_TRACE_RAW or USE_TRACE_CONTAINER, as in "log_trace()".
+*/
+void log_trace_session(tracing_session* session, const char* dir_path, const char* identifier, short mode){
+  char* dir_file_path;
+
+  dir_file_path = create_execution_directory(dir_path, identifier);
+  save_trace(session->tracing_path, dir_file_path, mode);
+  free(dir_file_path);
+}
+
+/**
+ * @brief Cleans the kernel trace of the tracefs used by the session, without spawning a shell as the CLEAN_TRACE macro does.
+ * Opening the trace file with the O_TRUNC flag is enough to clear the ring buffer.
+ * @param session A pointer to a tracing_session struct.
+*/
+void clean_trace_session(tracing_session* session){
+  close(open_session_file(session, "trace", O_WRONLY | O_TRUNC));
+}
+
+/**
+ * @brief Same as "set_event_filter()", but it uses the filter file descriptors kept open by a tracing_session struct.
+ * @param session A pointer to a tracing_session struct.
+ * @param pid The pid of the process used to filter events related to that process.
+ * @param event_flag A short integer value indicating the event type. Possible values can be: E_SCHED_SWITCH, 
+ * E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to 
+ * set the filter and the RESET macro to reset it. 
+*/
+void set_event_filter_session(tracing_session* session, pid_t pid, short event_flag, short flag){
+  int str_max_size = ceil(log10(INT_MAX))*2 + 25;
+  char filter_str[str_max_size];
+
+  if(event_flag < E_SCHED_SWITCH || event_flag > N_EVENTS){
+    fprintf(stderr, "set_event_filter_session: invalid event_flag (event_flag not found). Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+
+  if(flag != SET)
+    sprintf(filter_str, "0");
+  else if(event_flag == E_SCHED_SWITCH)
+    sprintf(filter_str, "prev_pid==%d || next_pid==%d", pid, pid);
+  else
+    sprintf(filter_str, "pid==%d", pid);
+  tracing_write_fd(session->filter_fd[event_flag - 1], filter_str);
+}
+
+/**
+ * @brief Same as "set_event_filter_session()", but the filter matches the events of any of the processes of a set, such as
+ * the workers that run the jobs of an execution concurrently.
+ * @param session A pointer to a tracing_session struct.
+ * @param pids A pointer to the array of the pids of the processes.
+ * @param n_pids The number of elements of the "pids" array. It must be positive.
+ * @param event_flag A short integer value indicating the event type. Possible values can be: E_SCHED_SWITCH,
+ * E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to
+ * set the filter and the RESET macro to reset it.
+*/
+void set_event_filter_pids_session(tracing_session* session, const pid_t* pids, int n_pids, short event_flag, short flag){
+  char* filter_str;
+  int offset = 0;
+
+  if(event_flag < E_SCHED_SWITCH || event_flag > N_EVENTS || n_pids <= 0){
+    fprintf(stderr, "set_event_filter_pids_session: invalid event_flag or empty set of pids. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  if(flag != SET){
+    tracing_write_fd(session->filter_fd[event_flag - 1], "0");
+    return;
+  }
+
+  // Each pid takes at most "prev_pid==<pid> || next_pid==<pid> || "
+  filter_str = (char*)malloc(n_pids * (2 * (ceil(log10(INT_MAX)) + 1) + 30) + 1);
+  if(filter_str == NULL){
+    fprintf(stderr, "set_event_filter_pids_session: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  for(int i = 0; i < n_pids; i++){
+    if(event_flag == E_SCHED_SWITCH)
+      offset += sprintf(filter_str + offset, "%sprev_pid==%d || next_pid==%d", i > 0 ? " || " : "", pids[i], pids[i]);
+    else
+      offset += sprintf(filter_str + offset, "%spid==%d", i > 0 ? " || " : "", pids[i]);
+  }
+  tracing_write_fd(session->filter_fd[event_flag - 1], filter_str);
+  free(filter_str);
+}
+
+/**
+ * @brief Same as "set_event_filter_pids_session()", but the filter matches the events of all the threads of a process, listed from
+ * the "/proc/<tgid>/task" directory. The threads created after the call are not matched, so it must be called again after creating them.
+ * @param session A pointer to a tracing_session struct.
+ * @param tgid The thread group id of the process, that is its pid.
+ * @param event_flag A short integer value indicating the event type. Possible values can be: E_SCHED_SWITCH,
+ * E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to
+ * set the filter and the RESET macro to reset it.
+ * @return The number of threads matched by the filter.
+*/
+int set_event_filter_tgid_session(tracing_session* session, pid_t tgid, short event_flag, short flag){
+  char task_path[PATH_MAX];
+  DIR* task_dir;
+  struct dirent* entry;
+  pid_t* tids = NULL;
+  pid_t* new_tids;
+  int n_tids = 0, max_tids = 0;
+  char* end_ptr;
+  long tid;
+
+  snprintf(task_path, PATH_MAX, "/proc/%d/task", tgid);
+  task_dir = opendir(task_path);
+  if(task_dir == NULL){
+    fprintf(stderr, "set_event_filter_tgid_session: error opening \"%s\" directory. Aborting ...\n", task_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  while((entry = readdir(task_dir)) != NULL){
+    tid = strtol(entry->d_name, &end_ptr, 10);
+    if(end_ptr == entry->d_name || *end_ptr != '\0')
+      continue;
+    if(n_tids == max_tids){
+      max_tids = max_tids == 0 ? 16 : max_tids * 2;
+      new_tids = (pid_t*)realloc(tids, max_tids * sizeof(*tids));
+      if(new_tids == NULL){
+        fprintf(stderr, "set_event_filter_tgid_session: error allocating memory. Aborting ...\n");
+        PRINT_ERROR;
+        exit(EXIT_FAILURE);
+      }
+      tids = new_tids;
+    }
+    tids[n_tids++] = (pid_t)tid;
+  }
+  closedir(task_dir);
+
+  set_event_filter_pids_session(session, tids, n_tids, event_flag, flag);
+  free(tids);
+  return n_tids;
+}
+
+/**
+ * @brief Same as "event_record()", but it uses the enable file descriptors kept open by a tracing_session struct.
+ * @param session A pointer to a tracing_session struct.
+ * @param event_flag A short value indicating the event. Possible values can be: E_SCHED_SWITCH, E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param op A short value that can be the macros DISABLE or ENABLE and it will disable or enable the event recording respectively.
+*/
+void event_record_session(tracing_session* session, short event_flag, short op){
+  if(op != ENABLE && op != DISABLE){
+    fprintf(stderr, "event_record_session: invalid op. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  if(event_flag < E_SCHED_SWITCH || event_flag > N_EVENTS){
+    fprintf(stderr, "event_record_session: invalid event_flag (event_flag not found). Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  tracing_write_fd(session->enable_fd[event_flag - 1], op == ENABLE ? "1" : "0");
+}
+
+/**
+ * @brief Same as "trace_mark_job()", but each marker costs a single write() on the trace_marker file descriptor kept
+ * open by a tracing_session struct.
+ * @param session A pointer to a tracing_session struct.
+ * @param job_number An integer value that identifies a job during a program execution.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+*/
+void trace_mark_job_session(tracing_session* session, int job_number, short flag){
+  char str[32];
+  int str_len;
+
+  if(flag == START){
+    str_len = sprintf(str, "start_job=%d", job_number);
+  }else if(flag == STOP){
+    str_len = sprintf(str, "end_job=%d", job_number);
+  }else{
+    fprintf(stderr, "trace_mark_job_session: invalid flag\n");
+    return;
+  }
+  if(write(session->trace_marker_fd, str, str_len) == -1){
+    fprintf(stderr, "trace_mark_job_session: error writing to the trace_marker file. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Same as "trace_mark_job_session()", but the marker identifies the worker that runs the job too, as
+ * "start_job=<worker>:<job_number>" and "end_job=<worker>:<job_number>". It is used when several workers run their jobs
+ * concurrently, each one numbering its own jobs.
+ * @param session A pointer to a tracing_session struct.
+ * @param worker A positive integer value that identifies the worker.
+ * @param job_number An integer value that identifies a job of the worker.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+*/
+void trace_mark_worker_job_session(tracing_session* session, int worker, int job_number, short flag){
+  char str[48];
+  int str_len;
+
+  if(flag == START){
+    str_len = sprintf(str, "start_job=%d:%d", worker, job_number);
+  }else if(flag == STOP){
+    str_len = sprintf(str, "end_job=%d:%d", worker, job_number);
+  }else{
+    fprintf(stderr, "trace_mark_worker_job_session: invalid flag\n");
+    return;
+  }
+  if(write(session->trace_marker_fd, str, str_len) == -1){
+    fprintf(stderr, "trace_mark_worker_job_session: error writing to the trace_marker file. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Same as "trace_mark_worker_job_session()", but the worker is the calling thread, identified by its tid, so that the threads
+ * of a process can mark their jobs concurrently, each one numbering its own jobs.
+ * @param session A pointer to a tracing_session struct.
+ * @param job_number An integer value that identifies a job of the calling thread.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+*/
+void trace_mark_thread_job_session(tracing_session* session, int job_number, short flag){
+  trace_mark_worker_job_session(session, gettid(), job_number, flag);
+}
+
+/**
+ * @brief Same as "trace_mark_job_session()", but it writes a raw_job_marker binary record to the trace_marker_raw
+ * file instead of a formatted string to the trace_marker file.
+ * @param session A pointer to a tracing_session struct.
+ * @param job_number An integer value that identifies a job during a program execution.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+ * @param payload A long integer value stored along with the marker, such as the parameter used for the job. Set it to 0 if
+ * it is not needed.
+*/
+void trace_mark_job_raw_session(tracing_session* session, int job_number, short flag, long payload){
+  trace_mark_worker_job_raw_session(session, 0, job_number, flag, payload);
+}
+
+/**
+ * @brief Same as "trace_mark_job_raw_session()", but the "worker" field of the raw_job_marker record identifies the worker
+ * that runs the job, as "trace_mark_worker_job_session()" does.
+ * @param session A pointer to a tracing_session struct.
+ * @param worker An integer value that identifies the worker, or 0 if the jobs are not run by concurrent workers.
+ * @param job_number An integer value that identifies a job of the worker.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+ * @param payload A long integer value stored along with the marker, such as the parameter used for the job. Set it to 0 if
+ * it is not needed.
+*/
+void trace_mark_worker_job_raw_session(tracing_session* session, int worker, int job_number, short flag, long payload){
+  raw_job_marker marker = {0};
+
+  if(flag != START && flag != STOP){
+    fprintf(stderr, "trace_mark_worker_job_raw_session: invalid flag\n");
+    return;
+  }
+  if(session->trace_marker_raw_fd == -1){
+    fprintf(stderr, "trace_mark_worker_job_raw_session: the \"%s/trace_marker_raw\" file is not available. Aborting ...\n", session->tracing_path);
+    exit(EXIT_FAILURE);
+  }
+
+  marker.id = RAW_MARKER_ID;
+  marker.job_number = job_number;
+  marker.worker = worker;
+  marker.state = flag;
+  marker.payload = payload;
+  if(write(session->trace_marker_raw_fd, &marker, sizeof(marker)) == -1){
+    fprintf(stderr, "trace_mark_worker_job_raw_session: error writing to the trace_marker_raw file. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Creates, if they don't already exist, the directory where to save the results and its subfolder specific to
+ * the program execution.
+ * @param dir_path The path to a directory where to save various job executions and trace results.
+ * @param identifier The string that identifies the program execution, used as name of the subfolder.
+ * @return A pointer to a string containing the path of the subfolder. It must be freed after use.
+*/
+char* create_execution_directory(const char* dir_path, const char* identifier){
+  char* dir_file_path;
+  int dir_file_path_len;
+
+  if(access(dir_path, F_OK) == -1) {
+    if(mkdir(dir_path, 0777) == -1 && errno != EEXIST){
+      fprintf(stderr, "create_execution_directory: error creating the folder \"%s\". Aborting ...\n", dir_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  dir_file_path_len = strlen(dir_path) + 1 + strlen(identifier) + 1;
+  dir_file_path = (char*)calloc(dir_file_path_len, sizeof(*dir_file_path));
+  if(dir_file_path == NULL){
+    fprintf(stderr, "create_execution_directory: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  sprintf(dir_file_path, "%s/%s", dir_path, identifier);
+  if(access(dir_file_path, F_OK) == -1) {
+    if(mkdir(dir_file_path, 0777) == -1 && errno != EEXIST){
+      fprintf(stderr, "create_execution_directory: error creating the folder \"%s\". Aborting ...\n", dir_file_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+  }
+  return dir_file_path;
+}
+
+// The identifier of the program execution, shared by all the threads
+static char execution_identifier[MAX_IDENTIFIER_SIZE];
+static pthread_mutex_t identifier_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Generates an identifier based on the timestamp that can be used for the entire program execution. It can be called by several
+ * threads at the same time, since the identifier is shared by all of them and protected by a mutex.
+ * @param reset A short integer value used to determine whether to create a new identifier or use the one previously created if it exists.
+ * To obtain a new identifier use the value 1 for this parameter. To obtain the identifier previously created use the value 0 for this
+ * parameter.
+ * @return A pointer to a copy of the string identifier of the program execution, owned by the caller. It must be freed after use.
+*/
+char* generate_execution_identifier(short reset){
+  time_t current_time;
+  struct tm tm;
+  char* identifier;
+
+  pthread_mutex_lock(&identifier_mutex);
+  if(reset || execution_identifier[0] == '\0'){
+    current_time = time(NULL);
+    localtime_r(&current_time, &tm);
+    strftime(execution_identifier, MAX_IDENTIFIER_SIZE, "%Y%m%d%H%M%S", &tm);
+  }
+  identifier = strdup(execution_identifier);
+  pthread_mutex_unlock(&identifier_mutex);
+  if(identifier == NULL){
+    fprintf(stderr, "generate_execution_identifier: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  return identifier;
+}
+
+/**
+ * @brief Structures and format the information contained within the exec_info struct into a comma separated string.
+ * @param info A pointer to an exec_info struct.
+ * @return A pointer to the comma separeted string containing all the fields of the exec_info struct.
+*/
+char* exec_info_to_str(void* info){
+  char* str;
+  int str_len;
+
+  str_len = exec_info_format(NULL, 0, info) + 1;
+  str = (char*)calloc(str_len, sizeof(*str));
+  if(str == NULL){
+    fprintf(stderr, "exec_info_to_str: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  exec_info_format(str, str_len, info);
+
+  return str;
+}
+
+/**
+ * @brief Formats the information contained within the exec_info struct into a comma separated line, using a buffer provided
+ * by the caller instead of allocating a new one. The extra metrics, if any, follow the default fields as "name=value" fields.
+ * @param str A pointer to the buffer where to write the line. It can be NULL if "size" is 0.
+ * @param size The size in bytes of the buffer.
+ * @param info A pointer to an exec_info struct.
+ * @return The length of the whole line, as returned by snprintf(). If it is greater than or equal to "size", the line has been
+ * truncated.
+*/
+int exec_info_format(char* str, size_t size, const exec_info* info){
+  int len;
+  int field_len;
+
+  len = snprintf(str, size, "%s, %d, %ld, %s, %d, %s", info->id, info->job_number, info->parameter, info->sched_policy,
+                 info->sched_priority, info->details != NULL ? info->details : "No details");
+  // Each field is written after the previous ones while they fit, otherwise only its length is counted
+  for(int i = 0; i <= info->n_metrics && len >= 0; i++){
+    if(i < info->n_metrics)
+      field_len = snprintf((size_t)len < size ? str + len : NULL, (size_t)len < size ? size - len : 0, ", %s=%lld",
+                           info->metrics[i].name, info->metrics[i].value);
+    else
+      field_len = snprintf((size_t)len < size ? str + len : NULL, (size_t)len < size ? size - len : 0, "\n");
+    len = field_len < 0 ? field_len : len + field_len;
+  }
+  return len;
+}
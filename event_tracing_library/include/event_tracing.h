@@ -1,273 +1,567 @@
-#ifndef EVENT_TRACING_H_
-#define EVENT_TRACING_H_
-
-#include <linux/types.h>
-
-#define E_SCHED_SWITCH 1 ///>Macro used to refer to the sched_swtich event.
-#define E_SCHED_WAKEUP 2 ///>Macro used to refer to the sched_wakeup event.
-#define E_SCHED_MIGRATE_TASK 3 ///>Macro used to refer to the sched_migrate_task event.
-
-#define DISABLE 0	///>Macro used in event_record(), event_record_custom() and event_record_subsystem() to disable the record of one or all events.
-#define ENABLE 1 	///>Macro used in event_record(), event_record_custom() and event_record_subsystem() to enable the record of one or all events.
-
-#define STOP 0		///>Macro used in trace_mark_job() to trace mark the end of a job.
-#define START 1		///>Macro used in trace_mark_job() to trace mark the beginning of a job.
-
-#define SET 0			///>Macro used in set_event_filter() and set_event_filter_custom() to set the filter provided as a parameter.
-#define RESET 1		///>Macro used in set_event_filter() and set_event_filter_custom() to reset/clear the filter.
-
-#define DEFAULT_INFO 0	///>Macro used in log_execution_info() to specify that a user-defined struct is being used.
-#define USER_INFO 1			///>Macro used in log_execution_info() to specify that the default exec_info struct is being used.
-
-#define USE_TRACE_PIPE 0	///>Macro used in log_trace() to specify that the kernel trace will be read using /sys/kernel/tracing/trace_pipe.
-#define USE_TRACE 1				///>Macro used in log_trace() to specify that the kernel trace will be read using /sys/kernel/tracing/trace.
-
-#define SCHED_OTHER 0			///>Non-real-time scheduling policy.
-#define SCHED_FIFO 1			///>Real-time scheduling policy.
-#define SCHED_RR 2				///>Real-time scheduling policy. 
-#define SCHED_BATCH 3			///>Non-real-time scheduling policy.
-#define SCHED_IDLE 5			///>Non-real-time scheduling policy.
-#define SCHED_DEADLINE 6	///>Deadline scheduling policy.
-
-#define BUFFER_SIZE_KB 1408 ///>Default ring buffer size of the tracing infrastrucuture expressed in KB.
-
-#define TRACING_ON_PATH "/sys/kernel/tracing/tracing_on" ///>Path to the tracing_on file of the tracefs.
-#define TRACE_MARKER_PATH "/sys/kernel/tracing/trace_marker" ///>Path to the trace_marker file of the tracefs.
-#define TRACE_PIPE_PATH "/sys/kernel/tracing/trace_pipe" ///>Path to the trace_pipe file of the tracefs.
-#define TRACE_PATH "/sys/kernel/tracing/trace" ///>Path to the trace file of the tracefs.
-#define BUFFER_SIZE_KB_PATH "/sys/kernel/tracing/buffer_size_kb" ///>Path to the buffer_size_kb file of the tracefs.
-#define EVENTS_PATH "/sys/kernel/tracing/events" ///>Path to the events directory of the tracefs.
-#define SCHED_SWITCH_FILTER_PATH "/sys/kernel/tracing/events/sched/sched_switch/filter" ///>Path to the filter file of the sched_switch event.
-#define SCHED_SWITCH_ENABLE_PATH "/sys/kernel/tracing/events/sched/sched_switch/enable" ///>Path to the enable file of the sched_switch event.
-#define SCHED_WAKEUP_FILTER_PATH "/sys/kernel/tracing/events/sched/sched_wakeup/filter" ///>Path to the filter file of the sched_wakeup event.
-#define SCHED_WAKEUP_ENABLE_PATH "/sys/kernel/tracing/events/sched/sched_wakeup/enable" ///>Path to the enable file of the sched_wakeup event.
-#define SCHED_MIGRATE_TASK_FILTER_PATH "/sys/kernel/tracing/events/sched/sched_migrate_task/filter" ///>Path to the filter file of the sched_migrate_task event.
-#define SCHED_MIGRATE_TASK_ENABLE_PATH "/sys/kernel/tracing/events/sched/sched_migrate_task/enable" ///>Path to the enable file of the sched_migrate_task event.
-
-#define MAX_IDENTIFIER_SIZE 20	///>Max length of an identifier generated using generate_execution_identifier() function.
-#define STR_BUFFER_SIZE 4096		///>Buffer size for reading and writing operations.
-
-/**
- * @brief Changes the ring buffer size used to store the kernel trace.
- * @param str_buffer_kb A pointer to a string which represents the new number of kb of the ring buffer.
-*/
-#define SET_BUFFER_SIZE(str_buffer_kb)	if(str_buffer_kb != NULL) { \
-																					tracing_write(BUFFER_SIZE_KB_PATH, str_buffer_kb);\
-																				}
-
-/**
- * @brief Cleans the kernel trace file located in /sys/kernel/tracing/trace.
-*/
-#define CLEAN_TRACE if(system("echo 0 > /sys/kernel/tracing/trace") == -1) { \
-     	 								fprintf(stderr, "log_trace: error cleaning the \"%s\" file. Aborting ...\n", TRACE_PATH); \
-      								exit(EXIT_FAILURE); \
-    								}
-
-/**
- * @brief Allows to enable the tracing infrastructure in order to effectively use the others functions in the library.
-*/
-#define ENABLE_TRACING tracing_write(TRACING_ON_PATH, "1"); \
-											 CLEAN_TRACE
-
-/**
- * @brief Allows to disable the tracing infrastructure that was previously enabled.
-*/
-#define DISABLE_TRACING tracing_write(TRACING_ON_PATH, "0");
-
-/**
- * @brief Writes to the kernel trace a string passed as parameter.
- * @param str A pointer to a the string to be written to the kernel trace.
-*/
-#define TRACE_MARK(str) tracing_write(TRACE_MARKER_PATH, str); 
-
-/**
- * @brief Prints out on stderror the string associated to the errno value.
-*/
-#define PRINT_ERROR fprintf(stderr, "%s:%d: Error %d \"%s\"\n", __FILE__, __LINE__, errno, strerror(errno));
-
-/**
- * @brief A structure that contains information that characterizes the job execution. This
- * is a default structure that can be used by the user, or the user can define their own structure
- * to store different job execution data.
-*/
-typedef struct exec_info{
-  char* id;	///> The program execution identifier.
-  int job_number; ///> A number that identifies the job in this execution.
-  long parameter; ///> The value of the parameter used for this job.
-	char* sched_policy; ///> The scheduling policy used for this job.
-	int sched_priority; ///> The scheduling priority used for this job.
-	char* details; ///> Additional details that the user can provide as a string.
-} exec_info;
-
-/**
- * @brief A redefinition of a structure of the linux kernel that serves to set or to retrieve the scheduler
- * attributes and scheduling policy related to a thread.
-*/
- struct sched_attr {
-	__u32 size;	///> Size in bytes of this structure
-	__u32 sched_policy;	///> Policy (SCHED_*)
-	__u64 sched_flags; ///> Flags
-	__s32 sched_nice; ///> Nice value (SCHED_OTHER, SCHED_BATCH)
-	__u32 sched_priority; ///> Static priority (SCHED_FIFO, SCHED_RR)
-	__u64 sched_runtime; ///> Field for SCHED_DEADLINE (in nsec)
-	__u64 sched_deadline; ///> Field for SCHED_DEADLINE (in nsec)
-	__u64 sched_period; ///> Field for SCHED_DEADLINE (in nsec)
-};
-
-/**
- * @brief Creates an exec_info struct that will store job execution data.
- * @param job_number  An integer value that identifies a job during a program execution.
- * @param parameter A long integer value representing the parameter utilized for the job identified by the "job_number" parameter.
- * @param details A pointer to a string useful to store additional data about execution or job details. If no details
- * are needed, set this parameter to NULL.
- * @return A pointer to the newly created exec_info struct correctly initialized. This structure must be deallocated using
- * the "destroy_exec_info()" function when you're done with it.
-*/
-exec_info* create_exec_info(int job_number, long parameter, char* details);
-
-/**
- * @brief Frees up the memory allocated for the exec_info struct pointed by the "e_info" parameter.
- * @param e_info A pointer to an exec_info struct.
-*/
-void destroy_exec_info(exec_info* e_info);
-
-/**
- * @brief Sets a custom filter for an event in order to change the trace output based
- * on that filter.
- * @param subsystem A pointer to a string that specifies subsystem name of the event.
- * @param event A pointer to a string that specifies the event name.
- * @param filter_str A pointer to a string that specifies the filter value to use. If the RESET flag is used in
- * the "flag" parameter, this parameter could be NULL.
- * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to set
- * the filter and the RESET macro to reset it. 
-*/
-void set_event_filter_custom(const char* subsystem, const char* event, const char* filter_str, short flag);
-
-/**
- * @brief Sets a default filter predefined in the library for an event specified by the "event_flag" parameter,
- * in order to change the trace output based on that filter.
- * @param pid The pid of the process used to filter events related to that process.
- * @param event_flag A short integer value indicating the event type. Possible values can be: E_SCHED_SWITCH, 
- * E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
- * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to 
- * set the filter and the RESET macro to reset it. 
-*/
-void set_event_filter(pid_t pid, short event_flag, short flag);
-
-/**
- * @brief Allows specifying scheduler priority and policy of a process identified by the "pid" parameter.
- * @param pid The pid of the process whose scheduling policy and priority we want to change.
- * @param policy An integer value that specifies the scheduling policy, as one of the 
- * following SCHED_* values: SCHED_OTHER, SCHED_FIFO, SCHED_RR, SCHED_BATCH and SCHED_IDLE.
- * @param priority An integer value that specifies the static priority to be set when specifying sched_policy as SCHED_FIFO
- * or SCHED_RR. The allowed range of priorities for these policies is between 1 (low priority) and 99 
- * (high priority). For other policies, this field must be specified as 0.
- * @param e_info A pointer to an exec_info struct. It is used to update the "sched_policy" and "sched_priority" fields of
- * the exec_info struct according to the specified parameters. If it is set to NULL, the function will ignore this parameter.
-*/
-void set_scheduler_policy(pid_t pid, __u32 policy, __u32 priority, exec_info* e_info);
-
-/**
- * @brief Allows to retrieve the scheduling policy and attributes of the scheduler for the specified process.
- * @param pid The pid of the process whose scheduling policy and scheduling attributes we want to retrieve.
- * @return A pointer to a newly created sched_attr struct containing all scheduler data retrived. This structure
- * must be freed after you're done with it.
-*/
-struct sched_attr* get_scheduler_attr(pid_t pid);
-
-/**
- * @brief Allows to enable or disable the recording of all events contained in the specified subsystem.
- * @param subsystem A pointer to a string that specifies subsystem name.
- * @param op A short integer value that can be the macros DISABLE or ENABLE and it will disable or enable the
- * recording of all subsystem event respectively.
-*/
-void event_record_subsystem(const char* subsystem, short op);
-
-/**
- * @brief Allows to enable or disable the recording of an event contained in the specified subsystem.
- * @param subsystem A pointer to a string that specifies subsystem name of the event.
- * @param event A pointer to a string that specifies the event's name. Set it to NULL if you want to use a default 
- * filter.
- * @param op A short integer value that can be the macros DISABLE or ENABLE and it will disable or enable the event 
- * recording respectively.
-*/
-void event_record_custom(const char* subsystem, const char* event, short op);
-
-/**
- * @brief Allows to enable or disable the recording of some specific event defined in the library.
- * @param event_flag A short value indicating the event and it's used to enable or disable the recording of that event
- * in the kernel trace. Possible values can be: E_SCHED_SWITCH, E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
- * @param op A short value that can be the macros DISABLE or ENABLE and it will disable or enable the event recording respectively.
-*/
-void event_record(short event_flag, short op);
-
-/**
- * @brief Writes the beginning or the end of a job, identified by the "job_number" parameter,
- * on the kernel trace.
- * @param job_number An integer value that identifies a job during a program execution.
- * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
- * The START flag is used to mark the beginning of the job identified by the "job_number" parameter. The STOP flag
- * is used to mark the end of the job identified by the "job_number" parameter.
-*/
-void trace_mark_job(int job_number, short flag);
-
-/**
- * @brief Saves the job execution information to a specific file within a specified directory.
- * @param dir_path The path to a directory where to save various job executions and trace results. It will create a subfolder in this path
- * specific to this execution (if it doesn't already exist), and then it will create or update the "exec.txt" file by appending an new entry of 
- * the current job execution information. The "dir_path" parameter must be the same as the one provided in the "log_trace()" in order to save
- * job execution information along with its kernel trace.
- * @param identifier The user-defined string that identifies the program execution. It can be obtained by calling the "generate_execution_identifier"
- * function. It should match the identifier field contained in the struct pointed by the "info" parameter, if that field exists in the struct.
- * @param info A pointer to a user-defined struct that contains information about an execution. It can also be a default exec_info struct. The 
- * default structure exec_info has the following predefined fields related to the execution: "id", "job_number", "parameter", "details", 
- * "sched_policy" and "sched_priority". To desire the use of the default struct, allocate that structure and pass a pointer to that structure.
- * @param info_to_str A user-defined function that allows to create a comma separeted string based on the fields contained in the struct pointed 
- * by "info" parameter. If the "info" parameter is pointer to an exec_info struct, set this parameter to NULL.
- * @param flag A short integer value used to specify whether the interal library structure exec_info is being used to store job data or if 
- * a user-defined structure is being used for this purpose. To specify the first behavior, set the value of this 
- * parameter to DEFAULT_INFO and pass an exec_info struct in "info" parameter. To specify the second behavior, set the value of this parameter
- * to USER_INFO and pass your defined structure and function in "info" and "info_to_str" parameters respectively.
-*/
-void log_execution_info(const char* dir_path, const char* identifier, void* info, char* (*info_to_str)(void*), short flag);
-
-/**
- * @brief Saves the kernel trace to a specific file within a specified directory.
- * @param dir_path The path to a directory where to save various job executions and trace results. It will create a subfolder in this path
- * specific to this execution (if it doesn't already exist), and then it will create the "trace.txt" file which contains the kernel trace of
- * this program execution. The "dir_path" parameter must be the same as the one provided in the "log_execution_info()" in order to save
- * the kernel trace along with its jobs execution information.
- * @param identifier The user-defined string that identifies the program execution. It can be obtained by calling
- * the "generate_execution_identifier()" function. It should match the identifier provided in the "log_execution_info()"
- * during this program execution.
- * @param mode A short integer value that allows you to specify whether to use the trace_pipe or trace file of the tracefs to obtain kernel 
- * trace. To desire the first behaviour set this parameter to USE_TRACE_PIPE, to desire the second behaviour set this
- * parameter to USE_TRACE
-*/
-void log_trace(const char* dir_path, char* identifier, short mode);
-
-/**
- * @brief Writes a string to the specified file within the tracing infrastructure directory.
- * @param file_path The path to a file of the tracing infrastructure file.
- * @param str A pointer to a string that will be written to the file located in the path specified by 
- * "file_path" parameter.
-*/
-void tracing_write(const char* file_path, const char* str);
-
-/**
- * @brief Generates an identifier based on the timestamp that can be used for the entire program execution.
- * @param reset A short integer value used to determine whether to create a new identifier or use the one previously created if it exists.
- * To obtain a new identifier use the value 1 for this parameter. To obtain the identifier previously created use the value 0 for this
- * parameter.
- * @return A pointer to a string identifier of the program execution. It must be freed after use.
-*/
-char* generate_execution_identifier(short reset);
-
-/**
- * @brief Structures and format the information contained within the exec_info struct into a comma separated string.
- * @param info A pointer to an exec_info struct.
- * @return A pointer to the comma separeted string containing all the fields of the exec_info struct.
-*/
-char* exec_info_to_str(void* info);
-
+#ifndef EVENT_TRACING_H_
+#define EVENT_TRACING_H_
+
+#include <linux/types.h>
+
+#define E_SCHED_SWITCH 1 ///>Macro used to refer to the sched_swtich event.
+#define E_SCHED_WAKEUP 2 ///>Macro used to refer to the sched_wakeup event.
+#define E_SCHED_MIGRATE_TASK 3 ///>Macro used to refer to the sched_migrate_task event.
+#define N_EVENTS 3 ///>Number of events predefined in the library. Used to size the arrays of the tracing_session struct.
+
+#define DISABLE 0	///>Macro used in event_record(), event_record_custom() and event_record_subsystem() to disable the record of one or all events.
+#define ENABLE 1 	///>Macro used in event_record(), event_record_custom() and event_record_subsystem() to enable the record of one or all events.
+
+#define STOP 0		///>Macro used in trace_mark_job() to trace mark the end of a job.
+#define START 1		///>Macro used in trace_mark_job() to trace mark the beginning of a job.
+
+#define RAW_MARKER_ID 0x4a4f4221 ///>Identifier written as first field of every raw_job_marker record, used to recognize job markers among the raw data of the kernel trace.
+
+#define SET 0			///>Macro used in set_event_filter() and set_event_filter_custom() to set the filter provided as a parameter.
+#define RESET 1		///>Macro used in set_event_filter() and set_event_filter_custom() to reset/clear the filter.
+
+#define DEFAULT_INFO 0	///>Macro used in log_execution_info() to specify that a user-defined struct is being used.
+#define USER_INFO 1			///>Macro used in log_execution_info() to specify that the default exec_info struct is being used.
+
+#define USE_TRACE_PIPE 0	///>Macro used in log_trace() to specify that the kernel trace will be read using /sys/kernel/tracing/trace_pipe.
+#define USE_TRACE 1				///>Macro used in log_trace() to specify that the kernel trace will be read using /sys/kernel/tracing/trace.
+#define USE_TRACE_RAW 2		///>Macro used in log_trace() to specify that the kernel trace will be moved in binary form from /sys/kernel/tracing/per_cpu/cpuN/trace_pipe_raw.
+#define USE_TRACE_CONTAINER 3	///>Macro used in log_trace() to specify that the kernel trace will be saved as a binary trace container with a job index (see "trace_container.h").
+
+#define SCHED_OTHER 0			///>Non-real-time scheduling policy.
+#define SCHED_FIFO 1			///>Real-time scheduling policy.
+#define SCHED_RR 2				///>Real-time scheduling policy. 
+#define SCHED_BATCH 3			///>Non-real-time scheduling policy.
+#define SCHED_IDLE 5			///>Non-real-time scheduling policy.
+#define SCHED_DEADLINE 6	///>Deadline scheduling policy.
+
+#define SCHED_FLAG_RESET_ON_FORK 0x01	///>Flag of sched_setattr() used to make the children of a process use the default policy.
+#define SCHED_FLAG_RECLAIM 0x02				///>Flag of sched_setattr() used to let a SCHED_DEADLINE task reclaim the bandwidth left unused by the others.
+#define SCHED_FLAG_DL_OVERRUN 0x04		///>Flag of sched_setattr() used to send SIGXCPU to a SCHED_DEADLINE task whenever it overruns its runtime.
+#define SCHED_DL_MIN_RUNTIME 1024			///>Smallest runtime in nanoseconds accepted by the kernel for a SCHED_DEADLINE task.
+
+#define BUFFER_SIZE_KB 1408 ///>Default ring buffer size of the tracing infrastrucuture expressed in KB.
+
+#define TRACING_PATH "/sys/kernel/tracing" ///>Path to the root directory of the tracefs.
+#define TRACING_INSTANCES_PATH "/sys/kernel/tracing/instances" ///>Path to the directory of the tracefs where the private instances are created.
+#define TRACING_ON_PATH "/sys/kernel/tracing/tracing_on" ///>Path to the tracing_on file of the tracefs.
+#define TRACE_MARKER_PATH "/sys/kernel/tracing/trace_marker" ///>Path to the trace_marker file of the tracefs.
+#define TRACE_MARKER_RAW_PATH "/sys/kernel/tracing/trace_marker_raw" ///>Path to the trace_marker_raw file of the tracefs.
+#define TRACE_PIPE_PATH "/sys/kernel/tracing/trace_pipe" ///>Path to the trace_pipe file of the tracefs.
+#define TRACE_PATH "/sys/kernel/tracing/trace" ///>Path to the trace file of the tracefs.
+#define BUFFER_SIZE_KB_PATH "/sys/kernel/tracing/buffer_size_kb" ///>Path to the buffer_size_kb file of the tracefs.
+#define EVENTS_PATH "/sys/kernel/tracing/events" ///>Path to the events directory of the tracefs.
+#define SCHED_SWITCH_FILTER_PATH "/sys/kernel/tracing/events/sched/sched_switch/filter" ///>Path to the filter file of the sched_switch event.
+#define SCHED_SWITCH_ENABLE_PATH "/sys/kernel/tracing/events/sched/sched_switch/enable" ///>Path to the enable file of the sched_switch event.
+#define SCHED_WAKEUP_FILTER_PATH "/sys/kernel/tracing/events/sched/sched_wakeup/filter" ///>Path to the filter file of the sched_wakeup event.
+#define SCHED_WAKEUP_ENABLE_PATH "/sys/kernel/tracing/events/sched/sched_wakeup/enable" ///>Path to the enable file of the sched_wakeup event.
+#define SCHED_MIGRATE_TASK_FILTER_PATH "/sys/kernel/tracing/events/sched/sched_migrate_task/filter" ///>Path to the filter file of the sched_migrate_task event.
+#define SCHED_MIGRATE_TASK_ENABLE_PATH "/sys/kernel/tracing/events/sched/sched_migrate_task/enable" ///>Path to the enable file of the sched_migrate_task event.
+
+#define MAX_IDENTIFIER_SIZE 20	///>Max length of an identifier generated using generate_execution_identifier() function.
+#define STR_BUFFER_SIZE 4096		///>Buffer size for reading and writing operations.
+#define MAX_EXEC_METRICS 32			///>Max number of extra metrics that can be attached to an exec_info struct with exec_info_set_metric().
+
+/**
+ * @brief Changes the ring buffer size used to store the kernel trace.
+ * @param str_buffer_kb A pointer to a string which represents the new number of kb of the ring buffer.
+*/
+#define SET_BUFFER_SIZE(str_buffer_kb)	if(str_buffer_kb != NULL) { \
+																					tracing_write(BUFFER_SIZE_KB_PATH, str_buffer_kb);\
+																				}
+
+/**
+ * @brief Cleans the kernel trace file located in /sys/kernel/tracing/trace.
+*/
+#define CLEAN_TRACE if(system("echo 0 > /sys/kernel/tracing/trace") == -1) { \
+     	 								fprintf(stderr, "log_trace: error cleaning the \"%s\" file. Aborting ...\n", TRACE_PATH); \
+      								exit(EXIT_FAILURE); \
+    								}
+
+/**
+ * @brief Allows to enable the tracing infrastructure in order to effectively use the others functions in the library.
+*/
+#define ENABLE_TRACING tracing_write(TRACING_ON_PATH, "1"); \
+											 CLEAN_TRACE
+
+/**
+ * @brief Allows to disable the tracing infrastructure that was previously enabled.
+*/
+#define DISABLE_TRACING tracing_write(TRACING_ON_PATH, "0");
+
+/**
+ * @brief Writes to the kernel trace a string passed as parameter.
+ * @param str A pointer to a the string to be written to the kernel trace.
+*/
+#define TRACE_MARK(str) tracing_write(TRACE_MARKER_PATH, str); 
+
+/**
+ * @brief Allows to enable the tracing infrastructure using the file descriptors kept open by a tracing_session struct.
+ * @param session A pointer to a tracing_session struct created with the "create_tracing_session()" function.
+*/
+#define ENABLE_TRACING_SESSION(session) tracing_write_fd((session)->tracing_on_fd, "1"); \
+																				clean_trace_session(session);
+
+/**
+ * @brief Allows to disable the tracing infrastructure using the file descriptors kept open by a tracing_session struct.
+ * @param session A pointer to a tracing_session struct created with the "create_tracing_session()" function.
+*/
+#define DISABLE_TRACING_SESSION(session) tracing_write_fd((session)->tracing_on_fd, "0");
+
+/**
+ * @brief Changes the ring buffer size using the file descriptors kept open by a tracing_session struct.
+ * @param session A pointer to a tracing_session struct created with the "create_tracing_session()" function.
+ * @param str_buffer_kb A pointer to a string which represents the new number of kb of the ring buffer.
+*/
+#define SET_BUFFER_SIZE_SESSION(session, str_buffer_kb)	if(str_buffer_kb != NULL) { \
+																													tracing_write_fd((session)->buffer_size_kb_fd, str_buffer_kb);\
+																												}
+
+/**
+ * @brief Writes to the kernel trace a string passed as parameter using the trace_marker file descriptor kept open by a
+ * tracing_session struct.
+ * @param session A pointer to a tracing_session struct created with the "create_tracing_session()" function.
+ * @param str A pointer to a the string to be written to the kernel trace.
+*/
+#define TRACE_MARK_SESSION(session, str) tracing_write_fd((session)->trace_marker_fd, str);
+
+/**
+ * @brief Prints out on stderror the string associated to the errno value.
+*/
+#define PRINT_ERROR fprintf(stderr, "%s:%d: Error %d \"%s\"\n", __FILE__, __LINE__, errno, strerror(errno));
+
+/**
+ * @brief A named value measured for a job, such as a hardware counter, that is logged after the default fields of an exec_info struct.
+*/
+typedef struct exec_metric{
+	const char* name; ///> The name of the metric. It must not contain commas, spaces or '=' characters, and it is not copied.
+	long long value; ///> The value of the metric.
+} exec_metric;
+
+/**
+ * @brief A structure that contains information that characterizes the job execution. This
+ * is a default structure that can be used by the user, or the user can define their own structure
+ * to store different job execution data.
+*/
+typedef struct exec_info{
+  char* id;	///> The program execution identifier.
+  int job_number; ///> A number that identifies the job in this execution.
+  long parameter; ///> The value of the parameter used for this job.
+	char* sched_policy; ///> The scheduling policy used for this job.
+	int sched_priority; ///> The scheduling priority used for this job.
+	char* details; ///> Additional details that the user can provide as a string.
+	int n_metrics; ///> Number of extra metrics set for this job.
+	exec_metric metrics[MAX_EXEC_METRICS]; ///> Extra metrics of this job, logged as "name=value" fields after the default ones.
+} exec_info;
+
+/**
+ * @brief A structure that keeps open, for the whole program execution, the tracefs files used by the library. In this way
+ * every operation on the tracing infrastructure costs a single write() on a cached file descriptor instead of an
+ * open()/write()/close() sequence. The arrays of event files are indexed by the event flag minus one (e.g. E_SCHED_SWITCH - 1).
+*/
+typedef struct tracing_session{
+	char* tracing_path; ///> The path to the root directory of the tracefs used by this session.
+	int tracing_on_fd; ///> File descriptor of the tracing_on file.
+	int trace_marker_fd; ///> File descriptor of the trace_marker file.
+	int trace_marker_raw_fd; ///> File descriptor of the trace_marker_raw file. It is -1 if the kernel doesn't provide that file.
+	int buffer_size_kb_fd; ///> File descriptor of the buffer_size_kb file.
+	int enable_fd[N_EVENTS]; ///> File descriptors of the enable files of the events predefined in the library.
+	int filter_fd[N_EVENTS]; ///> File descriptors of the filter files of the events predefined in the library.
+	short is_instance; ///> 1 if the session uses a private instance created by "create_instance_session()", 0 otherwise.
+} tracing_session;
+
+/**
+ * @brief A fixed-size binary record written to the trace_marker_raw file to mark the beginning or the end of a job.
+ * It avoids any string formatting in the job hot path and it can be decoded offline without regular expressions.
+ * The kernel requires the first field to be an unsigned integer identifier.
+*/
+typedef struct raw_job_marker{
+	__u32 id; ///> Always RAW_MARKER_ID.
+	__s32 job_number; ///> A number that identifies the job in this execution.
+	__u32 state; ///> START or STOP.
+	__u32 worker; ///> The worker that runs the job, or 0 if the jobs run one after another. It keeps the "payload" field aligned to 8 bytes.
+	__s64 payload; ///> An optional user-defined value, such as the parameter used for the job.
+} raw_job_marker;
+
+/**
+ * @brief A redefinition of a structure of the linux kernel that serves to set or to retrieve the scheduler
+ * attributes and scheduling policy related to a thread.
+*/
+ struct sched_attr {
+	__u32 size;	///> Size in bytes of this structure
+	__u32 sched_policy;	///> Policy (SCHED_*)
+	__u64 sched_flags; ///> Flags
+	__s32 sched_nice; ///> Nice value (SCHED_OTHER, SCHED_BATCH)
+	__u32 sched_priority; ///> Static priority (SCHED_FIFO, SCHED_RR)
+	__u64 sched_runtime; ///> Field for SCHED_DEADLINE (in nsec)
+	__u64 sched_deadline; ///> Field for SCHED_DEADLINE (in nsec)
+	__u64 sched_period; ///> Field for SCHED_DEADLINE (in nsec)
+};
+
+/**
+ * @brief Creates an exec_info struct that will store job execution data.
+ * @param job_number  An integer value that identifies a job during a program execution.
+ * @param parameter A long integer value representing the parameter utilized for the job identified by the "job_number" parameter.
+ * @param details A pointer to a string useful to store additional data about execution or job details. If no details
+ * are needed, set this parameter to NULL.
+ * @return A pointer to the newly created exec_info struct correctly initialized. This structure must be deallocated using
+ * the "destroy_exec_info()" function when you're done with it.
+*/
+exec_info* create_exec_info(int job_number, long parameter, char* details);
+
+/**
+ * @brief Frees up the memory allocated for the exec_info struct pointed by the "e_info" parameter.
+ * @param e_info A pointer to an exec_info struct.
+*/
+void destroy_exec_info(exec_info* e_info);
+
+/**
+ * @brief Sets the value of an extra metric of an exec_info struct, adding the metric if it isn't already set. The metrics keep
+ * their values across jobs until they are set again or removed with "exec_info_clear_metrics()".
+ * @param e_info A pointer to an exec_info struct.
+ * @param name A pointer to the name of the metric. The string is not copied, so it must outlive the struct, as a string literal does.
+ * @param value The value of the metric.
+*/
+void exec_info_set_metric(exec_info* e_info, const char* name, long long value);
+
+/**
+ * @brief Removes all the extra metrics of an exec_info struct.
+ * @param e_info A pointer to an exec_info struct.
+*/
+void exec_info_clear_metrics(exec_info* e_info);
+
+/**
+ * @brief Sets a custom filter for an event in order to change the trace output based
+ * on that filter.
+ * @param subsystem A pointer to a string that specifies subsystem name of the event.
+ * @param event A pointer to a string that specifies the event name.
+ * @param filter_str A pointer to a string that specifies the filter value to use. If the RESET flag is used in
+ * the "flag" parameter, this parameter could be NULL.
+ * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to set
+ * the filter and the RESET macro to reset it. 
+*/
+void set_event_filter_custom(const char* subsystem, const char* event, const char* filter_str, short flag);
+
+/**
+ * @brief Sets a default filter predefined in the library for an event specified by the "event_flag" parameter,
+ * in order to change the trace output based on that filter.
+ * @param pid The pid of the process used to filter events related to that process.
+ * @param event_flag A short integer value indicating the event type. Possible values can be: E_SCHED_SWITCH, 
+ * E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to 
+ * set the filter and the RESET macro to reset it. 
+*/
+void set_event_filter(pid_t pid, short event_flag, short flag);
+
+/**
+ * @brief Allows specifying scheduler priority and policy of a process identified by the "pid" parameter.
+ * @param pid The pid of the process whose scheduling policy and priority we want to change.
+ * @param policy An integer value that specifies the scheduling policy, as one of the 
+ * following SCHED_* values: SCHED_OTHER, SCHED_FIFO, SCHED_RR, SCHED_BATCH and SCHED_IDLE. The SCHED_DEADLINE policy
+ * needs a runtime, a deadline and a period, so it must be set with the "set_deadline_policy()" function.
+ * @param priority An integer value that specifies the static priority to be set when specifying sched_policy as SCHED_FIFO
+ * or SCHED_RR. The allowed range of priorities for these policies is between 1 (low priority) and 99 
+ * (high priority). For other policies, this field must be specified as 0.
+ * @param e_info A pointer to an exec_info struct. It is used to update the "sched_policy" and "sched_priority" fields of
+ * the exec_info struct according to the specified parameters. If it is set to NULL, the function will ignore this parameter.
+*/
+void set_scheduler_policy(pid_t pid, __u32 policy, __u32 priority, exec_info* e_info);
+
+/**
+ * @brief Allows to set the SCHED_DEADLINE policy for a process identified by the "pid" parameter. The process gets "runtime"
+ * nanoseconds of CPU time every "period" nanoseconds, to be used within "deadline" nanoseconds from the beginning of each period.
+ * The kernel admits the reservation only if 0 < runtime <= deadline <= period and the total bandwidth of the deadline tasks fits
+ * the CPUs, so this function aborts if the parameters are refused.
+ * @param pid The pid of the process whose scheduling policy we want to change. Set it to 0 in order to use the calling thread.
+ * @param runtime The runtime in nanoseconds. It must be at least 1024 nanoseconds.
+ * @param deadline The relative deadline in nanoseconds. Set it to 0 in order to use the period.
+ * @param period The period in nanoseconds. Set it to 0 in order to use the deadline.
+ * @param flags The SCHED_FLAG_* values ORed together, such as SCHED_FLAG_DL_OVERRUN to receive a SIGXCPU signal whenever the
+ * process overruns its runtime. Set it to 0 in order to use none of them.
+ * @param e_info A pointer to an exec_info struct. It is used to update the "sched_policy" and "sched_priority" fields of the
+ * exec_info struct, and to set its "dl_runtime", "dl_deadline" and "dl_period" extra metrics. If it is set to NULL, the
+ * function will ignore this parameter.
+*/
+void set_deadline_policy(pid_t pid, __u64 runtime, __u64 deadline, __u64 period, __u64 flags, exec_info* e_info);
+
+/**
+ * @brief Allows to retrieve the scheduling policy and attributes of the scheduler for the specified process.
+ * @param pid The pid of the process whose scheduling policy and scheduling attributes we want to retrieve.
+ * @return A pointer to a newly created sched_attr struct containing all scheduler data retrived. This structure
+ * must be freed after you're done with it.
+*/
+struct sched_attr* get_scheduler_attr(pid_t pid);
+
+/**
+ * @brief Allows to enable or disable the recording of all events contained in the specified subsystem.
+ * @param subsystem A pointer to a string that specifies subsystem name.
+ * @param op A short integer value that can be the macros DISABLE or ENABLE and it will disable or enable the
+ * recording of all subsystem event respectively.
+*/
+void event_record_subsystem(const char* subsystem, short op);
+
+/**
+ * @brief Allows to enable or disable the recording of an event contained in the specified subsystem.
+ * @param subsystem A pointer to a string that specifies subsystem name of the event.
+ * @param event A pointer to a string that specifies the event's name. Set it to NULL if you want to use a default 
+ * filter.
+ * @param op A short integer value that can be the macros DISABLE or ENABLE and it will disable or enable the event 
+ * recording respectively.
+*/
+void event_record_custom(const char* subsystem, const char* event, short op);
+
+/**
+ * @brief Allows to enable or disable the recording of some specific event defined in the library.
+ * @param event_flag A short value indicating the event and it's used to enable or disable the recording of that event
+ * in the kernel trace. Possible values can be: E_SCHED_SWITCH, E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param op A short value that can be the macros DISABLE or ENABLE and it will disable or enable the event recording respectively.
+*/
+void event_record(short event_flag, short op);
+
+/**
+ * @brief Checks once whether the tracefs can be used by the calling process, that is whether its trace_marker file is writable.
+ * It is not when the tracefs is not mounted or when the process doesn't have root privileges.
+ * @return 1 if the tracefs is available, 0 otherwise.
+*/
+short tracefs_available(void);
+
+/**
+ * @brief Writes the beginning or the end of a job, identified by the "job_number" parameter,
+ * on the kernel trace. If the tracefs is not available, the job is measured by the unprivileged backend of "light_metrics.h"
+ * instead, and its metrics are written by the next call to "log_execution_info()".
+ * @param job_number An integer value that identifies a job during a program execution.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+ * The START flag is used to mark the beginning of the job identified by the "job_number" parameter. The STOP flag
+ * is used to mark the end of the job identified by the "job_number" parameter.
+*/
+void trace_mark_job(int job_number, short flag);
+
+/**
+ * @brief Saves the job execution information to a specific file within a specified directory.
+ * @param dir_path The path to a directory where to save various job executions and trace results. It will create a subfolder in this path
+ * specific to this execution (if it doesn't already exist), and then it will create or update the "exec.txt" file by appending an new entry of 
+ * the current job execution information. The "dir_path" parameter must be the same as the one provided in the "log_trace()" in order to save
+ * job execution information along with its kernel trace.
+ * @param identifier The user-defined string that identifies the program execution. It can be obtained by calling the "generate_execution_identifier"
+ * function. It should match the identifier field contained in the struct pointed by the "info" parameter, if that field exists in the struct.
+ * @param info A pointer to a user-defined struct that contains information about an execution. It can also be a default exec_info struct. The 
+ * default structure exec_info has the following predefined fields related to the execution: "id", "job_number", "parameter", "details", 
+ * "sched_policy" and "sched_priority". To desire the use of the default struct, allocate that structure and pass a pointer to that structure.
+ * @param info_to_str A user-defined function that allows to create a comma separeted string based on the fields contained in the struct pointed 
+ * by "info" parameter. If the "info" parameter is pointer to an exec_info struct, set this parameter to NULL.
+ * @param flag A short integer value used to specify whether the interal library structure exec_info is being used to store job data or if 
+ * a user-defined structure is being used for this purpose. To specify the first behavior, set the value of this 
+ * parameter to DEFAULT_INFO and pass an exec_info struct in "info" parameter. To specify the second behavior, set the value of this parameter
+ * to USER_INFO and pass your defined structure and function in "info" and "info_to_str" parameters respectively.
+ * If the tracefs is not available, the metrics of the last job measured by "trace_mark_job()" are appended to the "metrics.txt" file too.
+*/
+void log_execution_info(const char* dir_path, const char* identifier, void* info, char* (*info_to_str)(void*), short flag);
+
+/**
+ * @brief Saves the kernel trace to a specific file within a specified directory.
+ * @param dir_path The path to a directory where to save various job executions and trace results. It will create a subfolder in this path
+ * specific to this execution (if it doesn't already exist), and then it will create the "trace.txt" file which contains the kernel trace of
+ * this program execution. The "dir_path" parameter must be the same as the one provided in the "log_execution_info()" in order to save
+ * the kernel trace along with its jobs execution information.
+ * @param identifier The user-defined string that identifies the program execution. It can be obtained by calling
+ * the "generate_execution_identifier()" function. It should match the identifier provided in the "log_execution_info()"
+ * during this program execution.
+ * @param mode A short integer value that allows you to specify whether to use the trace_pipe or trace file of the tracefs to obtain kernel 
+ * trace. To desire the first behaviour set this parameter to USE_TRACE_PIPE, to desire the second behaviour set this
+ * parameter to USE_TRACE. Set it to USE_TRACE_RAW to save instead the binary per-CPU traces in "trace_cpuN.raw" files, along
+ * with the format files needed to decode them with the functions of "raw_trace.h". Set it to USE_TRACE_CONTAINER to convert the
+ * binary per-CPU traces into the compact "trace.bin" container described in "trace_container.h". If the tracefs is not available
+ * there is no trace to save, and only the subfolder is created.
+*/
+void log_trace(const char* dir_path, char* identifier, short mode);
+
+/**
+ * @brief Writes a string to the specified file within the tracing infrastructure directory.
+ * @param file_path The path to a file of the tracing infrastructure file.
+ * @param str A pointer to a string that will be written to the file located in the path specified by 
+ * "file_path" parameter.
+*/
+void tracing_write(const char* file_path, const char* str);
+
+/**
+ * @brief Writes a string to a tracing infrastructure file already opened, such as the ones kept by a tracing_session struct.
+ * @param fd The file descriptor of a file of the tracing infrastructure opened in write mode.
+ * @param str A pointer to a string that will be written to the file referred by the "fd" parameter.
+*/
+void tracing_write_fd(int fd, const char* str);
+
+/**
+ * @brief Creates a tracing_session struct opening once all the tracefs files used by the library, that will be kept
+ * open until the "destroy_tracing_session()" function is called.
+ * @param tracing_path The path to the root directory of the tracefs. Set it to NULL in order to use the default one (TRACING_PATH).
+ * @return A pointer to the newly created tracing_session struct. This structure must be deallocated using the
+ * "destroy_tracing_session()" function when you're done with it.
+*/
+tracing_session* create_tracing_session(const char* tracing_path);
+
+/**
+ * @brief Creates a private instance of the tracefs (a subdirectory of TRACING_INSTANCES_PATH) and a tracing_session that uses it.
+ * The instance has its own ring buffer, tracing_on, trace_marker, event enable and filter files, so that concurrent executions
+ * that use different instances don't clobber each other's trace, filters or buffer size.
+ * @param instance_name The name of the instance, such as the execution identifier. An instance with the same name must not exist.
+ * @return A pointer to a newly created tracing_session struct. It must be deallocated using the "destroy_tracing_session()"
+ * function, which also removes the instance and its ring buffer.
+*/
+tracing_session* create_instance_session(const char* instance_name);
+
+/**
+ * @brief Closes all the files kept open by a tracing_session struct and frees up the memory allocated for it. If the session
+ * has been created by "create_instance_session()", the instance is removed too.
+ * @param session A pointer to a tracing_session struct.
+*/
+void destroy_tracing_session(tracing_session* session);
+
+/**
+ * @brief Same as "log_trace()", but it saves the kernel trace of the tracefs, or of the private instance, used by a tracing_session.
+ * @param session A pointer to a tracing_session struct.
+ * @param dir_path The path to a directory where to save various job executions and trace results.
+ * @param identifier The string that identifies the program execution.
+ * @param mode USE_TRACE_PIPE, USE_TRACE, USE_TRACE_RAW or USE_TRACE_CONTAINER, as in "log_trace()".
+*/
+void log_trace_session(tracing_session* session, const char* dir_path, const char* identifier, short mode);
+
+/**
+ * @brief Cleans the kernel trace of the tracefs used by the session, without spawning a shell as the CLEAN_TRACE macro does.
+ * @param session A pointer to a tracing_session struct.
+*/
+void clean_trace_session(tracing_session* session);
+
+/**
+ * @brief Same as "set_event_filter()", but it uses the filter file descriptors kept open by a tracing_session struct.
+ * @param session A pointer to a tracing_session struct.
+ * @param pid The pid of the process used to filter events related to that process.
+ * @param event_flag A short integer value indicating the event type. Possible values can be: E_SCHED_SWITCH, 
+ * E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to 
+ * set the filter and the RESET macro to reset it. 
+*/
+void set_event_filter_session(tracing_session* session, pid_t pid, short event_flag, short flag);
+
+/**
+ * @brief Same as "set_event_filter_session()", but the filter matches the events of any of the processes of a set, such as
+ * the workers that run the jobs of an execution concurrently.
+ * @param session A pointer to a tracing_session struct.
+ * @param pids A pointer to the array of the pids of the processes.
+ * @param n_pids The number of elements of the "pids" array. It must be positive.
+ * @param event_flag A short integer value indicating the event type. Possible values can be: E_SCHED_SWITCH,
+ * E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to
+ * set the filter and the RESET macro to reset it.
+*/
+void set_event_filter_pids_session(tracing_session* session, const pid_t* pids, int n_pids, short event_flag, short flag);
+
+/**
+ * @brief Same as "set_event_filter_pids_session()", but the filter matches the events of all the threads of a process, listed from
+ * the "/proc/<tgid>/task" directory. The threads created after the call are not matched, so it must be called again after creating them.
+ * @param session A pointer to a tracing_session struct.
+ * @param tgid The thread group id of the process, that is its pid.
+ * @param event_flag A short integer value indicating the event type. Possible values can be: E_SCHED_SWITCH,
+ * E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param flag A short integer value that specifies whether to set or reset the filter. Use the SET macro to
+ * set the filter and the RESET macro to reset it.
+ * @return The number of threads matched by the filter.
+*/
+int set_event_filter_tgid_session(tracing_session* session, pid_t tgid, short event_flag, short flag);
+
+/**
+ * @brief Same as "event_record()", but it uses the enable file descriptors kept open by a tracing_session struct.
+ * @param session A pointer to a tracing_session struct.
+ * @param event_flag A short value indicating the event. Possible values can be: E_SCHED_SWITCH, E_SCHED_WAKEUP and E_SCHED_MIGRATE_TASK.
+ * @param op A short value that can be the macros DISABLE or ENABLE and it will disable or enable the event recording respectively.
+*/
+void event_record_session(tracing_session* session, short event_flag, short op);
+
+/**
+ * @brief Same as "trace_mark_job()", but each marker costs a single write() on the trace_marker file descriptor kept
+ * open by a tracing_session struct.
+ * @param session A pointer to a tracing_session struct.
+ * @param job_number An integer value that identifies a job during a program execution.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+*/
+void trace_mark_job_session(tracing_session* session, int job_number, short flag);
+
+/**
+ * @brief Same as "trace_mark_job_session()", but the marker identifies the worker that runs the job too, as
+ * "start_job=<worker>:<job_number>" and "end_job=<worker>:<job_number>". It is used when several workers run their jobs
+ * concurrently, each one numbering its own jobs.
+ * @param session A pointer to a tracing_session struct.
+ * @param worker A positive integer value that identifies the worker.
+ * @param job_number An integer value that identifies a job of the worker.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+*/
+void trace_mark_worker_job_session(tracing_session* session, int worker, int job_number, short flag);
+
+/**
+ * @brief Same as "trace_mark_worker_job_session()", but the worker is the calling thread, identified by its tid, so that the threads
+ * of a process can mark their jobs concurrently, each one numbering its own jobs.
+ * @param session A pointer to a tracing_session struct.
+ * @param job_number An integer value that identifies a job of the calling thread.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+*/
+void trace_mark_thread_job_session(tracing_session* session, int job_number, short flag);
+
+/**
+ * @brief Same as "trace_mark_job_session()", but it writes a raw_job_marker binary record to the trace_marker_raw
+ * file instead of a formatted string to the trace_marker file.
+ * @param session A pointer to a tracing_session struct.
+ * @param job_number An integer value that identifies a job during a program execution.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+ * @param payload A long integer value stored along with the marker, such as the parameter used for the job. Set it to 0 if
+ * it is not needed.
+*/
+void trace_mark_job_raw_session(tracing_session* session, int job_number, short flag, long payload);
+
+/**
+ * @brief Same as "trace_mark_job_raw_session()", but the "worker" field of the raw_job_marker record identifies the worker
+ * that runs the job, as "trace_mark_worker_job_session()" does.
+ * @param session A pointer to a tracing_session struct.
+ * @param worker An integer value that identifies the worker, or 0 if the jobs are not run by concurrent workers.
+ * @param job_number An integer value that identifies a job of the worker.
+ * @param flag A short integer value that can be START or STOP based on what we want to mark on the kernel trace.
+ * @param payload A long integer value stored along with the marker, such as the parameter used for the job. Set it to 0 if
+ * it is not needed.
+*/
+void trace_mark_worker_job_raw_session(tracing_session* session, int worker, int job_number, short flag, long payload);
+
+/**
+ * @brief Creates, if they don't already exist, the directory where to save the results and its subfolder specific to
+ * the program execution.
+ * @param dir_path The path to a directory where to save various job executions and trace results.
+ * @param identifier The string that identifies the program execution, used as name of the subfolder.
+ * @return A pointer to a string containing the path of the subfolder. It must be freed after use.
+*/
+char* create_execution_directory(const char* dir_path, const char* identifier);
+
+/**
+ * @brief Generates an identifier based on the timestamp that can be used for the entire program execution. It can be called by several
+ * threads at the same time, since the identifier is shared by all of them and protected by a mutex.
+ * @param reset A short integer value used to determine whether to create a new identifier or use the one previously created if it exists.
+ * To obtain a new identifier use the value 1 for this parameter. To obtain the identifier previously created use the value 0 for this
+ * parameter.
+ * @return A pointer to a copy of the string identifier of the program execution, owned by the caller. It must be freed after use.
+*/
+char* generate_execution_identifier(short reset);
+
+/**
+ * @brief Structures and format the information contained within the exec_info struct into a comma separated string.
+ * @param info A pointer to an exec_info struct.
+ * @return A pointer to the comma separeted string containing all the fields of the exec_info struct.
+*/
+char* exec_info_to_str(void* info);
+
+/**
+ * @brief Formats the information contained within the exec_info struct into a comma separated line, using a buffer provided
+ * by the caller instead of allocating a new one. The extra metrics, if any, follow the default fields as "name=value" fields.
+ * @param str A pointer to the buffer where to write the line. It can be NULL if "size" is 0.
+ * @param size The size in bytes of the buffer.
+ * @param info A pointer to an exec_info struct.
+ * @return The length of the whole line, as returned by snprintf(). If it is greater than or equal to "size", the line has been
+ * truncated.
+*/
+int exec_info_format(char* str, size_t size, const exec_info* info);
+
 #endif
\ No newline at end of file
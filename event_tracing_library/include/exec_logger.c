@@ -0,0 +1,198 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "exec_logger.h"
+
+/**
+ * @brief Creates a logger for the execution information of the jobs of a program execution.
+ * @param dir_path The path to a directory where to save various job executions and trace results, the same provided to "log_trace()".
+ * The subfolder of the execution is created if it doesn't exist.
+ * @param identifier The string that identifies the program execution.
+ * @param format A short integer value. Set it to EXEC_LOG_TEXT in order to append comma separated lines to the "exec.txt" file,
+ * the same written by "log_execution_info()", or to EXEC_LOG_BINARY in order to append exec_info_record structs to the "exec.bin" file.
+ * @param flush_threshold The number of buffered bytes that triggers a write. Set it to 0 in order to write only when the buffer is
+ * full or when the logger is destroyed.
+ * @return A pointer to a newly created exec_logger struct. This structure must be deallocated using the "destroy_exec_logger()"
+ * function, which also writes the buffered records.
+*/
+exec_logger* create_exec_logger(const char* dir_path, const char* identifier, short format, size_t flush_threshold){
+  exec_logger* logger;
+  char* dir_file_path;
+  const char* file_name;
+
+  if(format != EXEC_LOG_TEXT && format != EXEC_LOG_BINARY){
+    fprintf(stderr, "create_exec_logger: invalid format. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  file_name = format == EXEC_LOG_TEXT ? EXEC_TEXT_FILENAME : EXEC_BINARY_FILENAME;
+
+  logger = (exec_logger*)calloc(1, sizeof(*logger));
+  if(logger == NULL){
+    fprintf(stderr, "create_exec_logger: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  logger->format = format;
+  logger->flush_threshold = flush_threshold == 0 || flush_threshold > EXEC_LOGGER_BUFFER_SIZE ? EXEC_LOGGER_BUFFER_SIZE : flush_threshold;
+  logger->buffer = (char*)malloc(EXEC_LOGGER_BUFFER_SIZE);
+
+  dir_file_path = create_execution_directory(dir_path, identifier);
+  logger->file_path = (char*)calloc(strlen(dir_file_path) + 1 + strlen(file_name) + 1, sizeof(char));
+  if(logger->buffer == NULL || logger->file_path == NULL){
+    fprintf(stderr, "create_exec_logger: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  sprintf(logger->file_path, "%s/%s", dir_file_path, file_name);
+  free(dir_file_path);
+
+  logger->fd = open(logger->file_path, O_WRONLY | O_CREAT | O_APPEND, 0777);
+  if(logger->fd == -1){
+    fprintf(stderr, "create_exec_logger: error opening \"%s\" file. Aborting ...\n", logger->file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  return logger;
+}
+
+/**
+ * @brief Writes all the buffered records to the output file.
+ * @param logger A pointer to an exec_logger struct.
+*/
+void exec_logger_flush(exec_logger* logger){
+  size_t offset = 0;
+  ssize_t bytes_written;
+
+  while(offset < logger->used){
+    bytes_written = write(logger->fd, logger->buffer + offset, logger->used - offset);
+    if(bytes_written == -1 && errno == EINTR)
+      continue;
+    if(bytes_written <= 0){
+      fprintf(stderr, "exec_logger_flush: error writing to \"%s\" file. Aborting ...\n", logger->file_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    offset += bytes_written;
+  }
+  logger->used = 0;
+}
+
+/**
+ * @brief Accounts a record just written at the end of the buffer, writing the buffer if the flush threshold has been reached.
+ * @param logger A pointer to an exec_logger struct.
+ * @param size The size in bytes of the record.
+*/
+static void commit_record(exec_logger* logger, size_t size){
+  logger->used += size;
+  logger->records++;
+  if(logger->used >= logger->flush_threshold)
+    exec_logger_flush(logger);
+}
+
+/**
+ * @brief Copies a string into a fixed-size field of an exec_info_record struct, truncating it if needed.
+ * @param dst A pointer to the field.
+ * @param size The size in bytes of the field.
+ * @param src A pointer to the string to copy. It can be NULL.
+*/
+static void copy_record_string(char* dst, size_t size, const char* src){
+  if(src != NULL){
+    strncpy(dst, src, size - 1);
+  }
+}
+
+/**
+ * @brief Adapts "exec_info_format()" to the signature of the user-defined formatting functions.
+ * @param str A pointer to the buffer where to write the line.
+ * @param size The size in bytes of the buffer.
+ * @param info A pointer to an exec_info struct.
+ * @return The length of the whole line.
+*/
+static int format_default_info(char* str, size_t size, void* info){
+  return exec_info_format(str, size, (const exec_info*)info);
+}
+
+/**
+ * @brief Buffers the execution information of a job. No memory is allocated and the file is written only if the flush threshold
+ * is reached.
+ * @param logger A pointer to an exec_logger struct.
+ * @param info A pointer to an exec_info struct.
+*/
+void exec_logger_log(exec_logger* logger, const exec_info* info){
+  exec_info_record* record;
+  exec_metric_record* metric;
+  size_t size;
+
+  if(logger->format == EXEC_LOG_TEXT){
+    exec_logger_log_custom(logger, (void*)info, format_default_info);
+    return;
+  }
+
+  size = sizeof(*record) + info->n_metrics * sizeof(*metric);
+  if(EXEC_LOGGER_BUFFER_SIZE - logger->used < size)
+    exec_logger_flush(logger);
+  record = (exec_info_record*)(logger->buffer + logger->used);
+  bzero(record, size);
+  copy_record_string(record->id, sizeof(record->id), info->id);
+  record->job_number = info->job_number;
+  record->sched_priority = info->sched_priority;
+  record->parameter = info->parameter;
+  copy_record_string(record->sched_policy, sizeof(record->sched_policy), info->sched_policy);
+  copy_record_string(record->details, sizeof(record->details), info->details);
+  record->n_metrics = info->n_metrics;
+  metric = (exec_metric_record*)(record + 1);
+  for(int i = 0; i < info->n_metrics; i++, metric++){
+    copy_record_string(metric->name, sizeof(metric->name), info->metrics[i].name);
+    metric->value = info->metrics[i].value;
+  }
+  commit_record(logger, size);
+}
+
+/**
+ * @brief Buffers the execution information of a job stored in a user-defined struct. It can be used only with the EXEC_LOG_TEXT format.
+ * @param logger A pointer to an exec_logger struct.
+ * @param info A pointer to a user-defined struct that contains information about a job.
+ * @param info_format A user-defined function that writes a line based on the fields of the struct pointed by "info" into the buffer
+ * "str" of "size" bytes, and returns the length of the whole line as snprintf() does.
+*/
+void exec_logger_log_custom(exec_logger* logger, void* info, int (*info_format)(char* str, size_t size, void* info)){
+  int len;
+
+  if(logger->format != EXEC_LOG_TEXT){
+    fprintf(stderr, "exec_logger_log_custom: a user-defined struct can't be logged in binary format. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  len = info_format(logger->buffer + logger->used, EXEC_LOGGER_BUFFER_SIZE - logger->used, info);
+  if(len >= 0 && (size_t)len >= EXEC_LOGGER_BUFFER_SIZE - logger->used && logger->used > 0){
+    // The line doesn't fit the space left: it is formatted again at the beginning of the buffer
+    exec_logger_flush(logger);
+    len = info_format(logger->buffer, EXEC_LOGGER_BUFFER_SIZE, info);
+  }
+  if(len < 0 || len >= EXEC_LOGGER_BUFFER_SIZE){
+    fprintf(stderr, "exec_logger_log_custom: error formatting the execution information. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  commit_record(logger, len);
+}
+
+/**
+ * @brief Writes the buffered records, closes the output file and frees up the memory allocated for an exec_logger struct.
+ * @param logger A pointer to an exec_logger struct.
+ * @return The number of records logged.
+*/
+unsigned long destroy_exec_logger(exec_logger* logger){
+  unsigned long records = logger->records;
+
+  exec_logger_flush(logger);
+  close(logger->fd);
+  free(logger->file_path);
+  free(logger->buffer);
+  free(logger);
+  return records;
+}
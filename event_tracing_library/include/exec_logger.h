@@ -0,0 +1,103 @@
+#ifndef EXEC_LOGGER_H_
+#define EXEC_LOGGER_H_
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+
+#define EXEC_LOG_TEXT 0		///>Macro used in create_exec_logger() to write the comma separated lines of the "exec.txt" file.
+#define EXEC_LOG_BINARY 1	///>Macro used in create_exec_logger() to write the fixed-width exec_info_record structs of the "exec.bin" file.
+
+#define EXEC_TEXT_FILENAME "exec.txt"		///>Name of the file, within an execution directory, that contains the execution information as text.
+#define EXEC_BINARY_FILENAME "exec.bin"	///>Name of the file, within an execution directory, that contains the execution information as exec_info_record structs.
+#define EXEC_LOGGER_BUFFER_SIZE 65536		///>Size of the buffer where an exec_logger accumulates the records before writing them.
+
+#define EXEC_RECORD_ID_SIZE 24			///>Size of the "id" field of an exec_info_record struct. It must be greater than MAX_IDENTIFIER_SIZE.
+#define EXEC_RECORD_POLICY_SIZE 16	///>Size of the "sched_policy" field of an exec_info_record struct.
+#define EXEC_RECORD_DETAILS_SIZE 32	///>Size of the "details" field of an exec_info_record struct.
+#define EXEC_METRIC_NAME_SIZE 24		///>Size of the "name" field of an exec_metric_record struct.
+
+/**
+ * @brief The fixed-width binary form of an exec_info struct, written to the "exec.bin" file. The strings are terminated and padded
+ * with zeros, and they are truncated if they don't fit their field. Each record is followed by "n_metrics" exec_metric_record structs.
+*/
+typedef struct exec_info_record{
+	char id[EXEC_RECORD_ID_SIZE]; ///> The program execution identifier.
+	__s32 job_number; ///> A number that identifies the job in this execution.
+	__s32 sched_priority; ///> The scheduling priority used for this job.
+	__s64 parameter; ///> The value of the parameter used for this job.
+	char sched_policy[EXEC_RECORD_POLICY_SIZE]; ///> The scheduling policy used for this job.
+	char details[EXEC_RECORD_DETAILS_SIZE]; ///> Additional details provided by the user.
+	__u32 n_metrics; ///> Number of exec_metric_record structs that follow this record.
+	__u32 reserved; ///> Unused, always 0. It keeps the size of the record a multiple of 8 bytes.
+} exec_info_record;
+
+/**
+ * @brief The fixed-width binary form of an extra metric of an exec_info struct, written to the "exec.bin" file after its exec_info_record.
+*/
+typedef struct exec_metric_record{
+	char name[EXEC_METRIC_NAME_SIZE]; ///> The name of the metric.
+	__s64 value; ///> The value of the metric.
+} exec_metric_record;
+
+/**
+ * @brief A structure that logs the execution information of each job without allocating memory nor touching the file system
+ * between two jobs. The execution directory is resolved and the file is opened once, the records are formatted into a
+ * preallocated buffer and they are written in batches, when the buffer reaches a threshold or when the logger is destroyed.
+*/
+typedef struct exec_logger{
+	int fd; ///> File descriptor of the output file, opened in append mode.
+	short format; ///> EXEC_LOG_TEXT or EXEC_LOG_BINARY.
+	char* file_path; ///> The path to the output file, used for error messages.
+	char* buffer; ///> The buffer of EXEC_LOGGER_BUFFER_SIZE bytes where the records are accumulated.
+	size_t used; ///> Number of bytes of the buffer not yet written.
+	size_t flush_threshold; ///> Number of bytes that triggers a write of the buffer.
+	unsigned long records; ///> Number of records logged.
+} exec_logger;
+
+/**
+ * @brief Creates a logger for the execution information of the jobs of a program execution.
+ * @param dir_path The path to a directory where to save various job executions and trace results, the same provided to "log_trace()".
+ * The subfolder of the execution is created if it doesn't exist.
+ * @param identifier The string that identifies the program execution.
+ * @param format A short integer value. Set it to EXEC_LOG_TEXT in order to append comma separated lines to the "exec.txt" file,
+ * the same written by "log_execution_info()", or to EXEC_LOG_BINARY in order to append exec_info_record structs to the "exec.bin" file.
+ * @param flush_threshold The number of buffered bytes that triggers a write. Set it to 0 in order to write only when the buffer is
+ * full or when the logger is destroyed.
+ * @return A pointer to a newly created exec_logger struct. This structure must be deallocated using the "destroy_exec_logger()"
+ * function, which also writes the buffered records.
+*/
+exec_logger* create_exec_logger(const char* dir_path, const char* identifier, short format, size_t flush_threshold);
+
+/**
+ * @brief Buffers the execution information of a job. No memory is allocated and the file is written only if the flush threshold
+ * is reached.
+ * @param logger A pointer to an exec_logger struct.
+ * @param info A pointer to an exec_info struct.
+*/
+void exec_logger_log(exec_logger* logger, const exec_info* info);
+
+/**
+ * @brief Buffers the execution information of a job stored in a user-defined struct. It can be used only with the EXEC_LOG_TEXT format.
+ * @param logger A pointer to an exec_logger struct.
+ * @param info A pointer to a user-defined struct that contains information about a job.
+ * @param info_format A user-defined function that writes a line based on the fields of the struct pointed by "info" into the buffer
+ * "str" of "size" bytes, and returns the length of the whole line as snprintf() does.
+*/
+void exec_logger_log_custom(exec_logger* logger, void* info, int (*info_format)(char* str, size_t size, void* info));
+
+/**
+ * @brief Writes all the buffered records to the output file.
+ * @param logger A pointer to an exec_logger struct.
+*/
+void exec_logger_flush(exec_logger* logger);
+
+/**
+ * @brief Writes the buffered records, closes the output file and frees up the memory allocated for an exec_logger struct.
+ * @param logger A pointer to an exec_logger struct.
+ * @return The number of records logged.
+*/
+unsigned long destroy_exec_logger(exec_logger* logger);
+
+#endif
@@ -0,0 +1,304 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "hist_aggregation.h"
+
+/**
+ * @brief Builds a string with a printf-like format, aborting if the memory can't be allocated.
+ * @param format The format of the string.
+ * @return A pointer to the newly allocated string.
+*/
+static char* format_string(const char* format, ...){
+  va_list args;
+  char* str;
+  int len;
+
+  va_start(args, format);
+  len = vasprintf(&str, format, args);
+  va_end(args);
+  if(len == -1){
+    fprintf(stderr, "create_hist_aggregation: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  return str;
+}
+
+/**
+ * @brief Opens a file of an event directory of the tracefs used by a hist_aggregation struct.
+ * @param aggregation A pointer to a hist_aggregation struct whose "tracing_path" field is already set.
+ * @param event The event directory relative to the "events" directory, such as "sched/sched_switch".
+ * @param file_name The name of the file, "trigger" or "hist".
+ * @param flags The flags used to open the file.
+ * @return The file descriptor of the opened file.
+*/
+static int open_event_file(hist_aggregation* aggregation, const char* event, const char* file_name, int flags){
+  char file_path[PATH_MAX];
+  int fd;
+
+  snprintf(file_path, PATH_MAX, "%s/events/%s/%s", aggregation->tracing_path, event, file_name);
+  fd = open(file_path, flags);
+  if(fd == -1){
+    fprintf(stderr, "create_hist_aggregation: error opening \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  return fd;
+}
+
+/**
+ * @brief Writes a command for a hist trigger, made of its spec, an optional suffix such as ":clear" and its filter.
+ * @param aggregation A pointer to a hist_aggregation struct.
+ * @param index The index of the hist trigger.
+ * @param prefix A string written before the spec, such as "!" to remove the trigger.
+ * @param suffix A string written after the spec, such as ":clear" to clear the histogram.
+*/
+static void write_trigger(hist_aggregation* aggregation, int index, const char* prefix, const char* suffix){
+  char command[STR_BUFFER_SIZE];
+
+  if(aggregation->filters[index] != NULL)
+    snprintf(command, STR_BUFFER_SIZE, "%s%s%s if %s", prefix, aggregation->specs[index], suffix, aggregation->filters[index]);
+  else
+    snprintf(command, STR_BUFFER_SIZE, "%s%s%s", prefix, aggregation->specs[index], suffix);
+  tracing_write_fd(aggregation->trigger_fd[index], command);
+}
+
+/**
+ * @brief Defines the synthetic event and installs the hist triggers on the sched_switch and sched_migrate_task events of the tracefs
+ * used by a tracing_session, filtered by the pid of a task.
+ * @param session A pointer to a tracing_session struct. Its tracefs, or its instance, keeps the histograms.
+ * @param pid The pid of the task to aggregate. Set it to 0 in order to use the calling thread.
+ * @return A pointer to a newly created hist_aggregation struct. This structure must be deallocated using the
+ * "destroy_hist_aggregation()" function, which also removes the triggers and the synthetic event.
+*/
+hist_aggregation* create_hist_aggregation(tracing_session* session, pid_t pid){
+  hist_aggregation* aggregation;
+  char synthetic_path[PATH_MAX];
+  char synthetic_event[PATH_MAX];
+  const char* events[N_HIST_TRIGGERS];
+
+  aggregation = (hist_aggregation*)calloc(1, sizeof(*aggregation));
+  if(aggregation == NULL){
+    fprintf(stderr, "create_hist_aggregation: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  aggregation->pid = pid != 0 ? pid : (pid_t)syscall(SYS_gettid);
+  aggregation->tracing_path = format_string("%s", session->tracing_path);
+  snprintf(aggregation->synthetic_name, sizeof(aggregation->synthetic_name), HIST_SYNTHETIC_NAME, aggregation->pid);
+
+  // Synthetic events are global: they are defined in the root directory of the tracefs even if the session uses an instance
+  snprintf(synthetic_path, PATH_MAX, "%s/synthetic_events", TRACING_PATH);
+  snprintf(synthetic_event, PATH_MAX, "%s pid_t pid; u64 delta", aggregation->synthetic_name);
+  tracing_write(synthetic_path, synthetic_event);
+
+  // The switch out saves the timestamp in a variable that the switch in subtracts, generating a synthetic event with the off-CPU time
+  aggregation->specs[HIST_SWITCH_OUT] = format_string("hist:keys=prev_pid:ts_out=common_timestamp");
+  aggregation->filters[HIST_SWITCH_OUT] = format_string("prev_pid==%d", aggregation->pid);
+  aggregation->specs[HIST_SWITCH_IN] = format_string("hist:keys=next_pid:offcpu=common_timestamp-$ts_out"
+    ":onmatch(sched.sched_switch).%s(next_pid,$offcpu)", aggregation->synthetic_name);
+  aggregation->filters[HIST_SWITCH_IN] = format_string("next_pid==%d", aggregation->pid);
+  aggregation->specs[HIST_MIGRATE] = format_string("hist:keys=pid:vals=hitcount");
+  aggregation->filters[HIST_MIGRATE] = format_string("pid==%d", aggregation->pid);
+  aggregation->specs[HIST_OFFCPU] = format_string("hist:keys=pid:vals=delta");
+  aggregation->filters[HIST_OFFCPU] = NULL;
+  // Each off-CPU time gets its own entry keyed by the time it ended, so the first one of a job is the first entry of the histogram
+  aggregation->specs[HIST_OFFCPU_FIRST] = format_string("hist:keys=common_timestamp:vals=delta:sort=common_timestamp");
+  aggregation->filters[HIST_OFFCPU_FIRST] = NULL;
+
+  events[HIST_SWITCH_OUT] = "sched/sched_switch";
+  events[HIST_SWITCH_IN] = "sched/sched_switch";
+  events[HIST_MIGRATE] = "sched/sched_migrate_task";
+  snprintf(synthetic_event, PATH_MAX, "synthetic/%s", aggregation->synthetic_name);
+  events[HIST_OFFCPU] = synthetic_event;
+  events[HIST_OFFCPU_FIRST] = synthetic_event;
+
+  // The hists of the synthetic event must exist before the trigger that generates it, which in turn needs the "ts_out" variable.
+  // The hist file shows the hists in the order of their installation, so the sum of the off-CPU times comes before the list of them
+  for(int i = N_HIST_TRIGGERS - 1; i >= 0; i--){
+    aggregation->trigger_fd[i] = open_event_file(aggregation, events[i], "trigger", O_WRONLY | O_APPEND);
+    aggregation->hist_fd[i] = open_event_file(aggregation, events[i], "hist", O_RDONLY);
+  }
+  write_trigger(aggregation, HIST_OFFCPU, "", "");
+  write_trigger(aggregation, HIST_OFFCPU_FIRST, "", "");
+  write_trigger(aggregation, HIST_MIGRATE, "", "");
+  write_trigger(aggregation, HIST_SWITCH_OUT, "", "");
+  write_trigger(aggregation, HIST_SWITCH_IN, "", "");
+  return aggregation;
+}
+
+/**
+ * @brief Returns the current CLOCK_MONOTONIC time in nanoseconds.
+ * @return The current time in nanoseconds.
+*/
+static __u64 monotonic_time(void){
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief Reads the hist file of a hist trigger into the buffer of a hist_aggregation struct. Only its first HIST_BUFFER_SIZE - 1
+ * bytes are kept.
+ * @param aggregation A pointer to a hist_aggregation struct.
+ * @param index The index of the hist trigger.
+*/
+static void read_hist(hist_aggregation* aggregation, int index){
+  ssize_t bytes_read;
+  size_t used = 0;
+
+  // A hist file is generated again at every read from its beginning, and it may contain the histograms of several triggers
+  if(lseek(aggregation->hist_fd[index], 0, SEEK_SET) == -1){
+    fprintf(stderr, "hist_aggregation: error seeking the histogram of \"%s\". Aborting ...\n", aggregation->specs[index]);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  while(used < HIST_BUFFER_SIZE - 1){
+    bytes_read = read(aggregation->hist_fd[index], aggregation->buffer + used, HIST_BUFFER_SIZE - 1 - used);
+    if(bytes_read == -1 && errno == EINTR)
+      continue;
+    if(bytes_read == -1){
+      fprintf(stderr, "hist_aggregation: error reading the histogram of \"%s\". Aborting ...\n", aggregation->specs[index]);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    if(bytes_read == 0)
+      break;
+    used += bytes_read;
+  }
+  aggregation->buffer[used] = '\0';
+}
+
+/**
+ * @brief Reads a value from an entry of a histogram.
+ * @param line A pointer to the beginning of the entry.
+ * @param value The name of the value to read, such as "hitcount".
+ * @return The value read, or 0 if the entry doesn't contain it.
+*/
+static __u64 read_entry_value(const char* line, const char* value){
+  char entry[64];
+  char* field;
+
+  snprintf(entry, sizeof(entry), " %s:", value);
+  field = strstr(line, entry);
+  if(field == NULL || (strchr(line, '\n') != NULL && field > strchr(line, '\n')))
+    return 0;
+  return strtoull(field + strlen(entry), NULL, 10);
+}
+
+/**
+ * @brief Reads a value from the entry of a histogram whose key is the pid of the task.
+ * @param aggregation A pointer to a hist_aggregation struct.
+ * @param index The index of the hist trigger.
+ * @param key The name of the key of the histogram, such as "prev_pid".
+ * @param value The name of the value to read, such as "hitcount".
+ * @return The value read, or 0 if the histogram has no entry for the task, as happens when no event has been hit during the job.
+*/
+static __u64 read_hist_value(hist_aggregation* aggregation, int index, const char* key, const char* value){
+  char entry[64];
+  char* line;
+
+  read_hist(aggregation, index);
+  // An entry looks like "{ prev_pid:       1234 } hitcount:          5  delta:     123456"
+  snprintf(entry, sizeof(entry), "{ %s:", key);
+  for(line = strstr(aggregation->buffer, entry); line != NULL; line = strstr(line + 1, entry)){
+    if(strtol(line + strlen(entry), NULL, 10) == aggregation->pid)
+      return read_entry_value(line, value);
+  }
+  return 0;
+}
+
+/**
+ * @brief Reads a value from the first entry of a histogram with a given key, which is the smallest one if the histogram is sorted
+ * by that key.
+ * @param aggregation A pointer to a hist_aggregation struct.
+ * @param index The index of the hist trigger.
+ * @param key The name of the key of the histogram, such as "common_timestamp".
+ * @param value The name of the value to read, such as "delta".
+ * @return The value read, or 0 if the histogram has no entry.
+*/
+static __u64 read_first_hist_value(hist_aggregation* aggregation, int index, const char* key, const char* value){
+  char entry[64];
+  char* line;
+
+  read_hist(aggregation, index);
+  snprintf(entry, sizeof(entry), "{ %s:", key);
+  line = strstr(aggregation->buffer, entry);
+  return line != NULL ? read_entry_value(line, value) : 0;
+}
+
+/**
+ * @brief Clears the histograms that define no variable at the beginning of a job, and reads the counts of the others. The kernel
+ * rejects the ":clear" command of a trigger that defines a variable, since it parses the variable again as a duplicate.
+ * @param aggregation A pointer to a hist_aggregation struct.
+*/
+void hist_aggregation_job_start(hist_aggregation* aggregation){
+  write_trigger(aggregation, HIST_MIGRATE, "", ":clear");
+  write_trigger(aggregation, HIST_OFFCPU, "", ":clear");
+  write_trigger(aggregation, HIST_OFFCPU_FIRST, "", ":clear");
+  // The task is off-CPU if it left the CPU more times than it got it back, in which case its "ts_out" was saved before the job
+  aggregation->start_switches = read_hist_value(aggregation, HIST_SWITCH_OUT, "prev_pid", "hitcount");
+  aggregation->offcpu_pending = aggregation->start_switches > read_hist_value(aggregation, HIST_SWITCH_IN, "next_pid", "hitcount");
+  aggregation->start_time = monotonic_time();
+}
+
+/**
+ * @brief Reads the histograms at the end of a job. The effective CPU time is the total time of the job minus the time spent off-CPU,
+ * since the task is running when it marks the beginning and the end of its jobs.
+ * @param aggregation A pointer to a hist_aggregation struct.
+ * @param job A pointer to a job_metrics struct whose "effective_cpu_time", "total_cpu_time", "num_sched_switches" and
+ * "num_migrations" fields will be set. The "job_number" field is left untouched.
+*/
+void hist_aggregation_job_end(hist_aggregation* aggregation, job_metrics* job){
+  __u64 offcpu_time;
+  __u64 first_offcpu;
+
+  job->total_cpu_time = monotonic_time() - aggregation->start_time;
+  job->num_sched_switches = read_hist_value(aggregation, HIST_SWITCH_OUT, "prev_pid", "hitcount") - aggregation->start_switches;
+  job->num_migrations = read_hist_value(aggregation, HIST_MIGRATE, "pid", "hitcount");
+  offcpu_time = read_hist_value(aggregation, HIST_OFFCPU, "pid", "delta");
+  // The off-CPU time in progress at the beginning of the job is the first one that ended during the job
+  if(aggregation->offcpu_pending){
+    first_offcpu = read_first_hist_value(aggregation, HIST_OFFCPU_FIRST, "common_timestamp", "delta");
+    offcpu_time = first_offcpu < offcpu_time ? offcpu_time - first_offcpu : 0;
+  }
+  job->effective_cpu_time = offcpu_time < job->total_cpu_time ? job->total_cpu_time - offcpu_time : 0;
+}
+
+/**
+ * @brief Removes the hist triggers and the synthetic event, closes the files and frees up the memory allocated for a
+ * hist_aggregation struct.
+ * @param aggregation A pointer to a hist_aggregation struct.
+*/
+void destroy_hist_aggregation(hist_aggregation* aggregation){
+  char synthetic_path[PATH_MAX];
+  char synthetic_event[64];
+
+  // Triggers are removed in the reverse order of their dependencies, then the synthetic event can be deleted
+  write_trigger(aggregation, HIST_SWITCH_IN, "!", "");
+  write_trigger(aggregation, HIST_SWITCH_OUT, "!", "");
+  write_trigger(aggregation, HIST_OFFCPU_FIRST, "!", "");
+  write_trigger(aggregation, HIST_OFFCPU, "!", "");
+  write_trigger(aggregation, HIST_MIGRATE, "!", "");
+  for(int i = 0; i < N_HIST_TRIGGERS; i++){
+    close(aggregation->trigger_fd[i]);
+    close(aggregation->hist_fd[i]);
+    free(aggregation->specs[i]);
+    free(aggregation->filters[i]);
+  }
+  snprintf(synthetic_path, PATH_MAX, "%s/synthetic_events", TRACING_PATH);
+  snprintf(synthetic_event, sizeof(synthetic_event), "!%s", aggregation->synthetic_name);
+  tracing_write(synthetic_path, synthetic_event);
+  free(aggregation->tracing_path);
+  free(aggregation);
+}
@@ -0,0 +1,72 @@
+#ifndef HIST_AGGREGATION_H_
+#define HIST_AGGREGATION_H_
+
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+#include "job_metrics.h"
+
+#define HIST_SWITCH_OUT 0	///>Index of the hist trigger that counts the times the task leaves the CPU and saves the timestamp.
+#define HIST_SWITCH_IN 1	///>Index of the hist trigger that computes the off-CPU time when the task gets the CPU back.
+#define HIST_MIGRATE 2		///>Index of the hist trigger that counts the migrations of the task.
+#define HIST_OFFCPU 3			///>Index of the hist trigger that sums the off-CPU times generated as synthetic events.
+#define HIST_OFFCPU_FIRST 4	///>Index of the hist trigger that keeps each off-CPU time by the timestamp of its end, sorted, to find the first one of a job.
+#define N_HIST_TRIGGERS 5	///>Number of hist triggers installed by a hist_aggregation struct.
+
+#define HIST_SYNTHETIC_NAME "etl_offcpu_%d"	///>Name of the synthetic event that carries an off-CPU time, followed by the pid of the task.
+#define HIST_BUFFER_SIZE 4096	///>Size of the buffer used to read a histogram.
+
+/**
+ * @brief A structure that aggregates inside the kernel, with hist triggers, the sched events of a task, so that only a few
+ * numbers per job are read instead of exporting every event. The events don't need to be enabled: the triggers are fired
+ * even if the events are not recorded in the ring buffer.
+*/
+typedef struct hist_aggregation{
+	char* tracing_path; ///> The path to the root directory of the tracefs, or of the instance, where the triggers are installed.
+	pid_t pid; ///> The pid of the aggregated task.
+	char synthetic_name[32]; ///> The name of the synthetic event of the off-CPU times.
+	char* specs[N_HIST_TRIGGERS]; ///> The hist trigger commands without their filter, needed to clear and to remove the triggers.
+	char* filters[N_HIST_TRIGGERS]; ///> The filters of the hist triggers. They are NULL for the triggers that don't need one.
+	int trigger_fd[N_HIST_TRIGGERS]; ///> File descriptors of the trigger files of the aggregated events.
+	int hist_fd[N_HIST_TRIGGERS]; ///> File descriptors of the hist files of the aggregated events.
+	char buffer[HIST_BUFFER_SIZE]; ///> The buffer used to read the histograms.
+	__u64 start_time; ///> CLOCK_MONOTONIC time of the beginning of the job in progress, in nanoseconds.
+	__u64 start_switches; ///> Number of times the task left the CPU before the job in progress, since the switch out histogram is never cleared.
+	short offcpu_pending; ///> 1 if the task was off-CPU at the beginning of the job in progress, so the first off-CPU time of the job began before it.
+} hist_aggregation;
+
+/**
+ * @brief Defines the synthetic event and installs the hist triggers on the sched_switch and sched_migrate_task events of the tracefs
+ * used by a tracing_session, filtered by the pid of a task.
+ * @param session A pointer to a tracing_session struct. Its tracefs, or its instance, keeps the histograms.
+ * @param pid The pid of the task to aggregate. Set it to 0 in order to use the calling thread.
+ * @return A pointer to a newly created hist_aggregation struct. This structure must be deallocated using the
+ * "destroy_hist_aggregation()" function, which also removes the triggers and the synthetic event.
+*/
+hist_aggregation* create_hist_aggregation(tracing_session* session, pid_t pid);
+
+/**
+ * @brief Clears the histograms that define no variable at the beginning of a job, and reads the counts of the others. The kernel
+ * rejects the ":clear" command of a trigger that defines a variable, since it parses the variable again as a duplicate.
+ * @param aggregation A pointer to a hist_aggregation struct.
+*/
+void hist_aggregation_job_start(hist_aggregation* aggregation);
+
+/**
+ * @brief Reads the histograms at the end of a job. The effective CPU time is the total time of the job minus the time spent off-CPU,
+ * since the task is running when it marks the beginning and the end of its jobs. If the aggregated task is not the calling one and
+ * it was off-CPU at the beginning of the job, the off-CPU time that began before the job is not counted.
+ * @param aggregation A pointer to a hist_aggregation struct.
+ * @param job A pointer to a job_metrics struct whose "effective_cpu_time", "total_cpu_time", "num_sched_switches" and
+ * "num_migrations" fields will be set. The "job_number" field is left untouched.
+*/
+void hist_aggregation_job_end(hist_aggregation* aggregation, job_metrics* job);
+
+/**
+ * @brief Removes the hist triggers and the synthetic event, closes the files and frees up the memory allocated for a
+ * hist_aggregation struct.
+ * @param aggregation A pointer to a hist_aggregation struct.
+*/
+void destroy_hist_aggregation(hist_aggregation* aggregation);
+
+#endif
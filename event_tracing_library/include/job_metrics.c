@@ -0,0 +1,245 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/prctl.h>
+#include "job_metrics.h"
+
+/**
+ * @brief Creates a metrics engine that writes the "metrics.txt" file in an execution directory, overwriting it if it exists.
+ * @param dir_file_path The path to the execution directory. It must already exist.
+ * @param identifier The string that identifies the program execution.
+ * @param process_name The command name of the traced process. Set it to NULL in order to use the one of the calling thread.
+ * @return A pointer to a newly created job_metrics_engine struct. This structure must be deallocated using the
+ * "destroy_job_metrics_engine()" function when you're done with it.
+*/
+job_metrics_engine* create_job_metrics_engine(const char* dir_file_path, const char* identifier, const char* process_name){
+  job_metrics_engine* engine;
+
+  engine = (job_metrics_engine*)calloc(1, sizeof(*engine));
+  if(engine == NULL){
+    fprintf(stderr, "create_job_metrics_engine: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  if(process_name != NULL){
+    strncpy(engine->process_name, process_name, RAW_COMM_LEN - 1);
+  }else if(prctl(PR_GET_NAME, engine->process_name) == -1){
+    fprintf(stderr, "create_job_metrics_engine: error retrieving the command name. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  engine->identifier = strdup(identifier);
+  engine->file_path = (char*)calloc(strlen(dir_file_path) + 1 + strlen(JOB_METRICS_FILENAME) + 1, sizeof(char));
+  if(engine->identifier == NULL || engine->file_path == NULL){
+    fprintf(stderr, "create_job_metrics_engine: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  sprintf(engine->file_path, "%s/%s", dir_file_path, JOB_METRICS_FILENAME);
+  engine->fd = -1;
+  engine->file = fopen(engine->file_path, "w");
+  if(engine->file == NULL){
+    fprintf(stderr, "create_job_metrics_engine: error opening \"%s\" file. Aborting ...\n", engine->file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  return engine;
+}
+
+/**
+ * @brief Consumes a sched_switch event. It must be called in timestamp order with respect to the other events.
+ * @param engine A pointer to a job_metrics_engine struct.
+ * @param cpu The CPU that recorded the event.
+ * @param timestamp The timestamp of the event in nanoseconds.
+ * @param prev_comm The command name of the task that left the CPU.
+*/
+void job_metrics_sched_switch(job_metrics_engine* engine, int cpu, __u64 timestamp, const char* prev_comm){
+  job_metrics* job = &engine->current;
+
+  if(!engine->job_started)
+    return;
+  // The job ran from the last time it got the CPU, or from its start, until now
+  if(strncmp(prev_comm, engine->process_name, RAW_COMM_LEN) == 0){
+    if(job->previous_core != cpu){
+      job->num_migrations++;
+      job->previous_core = cpu;
+    }
+    job->num_sched_switches++;
+    job->effective_cpu_time += timestamp - job->previous_timestamp;
+  }
+  job->previous_timestamp = timestamp;
+}
+
+/**
+ * @brief Formats a time expressed in nanoseconds as seconds with six decimal digits, rounding it to the nearest microsecond as the
+ * Python module does.
+ * @param str A buffer of at least 32 characters where to write the formatted time.
+ * @param time A time in nanoseconds. It can be negative.
+ * @return The time rounded to microseconds.
+*/
+static long long format_seconds(char* str, long long time){
+  long long us = (time < 0 ? time - 500 : time + 500) / 1000;
+  long long abs_us = us < 0 ? -us : us;
+
+  sprintf(str, "%s%lld.%06lld", us < 0 ? "-" : "", abs_us / 1000000, abs_us % 1000000);
+  return us;
+}
+
+/**
+ * @brief Formats the metrics of a finished job as a line of the metrics file.
+ * @param str A pointer to the buffer where to write the line. It can be NULL if "size" is 0.
+ * @param size The size in bytes of the buffer.
+ * @param identifier The string that identifies the program execution.
+ * @param job A pointer to a job_metrics struct whose "job_number", "effective_cpu_time", "total_cpu_time", "num_sched_switches"
+ * and "num_migrations" fields are set. If its "worker" field is set, the worker is written as last field.
+ * @return The length of the whole line, as returned by snprintf().
+*/
+int job_metrics_format(char* str, size_t size, const char* identifier, const job_metrics* job){
+  long long effective_us, total_us;
+  char effective_str[32], total_str[32], diff_str[32];
+
+  effective_us = format_seconds(effective_str, job->effective_cpu_time);
+  total_us = format_seconds(total_str, job->total_cpu_time);
+  // The difference is computed between the rounded times, as the Python module does
+  format_seconds(diff_str, (total_us - effective_us) * 1000);
+  if(job->worker != 0)
+    return snprintf(str, size, "%s, %d, %s, %s, %s, %d, %d, %d\n", identifier, job->job_number, effective_str, total_str, diff_str,
+                    job->num_sched_switches, job->num_migrations, job->worker);
+  return snprintf(str, size, "%s, %d, %s, %s, %s, %d, %d\n", identifier, job->job_number, effective_str, total_str, diff_str,
+                  job->num_sched_switches, job->num_migrations);
+}
+
+/**
+ * @brief Writes the metrics of a finished job as a line of the metrics file.
+ * @param engine A pointer to a job_metrics_engine struct.
+ * @param job A pointer to a job_metrics struct whose "job_number", "effective_cpu_time", "total_cpu_time", "num_sched_switches"
+ * and "num_migrations" fields are set.
+*/
+void job_metrics_write(job_metrics_engine* engine, const job_metrics* job){
+  char line[STR_BUFFER_SIZE];
+  int len;
+
+  len = job_metrics_format(line, STR_BUFFER_SIZE, engine->identifier, job);
+  if(len < 0 || len >= STR_BUFFER_SIZE || (engine->fd != -1 ? write(engine->fd, line, len) != len : fputs(line, engine->file) == EOF)){
+    fprintf(stderr, "job_metrics_write: error writing to \"%s\" file. Aborting ...\n", engine->file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  engine->n_jobs++;
+}
+
+/**
+ * @brief Reopens the metrics file inherited from the parent process with a descriptor of the calling process in append mode, so
+ * that several processes, such as the workers of a program, can write to the same file. From now on each line is written with a
+ * single write(), which O_APPEND makes atomic, instead of through a stdio buffer sharing the file offset with the other processes.
+ * It must be called after the fork and before the first job.
+ * @param engine A pointer to a job_metrics_engine struct.
+*/
+void job_metrics_reopen_shared(job_metrics_engine* engine){
+  // The stdio buffer of the inherited stream is empty, since the parent writes no job before the fork
+  fclose(engine->file);
+  engine->file = NULL;
+  engine->fd = open(engine->file_path, O_WRONLY | O_APPEND);
+  if(engine->fd == -1){
+    fprintf(stderr, "job_metrics_reopen_shared: error opening \"%s\" file. Aborting ...\n", engine->file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Consumes a job marker. A START marker begins a new job, discarding an unfinished one. A STOP marker of the job in progress
+ * writes its metrics to the metrics file, while a STOP marker of another job discards the job in progress.
+ * @param engine A pointer to a job_metrics_engine struct.
+ * @param cpu The CPU that recorded the marker.
+ * @param timestamp The timestamp of the marker in nanoseconds.
+ * @param job_number The number of the job.
+ * @param state START or STOP.
+*/
+void job_metrics_job_marker(job_metrics_engine* engine, int cpu, __u64 timestamp, int job_number, int state){
+  job_metrics* job = &engine->current;
+
+  if(state == START){
+    bzero(job, sizeof(*job));
+    job->job_number = job_number;
+    job->start_timestamp = job->previous_timestamp = timestamp;
+    job->previous_core = cpu;
+    engine->job_started = 1;
+    return;
+  }
+  if(engine->job_started && job->job_number == job_number){
+    job->total_cpu_time = timestamp - job->start_timestamp;
+    if(job->effective_cpu_time == 0)
+      job->effective_cpu_time = job->total_cpu_time;
+    else
+      job->effective_cpu_time += timestamp - job->previous_timestamp;
+
+    job_metrics_write(engine, job);
+  }
+  engine->job_started = 0;
+}
+
+/**
+ * @brief Consumes an event read from the raw per-CPU traces, ignoring the events that are neither sched_switch nor job markers.
+ * @param engine A pointer to a job_metrics_engine struct.
+ * @param reader A pointer to the raw_trace_reader struct that returned the event.
+ * @param event A pointer to a raw_event struct.
+*/
+void job_metrics_raw_event(job_metrics_engine* engine, raw_trace_reader* reader, const raw_event* event){
+  raw_sched_switch sched_switch;
+  raw_job_marker marker;
+
+  if(raw_trace_event_flag(reader, event) == E_SCHED_SWITCH){
+    if(raw_trace_decode_sched_switch(reader, event, &sched_switch))
+      job_metrics_sched_switch(engine, event->cpu, event->timestamp, sched_switch.prev_comm);
+  }else if(raw_trace_decode_job_marker(reader, event, &marker)){
+    job_metrics_job_marker(engine, event->cpu, event->timestamp, marker.job_number, marker.state);
+  }
+}
+
+/**
+ * @brief Closes the metrics file and frees up the memory allocated for a job_metrics_engine struct. An unfinished job is discarded.
+ * @param engine A pointer to a job_metrics_engine struct.
+ * @return The number of jobs written to the metrics file.
+*/
+int destroy_job_metrics_engine(job_metrics_engine* engine){
+  int n_jobs = engine->n_jobs;
+
+  if(engine->fd != -1 ? close(engine->fd) == -1 : fclose(engine->file) == EOF){
+    fprintf(stderr, "destroy_job_metrics_engine: error closing \"%s\" file. Aborting ...\n", engine->file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  free(engine->identifier);
+  free(engine->file_path);
+  free(engine);
+  return n_jobs;
+}
+
+/**
+ * @brief Computes the metrics of all the jobs contained in the raw per-CPU traces of an execution directory, writing its
+ * "metrics.txt" file.
+ * @param dir_file_path The path to the execution directory that contains the raw traces.
+ * @param identifier The string that identifies the program execution.
+ * @param process_name The command name of the traced process. Set it to NULL in order to use the one of the calling thread.
+ * @return The number of jobs written to the metrics file.
+*/
+int compute_job_metrics(const char* dir_file_path, const char* identifier, const char* process_name){
+  job_metrics_engine* engine;
+  raw_trace_reader* reader;
+  raw_event event;
+
+  engine = create_job_metrics_engine(dir_file_path, identifier, process_name);
+  reader = raw_trace_open(dir_file_path);
+  while(raw_trace_next(reader, &event)){
+    job_metrics_raw_event(engine, reader, &event);
+  }
+  raw_trace_close(reader);
+  return destroy_job_metrics_engine(engine);
+}
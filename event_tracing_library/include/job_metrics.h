@@ -0,0 +1,126 @@
+#ifndef JOB_METRICS_H_
+#define JOB_METRICS_H_
+
+#include <stdio.h>
+#include <linux/types.h>
+#include "raw_trace.h"
+
+#define JOB_METRICS_FILENAME "metrics.txt"	///>Name of the file, within an execution directory, that contains one line of metrics per job.
+
+/**
+ * @brief A structure that contains the metrics of a job, the same computed by the "analyze_trace()" function of the Python module.
+ * The times are expressed in nanoseconds.
+*/
+typedef struct job_metrics{
+	int job_number; ///> The number of the job.
+	int worker; ///> The worker that ran the job, or 0 if the jobs run one after another. If it is set, it is written as last field of the line.
+	__u64 start_timestamp; ///> Timestamp of the start marker of the job.
+	__u64 previous_timestamp; ///> Timestamp of the last sched_switch event seen during the job, or of the start marker.
+	int previous_core; ///> The CPU where the job was last seen running.
+	__u64 effective_cpu_time; ///> Time spent by the job on a CPU.
+	__u64 total_cpu_time; ///> Time elapsed between the start and the end marker of the job.
+	int num_sched_switches; ///> Number of times the job left the CPU.
+	int num_migrations; ///> Number of times the job changed CPU.
+} job_metrics;
+
+/**
+ * @brief A structure that computes the metrics of each job while the events are consumed in timestamp order, using the job markers
+ * as boundaries. Each finished job is written as a line of the "metrics.txt" file of the execution directory.
+*/
+typedef struct job_metrics_engine{
+	char process_name[RAW_COMM_LEN + 1]; ///> The command name of the traced process.
+	char* identifier; ///> The string that identifies the program execution, written in each line.
+	char* file_path; ///> The path to the metrics file, used for error messages.
+	FILE* file; ///> The metrics file.
+	int fd; ///> The descriptor of the metrics file opened in append mode by "job_metrics_reopen_shared()", -1 if it is not used.
+	job_metrics current; ///> The metrics of the job in progress.
+	short job_started; ///> 1 if a job is in progress, 0 otherwise.
+	int n_jobs; ///> Number of jobs written to the metrics file.
+} job_metrics_engine;
+
+/**
+ * @brief Creates a metrics engine that writes the "metrics.txt" file in an execution directory, overwriting it if it exists.
+ * @param dir_file_path The path to the execution directory. It must already exist.
+ * @param identifier The string that identifies the program execution.
+ * @param process_name The command name of the traced process. Set it to NULL in order to use the one of the calling thread.
+ * @return A pointer to a newly created job_metrics_engine struct. This structure must be deallocated using the
+ * "destroy_job_metrics_engine()" function when you're done with it.
+*/
+job_metrics_engine* create_job_metrics_engine(const char* dir_file_path, const char* identifier, const char* process_name);
+
+/**
+ * @brief Consumes a sched_switch event. It must be called in timestamp order with respect to the other events.
+ * @param engine A pointer to a job_metrics_engine struct.
+ * @param cpu The CPU that recorded the event.
+ * @param timestamp The timestamp of the event in nanoseconds.
+ * @param prev_comm The command name of the task that left the CPU.
+*/
+void job_metrics_sched_switch(job_metrics_engine* engine, int cpu, __u64 timestamp, const char* prev_comm);
+
+/**
+ * @brief Consumes a job marker. A START marker begins a new job, discarding an unfinished one. A STOP marker of the job in progress
+ * writes its metrics to the metrics file, while a STOP marker of another job discards the job in progress.
+ * @param engine A pointer to a job_metrics_engine struct.
+ * @param cpu The CPU that recorded the marker.
+ * @param timestamp The timestamp of the marker in nanoseconds.
+ * @param job_number The number of the job.
+ * @param state START or STOP.
+*/
+void job_metrics_job_marker(job_metrics_engine* engine, int cpu, __u64 timestamp, int job_number, int state);
+
+/**
+ * @brief Formats the metrics of a finished job as a line of the metrics file.
+ * @param str A pointer to the buffer where to write the line. It can be NULL if "size" is 0.
+ * @param size The size in bytes of the buffer.
+ * @param identifier The string that identifies the program execution.
+ * @param job A pointer to a job_metrics struct whose "job_number", "effective_cpu_time", "total_cpu_time", "num_sched_switches"
+ * and "num_migrations" fields are set. If its "worker" field is set, the worker is written as last field.
+ * @return The length of the whole line, as returned by snprintf().
+*/
+int job_metrics_format(char* str, size_t size, const char* identifier, const job_metrics* job);
+
+/**
+ * @brief Writes the metrics of a finished job as a line of the metrics file. It allows to write the metrics of jobs measured in
+ * other ways, such as the kernel histograms of "hist_aggregation.h" or the unprivileged measurements of "light_metrics.h", with
+ * the same format.
+ * @param engine A pointer to a job_metrics_engine struct.
+ * @param job A pointer to a job_metrics struct whose "job_number", "effective_cpu_time", "total_cpu_time", "num_sched_switches"
+ * and "num_migrations" fields are set.
+*/
+void job_metrics_write(job_metrics_engine* engine, const job_metrics* job);
+
+/**
+ * @brief Reopens the metrics file inherited from the parent process with a descriptor of the calling process in append mode, so
+ * that several processes, such as the workers of a program, can write to the same file. From now on each line is written with a
+ * single write(), which O_APPEND makes atomic, instead of through a stdio buffer sharing the file offset with the other processes.
+ * It must be called after the fork and before the first job.
+ * @param engine A pointer to a job_metrics_engine struct.
+*/
+void job_metrics_reopen_shared(job_metrics_engine* engine);
+
+/**
+ * @brief Consumes an event read from the raw per-CPU traces, ignoring the events that are neither sched_switch nor job markers.
+ * @param engine A pointer to a job_metrics_engine struct.
+ * @param reader A pointer to the raw_trace_reader struct that returned the event.
+ * @param event A pointer to a raw_event struct.
+*/
+void job_metrics_raw_event(job_metrics_engine* engine, raw_trace_reader* reader, const raw_event* event);
+
+/**
+ * @brief Closes the metrics file and frees up the memory allocated for a job_metrics_engine struct. An unfinished job is discarded.
+ * @param engine A pointer to a job_metrics_engine struct.
+ * @return The number of jobs written to the metrics file.
+*/
+int destroy_job_metrics_engine(job_metrics_engine* engine);
+
+/**
+ * @brief Computes the metrics of all the jobs contained in the raw per-CPU traces of an execution directory, writing its
+ * "metrics.txt" file.
+ * @param dir_file_path The path to the execution directory that contains the raw traces.
+ * @param identifier The string that identifies the program execution.
+ * @param process_name The command name of the traced process. Set it to NULL in order to use the one of the calling thread.
+ * @return The number of jobs written to the metrics file.
+*/
+int compute_job_metrics(const char* dir_file_path, const char* identifier, const char* process_name);
+
+#endif
@@ -0,0 +1,265 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <pthread.h>
+#include "light_metrics.h"
+
+// The light_metrics structs used by "trace_mark_job()" and "log_execution_info()" when the tracefs is not available, one per thread,
+// since each of them measures the thread that created it. They are destroyed when their threads exit.
+static pthread_key_t default_light_key;
+static pthread_once_t default_light_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Creates a light_metrics struct that measures the jobs of the calling thread. It must be used only by that thread.
+ * @return A pointer to a newly created light_metrics struct. This structure must be deallocated using the "destroy_light_metrics()"
+ * function when you're done with it.
+*/
+light_metrics* create_light_metrics(void){
+  light_metrics* light;
+
+  light = (light_metrics*)calloc(1, sizeof(*light));
+  if(light == NULL){
+    fprintf(stderr, "create_light_metrics: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  // Both files are optional: they depend on CONFIG_SCHEDSTATS and CONFIG_SCHED_DEBUG
+  light->schedstat_fd = open(LIGHT_SCHEDSTAT_PATH, O_RDONLY | O_CLOEXEC);
+  light->sched_fd = open(LIGHT_SCHED_PATH, O_RDONLY | O_CLOEXEC);
+  return light;
+}
+
+/**
+ * @brief Reads a whole proc file from its beginning.
+ * @param fd The file descriptor of the file.
+ * @param buffer The buffer where to store the content of the file, terminated by '\0'.
+ * @param size The size in bytes of the buffer.
+ * @return 0 on success, -1 on error.
+*/
+static int read_proc_file(int fd, char* buffer, size_t size){
+  ssize_t bytes_read;
+  size_t used = 0;
+
+  if(lseek(fd, 0, SEEK_SET) == -1)
+    return -1;
+  while(used < size - 1 && (bytes_read = read(fd, buffer + used, size - 1 - used)) != 0){
+    if(bytes_read == -1){
+      if(errno == EINTR)
+        continue;
+      return -1;
+    }
+    used += bytes_read;
+  }
+  buffer[used] = '\0';
+  return 0;
+}
+
+/**
+ * @brief Returns the time of a clock in nanoseconds.
+ * @param clock_id The clock to read.
+ * @return The time in nanoseconds.
+*/
+static __u64 clock_time(clockid_t clock_id){
+  struct timespec ts;
+
+  if(clock_gettime(clock_id, &ts) == -1){
+    fprintf(stderr, "light_metrics: error reading the clock %d. Aborting ...\n", (int)clock_id);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief Takes a snapshot of the counters of the calling thread.
+ * @param light A pointer to a light_metrics struct.
+ * @param sample A pointer to the light_sample struct to fill.
+*/
+static void take_sample(light_metrics* light, light_sample* sample){
+  char buffer[STR_BUFFER_SIZE];
+  struct rusage usage;
+  unsigned long long run_delay = 0;
+  char* field;
+
+  sample->wall_time = clock_time(CLOCK_MONOTONIC);
+  sample->cpu_time = clock_time(CLOCK_THREAD_CPUTIME_ID);
+  if(getrusage(RUSAGE_THREAD, &usage) == -1){
+    fprintf(stderr, "light_metrics: error reading the resource usage of the thread. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  sample->voluntary_switches = usage.ru_nvcsw;
+  sample->involuntary_switches = usage.ru_nivcsw;
+  sample->cpu = sched_getcpu();
+
+  // The schedstat file contains the run time, the run delay and the number of timeslices
+  if(light->schedstat_fd != -1 && read_proc_file(light->schedstat_fd, buffer, sizeof(buffer)) == 0)
+    sscanf(buffer, "%*u %llu", &run_delay);
+  sample->run_delay = run_delay;
+
+  // The sched file contains lines such as "se.nr_migrations          :          5"
+  sample->migrations = -1;
+  if(light->sched_fd != -1 && read_proc_file(light->sched_fd, buffer, sizeof(buffer)) == 0){
+    field = strstr(buffer, LIGHT_MIGRATIONS_FIELD);
+    if(field != NULL && (field = strchr(field, ':')) != NULL)
+      sample->migrations = strtol(field + 1, NULL, 10);
+  }
+}
+
+/**
+ * @brief Takes the snapshot of the beginning of a job.
+ * @param light A pointer to a light_metrics struct.
+ * @param job_number The number of the job.
+*/
+void light_metrics_job_start(light_metrics* light, int job_number){
+  light->job_number = job_number;
+  light->job_started = 1;
+  take_sample(light, &light->start);
+}
+
+/**
+ * @brief Takes the snapshot of the end of a job and computes its metrics.
+ * @param light A pointer to a light_metrics struct.
+ * @param job A pointer to a job_metrics struct where to store the metrics of the job. It can be NULL, since the metrics are kept
+ * in the "last_job" field too.
+ * @param e_info A pointer to an exec_info struct where to set the "voluntary_switches", "involuntary_switches" and "run_delay"
+ * extra metrics of the job. Set it to NULL if they are not needed.
+*/
+void light_metrics_job_end(light_metrics* light, job_metrics* job, exec_info* e_info){
+  light_sample end;
+  job_metrics* last = &light->last_job;
+
+  take_sample(light, &end);
+  bzero(last, sizeof(*last));
+  last->job_number = light->job_number;
+  last->total_cpu_time = end.wall_time - light->start.wall_time;
+  last->effective_cpu_time = end.cpu_time - light->start.cpu_time;
+  // The two clocks are read one after the other, so the CPU time of a job that never left the CPU can exceed its wall time
+  if(last->effective_cpu_time > last->total_cpu_time)
+    last->effective_cpu_time = last->total_cpu_time;
+  last->num_sched_switches = (end.voluntary_switches - light->start.voluntary_switches) +
+                             (end.involuntary_switches - light->start.involuntary_switches);
+  if(end.migrations != -1 && light->start.migrations != -1)
+    last->num_migrations = end.migrations - light->start.migrations;
+  else
+    last->num_migrations = end.cpu != light->start.cpu;
+  light->last_run_delay = end.run_delay - light->start.run_delay;
+  light->job_started = 0;
+  light->job_ready = 1;
+
+  if(job != NULL)
+    *job = *last;
+  if(e_info != NULL){
+    exec_info_set_metric(e_info, "voluntary_switches", end.voluntary_switches - light->start.voluntary_switches);
+    exec_info_set_metric(e_info, "involuntary_switches", end.involuntary_switches - light->start.involuntary_switches);
+    exec_info_set_metric(e_info, "run_delay", light->last_run_delay);
+  }
+}
+
+/**
+ * @brief Closes the files and frees up the memory allocated for a light_metrics struct.
+ * @param light A pointer to a light_metrics struct.
+*/
+void destroy_light_metrics(light_metrics* light){
+  if(light->schedstat_fd != -1)
+    close(light->schedstat_fd);
+  if(light->sched_fd != -1)
+    close(light->sched_fd);
+  free(light);
+}
+
+/**
+ * @brief Destroys the light_metrics struct of a thread that exits.
+ * @param light A pointer to the light_metrics struct of the thread.
+*/
+static void destroy_default_light(void* light){
+  destroy_light_metrics((light_metrics*)light);
+}
+
+/**
+ * @brief Creates the key of the light_metrics structs of the threads. It is called once through "pthread_once()".
+*/
+static void create_default_light_key(void){
+  if(pthread_key_create(&default_light_key, destroy_default_light) != 0){
+    fprintf(stderr, "light_metrics: error creating the key of the threads. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Returns the light_metrics struct owned by the library for the calling thread.
+ * @param create Set it to 1 in order to create the struct if the calling thread doesn't have one yet.
+ * @return A pointer to the light_metrics struct of the calling thread, NULL if it doesn't have one and "create" is 0.
+*/
+static light_metrics* get_default_light(short create){
+  light_metrics* light;
+
+  pthread_once(&default_light_once, create_default_light_key);
+  light = (light_metrics*)pthread_getspecific(default_light_key);
+  if(light == NULL && create){
+    light = create_light_metrics();
+    if(pthread_setspecific(default_light_key, light) != 0){
+      fprintf(stderr, "light_metrics: error setting the measurement of the thread. Aborting ...\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+  return light;
+}
+
+/**
+ * @brief The backend of "trace_mark_job()" used when the tracefs is not available. It measures the jobs of the calling thread
+ * with a light_metrics struct owned by the library, one for each thread, so that several threads can mark their jobs at the same time.
+ * @param job_number An integer value that identifies a job during a program execution.
+ * @param flag START or STOP.
+*/
+void light_mark_job(int job_number, short flag){
+  light_metrics* default_light = get_default_light(1);
+
+  if(flag == START)
+    light_metrics_job_start(default_light, job_number);
+  else if(flag == STOP && default_light->job_started && default_light->job_number == job_number)
+    light_metrics_job_end(default_light, NULL, NULL);
+}
+
+/**
+ * @brief The backend of "log_execution_info()" used when the tracefs is not available. It appends the metrics of the last job
+ * finished by "light_mark_job()" in the calling thread to the "metrics.txt" file of an execution directory, if they have not been
+ * logged yet.
+ * @param dir_file_path The path to the execution directory. It must already exist.
+ * @param identifier The string that identifies the program execution.
+*/
+void light_log_job(const char* dir_file_path, const char* identifier){
+  light_metrics* default_light = get_default_light(0);
+  char file_path[PATH_MAX];
+  char line[STR_BUFFER_SIZE];
+  int fd;
+  int len;
+
+  if(default_light == NULL || !default_light->job_ready)
+    return;
+  snprintf(file_path, PATH_MAX, "%s/%s", dir_file_path, JOB_METRICS_FILENAME);
+  fd = open(file_path, O_WRONLY | O_CREAT | O_APPEND, 0777);
+  if(fd == -1){
+    fprintf(stderr, "log_execution_info: error opening \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  len = job_metrics_format(line, STR_BUFFER_SIZE, identifier, &default_light->last_job);
+  if(len < 0 || len >= STR_BUFFER_SIZE || write(fd, line, len) != len){
+    fprintf(stderr, "log_execution_info: error writing to \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  close(fd);
+  default_light->job_ready = 0;
+}
@@ -0,0 +1,91 @@
+#ifndef LIGHT_METRICS_H_
+#define LIGHT_METRICS_H_
+
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+#include "job_metrics.h"
+
+#define LIGHT_SCHEDSTAT_PATH "/proc/thread-self/schedstat"	///>Path to the file with the run time, the wait time and the timeslices of the calling thread.
+#define LIGHT_SCHED_PATH "/proc/thread-self/sched"					///>Path to the file with the scheduler statistics of the calling thread, including its migrations.
+#define LIGHT_MIGRATIONS_FIELD "se.nr_migrations"						///>Name of the field of the LIGHT_SCHED_PATH file that counts the migrations.
+
+/**
+ * @brief A snapshot of the counters of the calling thread that don't require root privileges nor the tracefs.
+*/
+typedef struct light_sample{
+	__u64 wall_time; ///> CLOCK_MONOTONIC time in nanoseconds.
+	__u64 cpu_time; ///> CLOCK_THREAD_CPUTIME_ID time in nanoseconds.
+	long voluntary_switches; ///> Voluntary context switches reported by getrusage(RUSAGE_THREAD).
+	long involuntary_switches; ///> Involuntary context switches reported by getrusage(RUSAGE_THREAD).
+	__u64 run_delay; ///> Time spent waiting on a runqueue in nanoseconds, the second field of the LIGHT_SCHEDSTAT_PATH file.
+	long migrations; ///> Migrations of the thread, from the LIGHT_SCHED_PATH file.
+	int cpu; ///> The CPU where the thread was running.
+} light_sample;
+
+/**
+ * @brief A structure that measures the jobs of the calling thread without root privileges and without the tracefs, producing the
+ * same per-job metrics computed from the kernel trace. The effective CPU time is the thread CPU time, the sched switches are the
+ * voluntary and involuntary context switches, and the migrations are read from the scheduler statistics of the thread. If the kernel
+ * doesn't provide them (CONFIG_SCHED_DEBUG), the migrations are counted only when the CPU at the end of a job differs from the one
+ * at its beginning, so they are a lower bound.
+*/
+typedef struct light_metrics{
+	int schedstat_fd; ///> File descriptor of the LIGHT_SCHEDSTAT_PATH file, -1 if it is not available.
+	int sched_fd; ///> File descriptor of the LIGHT_SCHED_PATH file, -1 if it is not available.
+	light_sample start; ///> The snapshot taken at the beginning of the job in progress.
+	int job_number; ///> The number of the job in progress, or of the last finished one.
+	short job_started; ///> 1 if a job is in progress, 0 otherwise.
+	short job_ready; ///> 1 if a finished job has not been logged yet by "log_execution_info()", 0 otherwise.
+	job_metrics last_job; ///> The metrics of the last finished job.
+	__u64 last_run_delay; ///> The time spent by the last finished job waiting on a runqueue in nanoseconds.
+} light_metrics;
+
+/**
+ * @brief Creates a light_metrics struct that measures the jobs of the calling thread. It must be used only by that thread.
+ * @return A pointer to a newly created light_metrics struct. This structure must be deallocated using the "destroy_light_metrics()"
+ * function when you're done with it.
+*/
+light_metrics* create_light_metrics(void);
+
+/**
+ * @brief Takes the snapshot of the beginning of a job.
+ * @param light A pointer to a light_metrics struct.
+ * @param job_number The number of the job.
+*/
+void light_metrics_job_start(light_metrics* light, int job_number);
+
+/**
+ * @brief Takes the snapshot of the end of a job and computes its metrics.
+ * @param light A pointer to a light_metrics struct.
+ * @param job A pointer to a job_metrics struct where to store the metrics of the job. It can be NULL, since the metrics are kept
+ * in the "last_job" field too.
+ * @param e_info A pointer to an exec_info struct where to set the "voluntary_switches", "involuntary_switches" and "run_delay"
+ * extra metrics of the job. Set it to NULL if they are not needed.
+*/
+void light_metrics_job_end(light_metrics* light, job_metrics* job, exec_info* e_info);
+
+/**
+ * @brief Closes the files and frees up the memory allocated for a light_metrics struct.
+ * @param light A pointer to a light_metrics struct.
+*/
+void destroy_light_metrics(light_metrics* light);
+
+/**
+ * @brief The backend of "trace_mark_job()" used when the tracefs is not available. It measures the jobs of the calling thread
+ * with a light_metrics struct owned by the library, one for each thread, so that several threads can mark their jobs at the same time.
+ * @param job_number An integer value that identifies a job during a program execution.
+ * @param flag START or STOP.
+*/
+void light_mark_job(int job_number, short flag);
+
+/**
+ * @brief The backend of "log_execution_info()" used when the tracefs is not available. It appends the metrics of the last job
+ * finished by "light_mark_job()" in the calling thread to the "metrics.txt" file of an execution directory, if they have not been
+ * logged yet.
+ * @param dir_file_path The path to the execution directory. It must already exist.
+ * @param identifier The string that identifies the program execution.
+*/
+void light_log_job(const char* dir_file_path, const char* identifier);
+
+#endif
@@ -0,0 +1,159 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "perf_counters.h"
+
+static const char* counter_names[N_PERF_COUNTERS] = {"task_clock", "context_switches", "cpu_migrations", "page_faults",
+                                                     "cycles", "instructions", "cache_misses"};
+
+static const __u32 counter_types[N_PERF_COUNTERS] = {PERF_TYPE_SOFTWARE, PERF_TYPE_SOFTWARE, PERF_TYPE_SOFTWARE, PERF_TYPE_SOFTWARE,
+                                                     PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE};
+
+static const __u64 counter_configs[N_PERF_COUNTERS] = {PERF_COUNT_SW_TASK_CLOCK, PERF_COUNT_SW_CONTEXT_SWITCHES, PERF_COUNT_SW_CPU_MIGRATIONS,
+                                                       PERF_COUNT_SW_PAGE_FAULTS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                       PERF_COUNT_HW_CACHE_MISSES};
+
+/**
+ * @brief Invokes the perf_event_open() system call using its index in the kernel system call table, since glibc
+ * doesn't provide a wrapper for it.
+ * @param attr A pointer to the perf_event_attr struct that describes the counter.
+ * @param pid The pid of the task to count, 0 for the calling thread.
+ * @param cpu The CPU to count on, -1 for any CPU.
+ * @param group_fd The file descriptor of the leader of the group, -1 to create a new group.
+ * @param flags The flags of the system call.
+ * @return The file descriptor of the counter, or -1 in case of error.
+*/
+static int perf_event_open(struct perf_event_attr* attr, pid_t pid, int cpu, int group_fd, unsigned long flags){
+  return syscall(SYS_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+/**
+ * @brief Opens the counters of a group. The first counter that can be opened becomes the leader of the group.
+ * @param counters A pointer to a perf_counters struct.
+ * @param group A pointer to the perf_group struct to fill.
+ * @param first The index of the first counter of the group.
+ * @param last The index after the last counter of the group.
+ * @param group_name The name of the group used in the warnings.
+*/
+static void open_group(perf_counters* counters, perf_group* group, int first, int last, const char* group_name){
+  struct perf_event_attr attr;
+
+  group->leader_fd = -1;
+  for(int i = first; i < last; i++){
+    bzero(&attr, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = counter_types[i];
+    attr.config = counter_configs[i];
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.disabled = group->leader_fd == -1;
+    attr.exclude_hv = 1;
+
+    counters->fd[i] = perf_event_open(&attr, counters->pid, -1, group->leader_fd, PERF_FLAG_FD_CLOEXEC);
+    if(counters->fd[i] == -1 && (errno == EACCES || errno == EPERM)){
+      // An unprivileged user can count only the user space events when "perf_event_paranoid" is 2 or higher
+      attr.exclude_kernel = 1;
+      counters->fd[i] = perf_event_open(&attr, counters->pid, -1, group->leader_fd, PERF_FLAG_FD_CLOEXEC);
+    }
+    if(counters->fd[i] == -1){
+      // Not every PMU provides every hardware event: the missing ones are skipped
+      fprintf(stderr, "create_perf_counters: warning, the %s counter \"%s\" is not available (%s). Skipping ...\n", group_name,
+              counter_names[i], strerror(errno));
+      continue;
+    }
+    if(group->leader_fd == -1)
+      group->leader_fd = counters->fd[i];
+    group->members[group->n_members++] = i;
+  }
+}
+
+/**
+ * @brief Opens the counters for a task. They are disabled until "perf_counters_job_start()" is called. A warning is printed for each
+ * group that can't be opened, for example because of the "perf_event_paranoid" setting or a missing PMU, and the execution goes on
+ * without those counters.
+ * @param pid The pid of the task to count. Set it to 0 in order to use the calling thread.
+ * @return A pointer to a newly created perf_counters struct. This structure must be deallocated using the "destroy_perf_counters()"
+ * function when you're done with it.
+*/
+perf_counters* create_perf_counters(pid_t pid){
+  perf_counters* counters;
+
+  counters = (perf_counters*)calloc(1, sizeof(*counters));
+  if(counters == NULL){
+    fprintf(stderr, "create_perf_counters: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  counters->pid = pid;
+  open_group(counters, &counters->groups[0], 0, N_PERF_SOFTWARE, "software");
+  open_group(counters, &counters->groups[1], N_PERF_SOFTWARE, N_PERF_COUNTERS, "hardware");
+  return counters;
+}
+
+/**
+ * @brief Resets and enables the counters at the beginning of a job.
+ * @param counters A pointer to a perf_counters struct.
+*/
+void perf_counters_job_start(perf_counters* counters){
+  for(int g = 0; g < 2; g++){
+    if(counters->groups[g].leader_fd == -1)
+      continue;
+    if(ioctl(counters->groups[g].leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) == -1 ||
+       ioctl(counters->groups[g].leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == -1){
+      fprintf(stderr, "perf_counters_job_start: error enabling the counters. Aborting ...\n");
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+/**
+ * @brief Disables and reads the counters at the end of a job, setting them as extra metrics of an exec_info struct named "task_clock",
+ * "context_switches", "cpu_migrations", "page_faults", "cycles", "instructions" and "cache_misses". Only the available counters are set.
+ * @param counters A pointer to a perf_counters struct.
+ * @param e_info A pointer to an exec_info struct. Set it to NULL in order to only read the "values" field of the struct.
+*/
+void perf_counters_job_end(perf_counters* counters, exec_info* e_info){
+  // Layout of a group read: nr, time_enabled, time_running, one value per member
+  __u64 data[3 + N_PERF_COUNTERS];
+  perf_group* group;
+
+  for(int g = 0; g < 2; g++){
+    group = &counters->groups[g];
+    if(group->leader_fd == -1)
+      continue;
+    if(ioctl(group->leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP) == -1 ||
+       read(group->leader_fd, data, sizeof(data)) < (ssize_t)((3 + group->n_members) * sizeof(__u64))){
+      fprintf(stderr, "perf_counters_job_end: error reading the counters. Aborting ...\n");
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    for(int i = 0; i < group->n_members; i++){
+      // The group has been on the PMU only for a fraction of the job if it has been multiplexed with other events
+      if(data[2] != 0 && data[2] < data[1])
+        counters->values[group->members[i]] = (__u64)((double)data[3 + i] * data[1] / data[2]);
+      else
+        counters->values[group->members[i]] = data[3 + i];
+      if(e_info != NULL)
+        exec_info_set_metric(e_info, counter_names[group->members[i]], counters->values[group->members[i]]);
+    }
+  }
+}
+
+/**
+ * @brief Closes the counters and frees up the memory allocated for a perf_counters struct.
+ * @param counters A pointer to a perf_counters struct.
+*/
+void destroy_perf_counters(perf_counters* counters){
+  for(int g = 0; g < 2; g++){
+    for(int i = 0; i < counters->groups[g].n_members; i++)
+      close(counters->fd[counters->groups[g].members[i]]);
+  }
+  free(counters);
+}
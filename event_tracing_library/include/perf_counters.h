@@ -0,0 +1,69 @@
+#ifndef PERF_COUNTERS_H_
+#define PERF_COUNTERS_H_
+
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+
+#define PERF_TASK_CLOCK 0				///>Index of the task-clock software counter (nanoseconds spent on a CPU).
+#define PERF_CONTEXT_SWITCHES 1	///>Index of the context-switches software counter.
+#define PERF_CPU_MIGRATIONS 2		///>Index of the cpu-migrations software counter.
+#define PERF_PAGE_FAULTS 3			///>Index of the page-faults software counter.
+#define PERF_CYCLES 4						///>Index of the cycles hardware counter.
+#define PERF_INSTRUCTIONS 5			///>Index of the instructions hardware counter.
+#define PERF_CACHE_MISSES 6			///>Index of the cache-misses hardware counter.
+#define N_PERF_COUNTERS 7				///>Number of counters opened by a perf_counters struct.
+#define N_PERF_SOFTWARE 4				///>Number of software counters. They come first and form the first group, the hardware ones form the second group.
+
+/**
+ * @brief A group of counters read at once with a single read() on its leader.
+*/
+typedef struct perf_group{
+	int leader_fd; ///> File descriptor of the leader of the group, -1 if no counter of the group could be opened.
+	int n_members; ///> Number of counters opened in the group, the leader included.
+	int members[N_PERF_COUNTERS]; ///> Indexes of the counters of the group, in the order of the values returned by read().
+} perf_group;
+
+/**
+ * @brief A structure that counts, with perf_event_open(), the software and hardware events of a task during each job. The software
+ * counters and the hardware ones are opened as two groups, so that a missing PMU (e.g. in a virtual machine) only disables the
+ * latter, and the values of each group are read atomically. The counters that can't be opened are not logged.
+*/
+typedef struct perf_counters{
+	pid_t pid; ///> The pid of the counted task.
+	int fd[N_PERF_COUNTERS]; ///> File descriptors of the counters, -1 for the counters that are not available.
+	perf_group groups[2]; ///> The software group and the hardware group.
+	__u64 values[N_PERF_COUNTERS]; ///> The values of the last job, scaled if the counters have been multiplexed.
+} perf_counters;
+
+/**
+ * @brief Opens the counters for a task. They are disabled until "perf_counters_job_start()" is called. A warning is printed for each
+ * group that can't be opened, for example because of the "perf_event_paranoid" setting or a missing PMU, and the execution goes on
+ * without those counters.
+ * @param pid The pid of the task to count. Set it to 0 in order to use the calling thread.
+ * @return A pointer to a newly created perf_counters struct. This structure must be deallocated using the "destroy_perf_counters()"
+ * function when you're done with it.
+*/
+perf_counters* create_perf_counters(pid_t pid);
+
+/**
+ * @brief Resets and enables the counters at the beginning of a job.
+ * @param counters A pointer to a perf_counters struct.
+*/
+void perf_counters_job_start(perf_counters* counters);
+
+/**
+ * @brief Disables and reads the counters at the end of a job, setting them as extra metrics of an exec_info struct named "task_clock",
+ * "context_switches", "cpu_migrations", "page_faults", "cycles", "instructions" and "cache_misses". Only the available counters are set.
+ * @param counters A pointer to a perf_counters struct.
+ * @param e_info A pointer to an exec_info struct. Set it to NULL in order to only read the "values" field of the struct.
+*/
+void perf_counters_job_end(perf_counters* counters, exec_info* e_info);
+
+/**
+ * @brief Closes the counters and frees up the memory allocated for a perf_counters struct.
+ * @param counters A pointer to a perf_counters struct.
+*/
+void destroy_perf_counters(perf_counters* counters);
+
+#endif
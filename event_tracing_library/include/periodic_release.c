@@ -0,0 +1,124 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include "periodic_release.h"
+
+/**
+ * @brief Returns the current CLOCK_MONOTONIC time in nanoseconds.
+ * @return The current time in nanoseconds.
+*/
+static __u64 monotonic_time(void){
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief Creates a periodic_release struct whose first release is one period after now.
+ * @param period The period in nanoseconds.
+ * @return A pointer to a newly created periodic_release struct. This structure must be deallocated using the
+ * "destroy_periodic_release()" function when you're done with it.
+*/
+periodic_release* create_periodic_release(__u64 period){
+  periodic_release* release;
+
+  release = (periodic_release*)calloc(1, sizeof(*release));
+  if(release == NULL){
+    fprintf(stderr, "create_periodic_release: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  release->period = period;
+  release->release = monotonic_time() + period;
+  return release;
+}
+
+/**
+ * @brief Sleeps until the next release with clock_nanosleep(TIMER_ABSTIME) and measures the release jitter of the job that starts.
+ * @param release A pointer to a periodic_release struct.
+ * @return The release jitter in nanoseconds.
+*/
+long long periodic_release_wait(periodic_release* release){
+  struct timespec ts;
+  int ret;
+
+  ts.tv_sec = release->release / 1000000000ULL;
+  ts.tv_nsec = release->release % 1000000000ULL;
+  // An absolute sleep can simply be restarted after a signal, without drifting
+  while((ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)) == EINTR);
+  if(ret != 0){
+    errno = ret;
+    fprintf(stderr, "periodic_release_wait: error sleeping until the next release. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  release->start = monotonic_time();
+  release->jitter = (long long)(release->start - release->release);
+  release->n_jobs++;
+  return release->jitter;
+}
+
+/**
+ * @brief Marks the end of the job in progress, computes its response time and schedules the next release. It sets the extra metrics
+ * of an exec_info struct named "release_jitter", "response_time" (in nanoseconds), "period_overrun" (1 if the job ended after the
+ * release of the next one, 0 otherwise) and "skipped_releases".
+ * @param release A pointer to a periodic_release struct.
+ * @param e_info A pointer to an exec_info struct. Set it to NULL in order to only update the fields of the struct.
+ * @return 1 if the job overran its period, 0 otherwise.
+*/
+int periodic_release_job_end(periodic_release* release, exec_info* e_info){
+  __u64 end = monotonic_time();
+
+  release->response_time = (long long)(end - release->release);
+  release->overrun = end > release->release + release->period;
+  release->n_overruns += release->overrun;
+  // The next release is the first one of the schedule not yet elapsed
+  release->release += release->period;
+  release->skipped = 0;
+  while(release->release < end){
+    release->release += release->period;
+    release->skipped++;
+  }
+
+  if(e_info != NULL){
+    exec_info_set_metric(e_info, "release_jitter", release->jitter);
+    exec_info_set_metric(e_info, "response_time", release->response_time);
+    exec_info_set_metric(e_info, "period_overrun", release->overrun);
+    exec_info_set_metric(e_info, "skipped_releases", release->skipped);
+  }
+  return release->overrun;
+}
+
+/**
+ * @brief Writes the timing of the last job to the kernel trace, as a RELEASE_MARKER_FORMAT marker, using the trace_marker file
+ * descriptor kept open by a tracing_session struct. It must be called after "periodic_release_job_end()", so that the marker
+ * follows the end marker of the job.
+ * @param release A pointer to a periodic_release struct.
+ * @param session A pointer to a tracing_session struct.
+ * @param job_number The number of the job.
+*/
+void periodic_release_mark_session(periodic_release* release, tracing_session* session, int job_number){
+  char str[128];
+  int str_len;
+
+  str_len = snprintf(str, sizeof(str), RELEASE_MARKER_FORMAT, job_number, release->jitter, release->response_time, release->overrun);
+  if(write(session->trace_marker_fd, str, str_len) == -1){
+    fprintf(stderr, "periodic_release_mark_session: error writing to the trace_marker file. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Frees up the memory allocated for a periodic_release struct.
+ * @param release A pointer to a periodic_release struct.
+*/
+void destroy_periodic_release(periodic_release* release){
+  free(release);
+}
@@ -0,0 +1,71 @@
+#ifndef PERIODIC_RELEASE_H_
+#define PERIODIC_RELEASE_H_
+
+#include <time.h>
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+
+#define RELEASE_MARKER_FORMAT "release_job=%d jitter=%lld response=%lld overrun=%d"	///>Format of the marker written to the kernel trace after the end marker of each periodic job.
+
+/**
+ * @brief A structure that releases jobs periodically on an absolute CLOCK_MONOTONIC schedule, as a control loop does, and measures
+ * the timing of each job with respect to its ideal release: the release jitter (the time elapsed from the ideal release to the
+ * actual start of the job), the response time (from the ideal release to the end of the job) and whether the job overran its
+ * period. The releases are computed from the first one, so the sleep time never accumulates the errors of the previous jobs,
+ * and the releases already elapsed when a job overruns its period are skipped, keeping the phase of the schedule.
+*/
+typedef struct periodic_release{
+	__u64 period; ///> The period in nanoseconds.
+	__u64 release; ///> CLOCK_MONOTONIC time in nanoseconds of the ideal release of the job in progress, or of the next job.
+	__u64 start; ///> CLOCK_MONOTONIC time in nanoseconds of the actual start of the job in progress.
+	long long jitter; ///> The release jitter of the last job in nanoseconds.
+	long long response_time; ///> The response time of the last job in nanoseconds.
+	int overrun; ///> 1 if the last job overran its period, 0 otherwise.
+	int skipped; ///> Number of releases skipped after the last job because it overran its period.
+	int n_jobs; ///> Number of jobs released.
+	int n_overruns; ///> Number of jobs that overran their period.
+} periodic_release;
+
+/**
+ * @brief Creates a periodic_release struct whose first release is one period after now.
+ * @param period The period in nanoseconds.
+ * @return A pointer to a newly created periodic_release struct. This structure must be deallocated using the
+ * "destroy_periodic_release()" function when you're done with it.
+*/
+periodic_release* create_periodic_release(__u64 period);
+
+/**
+ * @brief Sleeps until the next release with clock_nanosleep(TIMER_ABSTIME) and measures the release jitter of the job that starts.
+ * @param release A pointer to a periodic_release struct.
+ * @return The release jitter in nanoseconds.
+*/
+long long periodic_release_wait(periodic_release* release);
+
+/**
+ * @brief Marks the end of the job in progress, computes its response time and schedules the next release. It sets the extra metrics
+ * of an exec_info struct named "release_jitter", "response_time" (in nanoseconds), "period_overrun" (1 if the job ended after the
+ * release of the next one, 0 otherwise) and "skipped_releases".
+ * @param release A pointer to a periodic_release struct.
+ * @param e_info A pointer to an exec_info struct. Set it to NULL in order to only update the fields of the struct.
+ * @return 1 if the job overran its period, 0 otherwise.
+*/
+int periodic_release_job_end(periodic_release* release, exec_info* e_info);
+
+/**
+ * @brief Writes the timing of the last job to the kernel trace, as a RELEASE_MARKER_FORMAT marker, using the trace_marker file
+ * descriptor kept open by a tracing_session struct. It must be called after "periodic_release_job_end()", so that the marker
+ * follows the end marker of the job.
+ * @param release A pointer to a periodic_release struct.
+ * @param session A pointer to a tracing_session struct.
+ * @param job_number The number of the job.
+*/
+void periodic_release_mark_session(periodic_release* release, tracing_session* session, int job_number);
+
+/**
+ * @brief Frees up the memory allocated for a periodic_release struct.
+ * @param release A pointer to a periodic_release struct.
+*/
+void destroy_periodic_release(periodic_release* release);
+
+#endif
@@ -0,0 +1,717 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "raw_trace.h"
+
+#define RB_TYPE_PADDING 29		// Type of a ring buffer event used to fill the unused part of a page or a discarded event
+#define RB_TYPE_TIME_EXTEND 30	// Type of a ring buffer event that extends the time delta of the following event
+#define RB_TYPE_TIME_STAMP 31	// Type of a ring buffer event that contains an absolute timestamp
+#define RB_TS_SHIFT 27				// Number of bits of the time delta stored in the header of a ring buffer event
+#define RB_COMMIT_MASK ((1 << 27) - 1) // Mask used to remove the flags stored in the commit field of a ring buffer page
+
+// Relative paths, within the tracefs events directory, of the format files of the events known by the library.
+static const char* format_paths[N_RAW_FORMATS] = {
+  "sched/sched_switch/format",
+  "sched/sched_wakeup/format",
+  "sched/sched_migrate_task/format",
+  "ftrace/print/format",
+  "ftrace/raw_data/format"
+};
+
+// Names of the events known by the library, used to name the copies of their format files.
+static const char* format_names[N_RAW_FORMATS] = {
+  "sched_switch",
+  "sched_wakeup",
+  "sched_migrate_task",
+  "print",
+  "raw_data"
+};
+
+/**
+ * @brief Copies a file of the tracefs into another file.
+ * @param src_path The path to the file to copy.
+ * @param dst_path The path to the copy. It will be created or truncated.
+ * @return 0 on success, -1 if the source file couldn't be opened.
+*/
+static int copy_tracefs_file(const char* src_path, const char* dst_path){
+  int fd_read, fd_write;
+  char buffer[STR_BUFFER_SIZE];
+  ssize_t bytes_read;
+
+  fd_read = open(src_path, O_RDONLY);
+  if(fd_read == -1){
+    return -1;
+  }
+  fd_write = open(dst_path, O_WRONLY | O_CREAT | O_TRUNC, 0777);
+  if(fd_write == -1){
+    fprintf(stderr, "capture_raw_trace: error opening \"%s\" file. Aborting ...\n", dst_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  while((bytes_read = read(fd_read, buffer, STR_BUFFER_SIZE)) > 0){
+    if(write(fd_write, buffer, bytes_read) != bytes_read){
+      fprintf(stderr, "capture_raw_trace: error writing to \"%s\" file. Aborting ...\n", dst_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+  }
+  close(fd_read);
+  close(fd_write);
+  return 0;
+}
+
+/**
+ * @brief Moves all the full pages available in a trace_pipe_raw file to another file through a pipe. The pages that are only
+ * partially filled can't be spliced, so if requested they are read with a plain read() at the end.
+ * @param fd_read The file descriptor of a trace_pipe_raw file opened in non-blocking mode.
+ * @param fd_write The file descriptor of the output file.
+ * @param pipe_fd The file descriptors of a pipe.
+ * @param page_size The size in bytes of a ring buffer page.
+ * @param page A buffer of "page_size" bytes used for the pages that can't be spliced. It is used only if "flush" is 1.
+ * @param file_path The path to the output file, used for error messages.
+ * @param flush A short integer value. Set it to 1 in order to move also the partially filled pages, 0 otherwise.
+ * @return The number of bytes moved to the output file.
+*/
+long splice_raw_pages(int fd_read, int fd_write, int pipe_fd[2], long page_size, char* page, const char* file_path, short flush){
+  ssize_t bytes_spliced, bytes_moved;
+  long total = 0;
+
+  while((bytes_spliced = splice(fd_read, NULL, pipe_fd[1], NULL, page_size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK)) > 0){
+    while(bytes_spliced > 0){
+      bytes_moved = splice(pipe_fd[0], NULL, fd_write, NULL, bytes_spliced, SPLICE_F_MOVE);
+      if(bytes_moved <= 0){
+        fprintf(stderr, "capture_raw_trace: error writing to \"%s\" file. Aborting ...\n", file_path);
+        PRINT_ERROR;
+        exit(EXIT_FAILURE);
+      }
+      bytes_spliced -= bytes_moved;
+      total += bytes_moved;
+    }
+  }
+  if(bytes_spliced == -1 && errno != EAGAIN && errno != EINTR){
+    fprintf(stderr, "capture_raw_trace: error splicing the raw trace to \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  while(flush && (bytes_moved = read(fd_read, page, page_size)) > 0){
+    if(write(fd_write, page, bytes_moved) != bytes_moved){
+      fprintf(stderr, "capture_raw_trace: error writing to \"%s\" file. Aborting ...\n", file_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    total += bytes_moved;
+  }
+  return total;
+}
+
+/**
+ * @brief Copies the header_page file and the format files of the events known by the library from a tracefs to a directory,
+ * so that the raw traces saved in that directory can be decoded offline.
+ * @param tracing_path The path to the root directory of the tracefs.
+ * @param dir_path The path to the directory where to save the files. It must already exist.
+*/
+void save_raw_trace_formats(const char* tracing_path, const char* dir_path){
+  char src_path[PATH_MAX];
+  char dst_path[PATH_MAX];
+  char file_name[NAME_MAX];
+
+  snprintf(src_path, PATH_MAX, "%s/events/header_page", tracing_path);
+  snprintf(dst_path, PATH_MAX, "%s/%s", dir_path, HEADER_PAGE_FILENAME);
+  copy_tracefs_file(src_path, dst_path);
+  for(int i = 0; i < N_RAW_FORMATS; i++){
+    snprintf(src_path, PATH_MAX, "%s/events/%s", tracing_path, format_paths[i]);
+    snprintf(file_name, NAME_MAX, FORMAT_FILENAME, format_names[i]);
+    snprintf(dst_path, PATH_MAX, "%s/%s", dir_path, file_name);
+    copy_tracefs_file(src_path, dst_path);
+  }
+}
+
+/**
+ * @brief Moves the raw content of the per-CPU ring buffers of a tracefs into one file per CPU, using splice() so that the pages
+ * are never copied in user space nor pretty-printed by the kernel. The format files needed to decode the traces offline
+ * are copied too.
+ * @param tracing_path The path to the root directory of the tracefs.
+ * @param dir_path The path to the directory where to save the raw traces. It must already exist.
+*/
+void capture_raw_trace(const char* tracing_path, const char* dir_path){
+  char src_path[PATH_MAX];
+  char dst_path[PATH_MAX];
+  char file_name[NAME_MAX];
+  long page_size = sysconf(_SC_PAGESIZE);
+  int n_cpus = sysconf(_SC_NPROCESSORS_CONF);
+  int pipe_fd[2];
+  int fd_read, fd_write;
+  char* page;
+
+  save_raw_trace_formats(tracing_path, dir_path);
+
+  page = (char*)malloc(page_size);
+  if(page == NULL){
+    fprintf(stderr, "capture_raw_trace: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  if(pipe(pipe_fd) == -1){
+    fprintf(stderr, "capture_raw_trace: error creating a pipe. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  for(int cpu = 0; cpu < n_cpus; cpu++){
+    snprintf(file_name, NAME_MAX, RAW_TRACE_FILENAME, cpu);
+    snprintf(dst_path, PATH_MAX, "%s/%s", dir_path, file_name);
+    fd_write = open(dst_path, O_WRONLY | O_CREAT | O_TRUNC, 0777);
+    if(fd_write == -1){
+      fprintf(stderr, "capture_raw_trace: error opening \"%s\" file. Aborting ...\n", dst_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+
+    // An offline CPU has no per_cpu directory: its raw trace is left empty
+    snprintf(src_path, PATH_MAX, "%s/per_cpu/cpu%d/trace_pipe_raw", tracing_path, cpu);
+    fd_read = open(src_path, O_RDONLY | O_NONBLOCK);
+    if(fd_read == -1 && errno != ENOENT){
+      fprintf(stderr, "capture_raw_trace: error opening \"%s\" file. Aborting ...\n", src_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    if(fd_read != -1){
+      splice_raw_pages(fd_read, fd_write, pipe_fd, page_size, page, dst_path, 1);
+      close(fd_read);
+    }
+    close(fd_write);
+  }
+
+  close(pipe_fd[0]);
+  close(pipe_fd[1]);
+  free(page);
+}
+
+/**
+ * @brief Loads the fields of an event from a format file of the tracefs (or from one of its copies). The same syntax is used
+ * by the header_page file, so this function is used to parse that file too.
+ * @param file_path The path to the format file.
+ * @param format A pointer to a raw_event_format struct that will be filled. If the file doesn't exist its "id" field is set to -1.
+*/
+static void load_event_format(const char* file_path, raw_event_format* format){
+  FILE* file;
+  char line[STR_BUFFER_SIZE];
+  char *field, *semicolon, *name_start, *name_end, *offset, *size;
+  int name_len;
+
+  format->id = -1;
+  format->n_fields = 0;
+  file = fopen(file_path, "r");
+  if(file == NULL){
+    return;
+  }
+
+  while(fgets(line, STR_BUFFER_SIZE, file) != NULL){
+    if(sscanf(line, "ID: %d", &format->id) == 1){
+      continue;
+    }
+    field = strstr(line, "field:");
+    if(field == NULL || format->n_fields == RAW_MAX_FIELDS){
+      continue;
+    }
+    semicolon = strchr(field, ';');
+    offset = strstr(line, "offset:");
+    size = strstr(line, "size:");
+    if(semicolon == NULL || offset == NULL || size == NULL){
+      continue;
+    }
+
+    // The name of the field is the last identifier of the declaration, without the array size
+    name_end = memchr(field, '[', semicolon - field);
+    if(name_end == NULL){
+      name_end = semicolon;
+    }
+    name_start = name_end;
+    while(name_start > field && (isalnum((unsigned char)name_start[-1]) || name_start[-1] == '_')){
+      name_start--;
+    }
+    name_len = name_end - name_start;
+    if(name_len == 0 || name_len >= RAW_MAX_FIELD_NAME){
+      continue;
+    }
+    memcpy(format->fields[format->n_fields].name, name_start, name_len);
+    format->fields[format->n_fields].name[name_len] = '\0';
+    format->fields[format->n_fields].offset = atoi(offset + strlen("offset:"));
+    format->fields[format->n_fields].size = atoi(size + strlen("size:"));
+    format->n_fields++;
+  }
+  fclose(file);
+}
+
+/**
+ * @brief Searches a field of an event format by name.
+ * @param format A pointer to a raw_event_format struct.
+ * @param name A pointer to a string that specifies the name of the field.
+ * @return A pointer to the field, or NULL if it doesn't exist.
+*/
+static const raw_event_field* find_field(const raw_event_format* format, const char* name){
+  for(int i = 0; i < format->n_fields; i++){
+    if(strcmp(format->fields[i].name, name) == 0){
+      return &format->fields[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Reads a signed integer of 1, 2, 4 or 8 bytes stored in native byte order.
+ * @param data A pointer to the first byte of the integer.
+ * @param size The size in bytes of the integer.
+ * @return The value of the integer.
+*/
+static long long read_integer(const unsigned char* data, int size){
+  __s8 v8;
+  __s16 v16;
+  __s32 v32;
+  __s64 v64;
+
+  switch(size){
+    case 1:
+      memcpy(&v8, data, 1);
+      return v8;
+    case 2:
+      memcpy(&v16, data, 2);
+      return v16;
+    case 4:
+      memcpy(&v32, data, 4);
+      return v32;
+    default:
+      memcpy(&v64, data, 8);
+      return v64;
+  }
+}
+
+/**
+ * @brief Reads the next ring buffer page of a per-CPU raw trace.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param stream A pointer to the raw_cpu_stream struct of the CPU.
+ * @return 1 if a page has been read, 0 if the end of the trace has been reached.
+*/
+static int read_page(raw_trace_reader* reader, raw_cpu_stream* stream){
+  ssize_t bytes_read;
+  int total = 0;
+  __u64 commit;
+
+  while(total < reader->page_size){
+    bytes_read = read(stream->fd, stream->page + total, reader->page_size - total);
+    if(bytes_read == -1){
+      fprintf(stderr, "raw_trace_next: error reading the raw trace of cpu %d. Aborting ...\n", stream->event.cpu);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    if(bytes_read == 0){
+      return 0;
+    }
+    total += bytes_read;
+  }
+
+  memcpy(&stream->page_timestamp, stream->page, sizeof(stream->page_timestamp));
+  commit = (__u64)read_integer(stream->page + reader->commit_offset, reader->commit_size);
+  stream->page_size = reader->data_offset + (commit & RB_COMMIT_MASK);
+  if(stream->page_size > reader->page_size){
+    stream->page_size = reader->page_size;
+  }
+  stream->offset = reader->data_offset;
+  return 1;
+}
+
+/**
+ * @brief Decodes the next data event of a per-CPU raw trace, skipping padding and timestamp events.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param stream A pointer to the raw_cpu_stream struct of the CPU.
+ * @return 1 if an event has been decoded in the "event" field of the stream, 0 if the end of the trace has been reached.
+*/
+static int advance_stream(raw_trace_reader* reader, raw_cpu_stream* stream){
+  __u32 header, type_len, delta, array0;
+
+  for(;;){
+    if(stream->offset + (int)sizeof(header) > stream->page_size){
+      if(!read_page(reader, stream)){
+        return 0;
+      }
+      continue;
+    }
+
+    memcpy(&header, stream->page + stream->offset, sizeof(header));
+    type_len = header & 0x1f;
+    delta = header >> 5;
+    array0 = 0;
+    if(stream->offset + 8 <= reader->page_size){
+      memcpy(&array0, stream->page + stream->offset + 4, sizeof(array0));
+    }
+
+    switch(type_len){
+      case RB_TYPE_PADDING:
+        if(delta == 0){
+          stream->offset = stream->page_size;
+        }else{
+          stream->page_timestamp += delta;
+          stream->offset += 4 + array0;
+        }
+        break;
+      case RB_TYPE_TIME_EXTEND:
+        stream->page_timestamp += delta + ((__u64)array0 << RB_TS_SHIFT);
+        stream->offset += 8;
+        break;
+      case RB_TYPE_TIME_STAMP:
+        stream->page_timestamp = (stream->page_timestamp & ~((1ULL << 59) - 1)) | ((__u64)array0 << RB_TS_SHIFT) | delta;
+        stream->offset += 8;
+        break;
+      case 0:
+        stream->page_timestamp += delta;
+        stream->event.data = stream->page + stream->offset + 8;
+        stream->event.size = array0 - 4;
+        stream->offset += 4 + array0;
+        break;
+      default:
+        stream->page_timestamp += delta;
+        stream->event.data = stream->page + stream->offset + 4;
+        stream->event.size = type_len * 4;
+        stream->offset += 4 + type_len * 4;
+        break;
+    }
+
+    if(type_len < RB_TYPE_PADDING){
+      if(stream->event.size < 8 || stream->offset > stream->page_size){
+        // Corrupted or truncated event: skip the rest of the page
+        stream->offset = stream->page_size;
+        continue;
+      }
+      stream->event.timestamp = stream->page_timestamp;
+      stream->event.type = (int)read_integer(stream->event.data, 2) & 0xffff;
+      stream->event.pid = (int)read_integer(stream->event.data + 4, 4);
+      return 1;
+    }
+  }
+}
+
+/**
+ * @brief Compares the next events of two streams of the reader.
+ * @return A value different from 0 if the next event of the stream "a" happened before the one of the stream "b".
+*/
+static int heap_less(raw_trace_reader* reader, int a, int b){
+  return reader->streams[a].event.timestamp < reader->streams[b].event.timestamp;
+}
+
+/**
+ * @brief Inserts a stream in the min-heap of the reader.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param index The index of the stream in the "streams" array.
+*/
+static void heap_push(raw_trace_reader* reader, int index){
+  int child = reader->heap_size++;
+  int parent;
+
+  reader->heap[child] = index;
+  while(child > 0){
+    parent = (child - 1) / 2;
+    if(!heap_less(reader, reader->heap[child], reader->heap[parent])){
+      break;
+    }
+    index = reader->heap[parent];
+    reader->heap[parent] = reader->heap[child];
+    reader->heap[child] = index;
+    child = parent;
+  }
+}
+
+/**
+ * @brief Removes from the min-heap of the reader the stream with the oldest next event.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @return The index of the stream in the "streams" array.
+*/
+static int heap_pop(raw_trace_reader* reader){
+  int top = reader->heap[0];
+  int parent = 0, child, tmp;
+
+  reader->heap[0] = reader->heap[--reader->heap_size];
+  while((child = 2 * parent + 1) < reader->heap_size){
+    if(child + 1 < reader->heap_size && heap_less(reader, reader->heap[child + 1], reader->heap[child])){
+      child++;
+    }
+    if(!heap_less(reader, reader->heap[child], reader->heap[parent])){
+      break;
+    }
+    tmp = reader->heap[parent];
+    reader->heap[parent] = reader->heap[child];
+    reader->heap[child] = tmp;
+    parent = child;
+  }
+  return top;
+}
+
+/**
+ * @brief Opens the raw per-CPU traces saved in a directory by "capture_raw_trace()".
+ * @param dir_path The path to the directory that contains the raw traces.
+ * @return A pointer to a newly created raw_trace_reader struct. This structure must be deallocated using the "raw_trace_close()"
+ * function when you're done with it.
+*/
+raw_trace_reader* raw_trace_open(const char* dir_path){
+  raw_trace_reader* reader;
+  raw_event_format header_page;
+  const raw_event_field *commit, *data;
+  char file_path[PATH_MAX];
+  char file_name[NAME_MAX];
+
+  reader = (raw_trace_reader*)malloc(sizeof(*reader));
+  if(reader == NULL){
+    fprintf(stderr, "raw_trace_open: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  bzero(reader, sizeof(*reader));
+  reader->last_cpu = -1;
+
+  // Layout of the ring buffer pages. Defaults are the ones of the running kernel.
+  reader->commit_offset = sizeof(__u64);
+  reader->commit_size = sizeof(long);
+  reader->data_offset = sizeof(__u64) + sizeof(long);
+  reader->page_size = sysconf(_SC_PAGESIZE);
+  snprintf(file_path, PATH_MAX, "%s/%s", dir_path, HEADER_PAGE_FILENAME);
+  load_event_format(file_path, &header_page);
+  commit = find_field(&header_page, "commit");
+  data = find_field(&header_page, "data");
+  if(commit != NULL && data != NULL){
+    reader->commit_offset = commit->offset;
+    reader->commit_size = commit->size;
+    reader->data_offset = data->offset;
+    reader->page_size = data->offset + data->size;
+  }
+
+  for(int i = 0; i < N_RAW_FORMATS; i++){
+    snprintf(file_name, NAME_MAX, FORMAT_FILENAME, format_names[i]);
+    snprintf(file_path, PATH_MAX, "%s/%s", dir_path, file_name);
+    load_event_format(file_path, &reader->formats[i]);
+  }
+
+  for(;;){
+    snprintf(file_name, NAME_MAX, RAW_TRACE_FILENAME, reader->n_cpus);
+    snprintf(file_path, PATH_MAX, "%s/%s", dir_path, file_name);
+    if(access(file_path, F_OK) == -1){
+      break;
+    }
+    reader->n_cpus++;
+  }
+  if(reader->n_cpus == 0){
+    fprintf(stderr, "raw_trace_open: no raw traces found in \"%s\". Aborting ...\n", dir_path);
+    exit(EXIT_FAILURE);
+  }
+
+  reader->streams = (raw_cpu_stream*)calloc(reader->n_cpus, sizeof(*reader->streams));
+  reader->heap = (int*)calloc(reader->n_cpus, sizeof(*reader->heap));
+  if(reader->streams == NULL || reader->heap == NULL){
+    fprintf(stderr, "raw_trace_open: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  for(int cpu = 0; cpu < reader->n_cpus; cpu++){
+    raw_cpu_stream* stream = &reader->streams[cpu];
+    snprintf(file_name, NAME_MAX, RAW_TRACE_FILENAME, cpu);
+    snprintf(file_path, PATH_MAX, "%s/%s", dir_path, file_name);
+    stream->fd = open(file_path, O_RDONLY);
+    stream->page = (unsigned char*)malloc(reader->page_size);
+    if(stream->fd == -1 || stream->page == NULL){
+      fprintf(stderr, "raw_trace_open: error opening \"%s\" file. Aborting ...\n", file_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    stream->event.cpu = cpu;
+    if(advance_stream(reader, stream)){
+      heap_push(reader, cpu);
+    }
+  }
+  return reader;
+}
+
+/**
+ * @brief Retrieves the next event, in timestamp order, among all the per-CPU raw traces.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param event A pointer to a raw_event struct that will be filled with the next event.
+ * @return 1 if an event has been retrieved, 0 if there are no events left.
+*/
+int raw_trace_next(raw_trace_reader* reader, raw_event* event){
+  // The stream of the previous event is advanced only now, since that event points into its page
+  if(reader->last_cpu != -1){
+    if(advance_stream(reader, &reader->streams[reader->last_cpu])){
+      heap_push(reader, reader->last_cpu);
+    }
+    reader->last_cpu = -1;
+  }
+  if(reader->heap_size == 0){
+    return 0;
+  }
+  reader->last_cpu = heap_pop(reader);
+  *event = reader->streams[reader->last_cpu].event;
+  return 1;
+}
+
+/**
+ * @brief Closes all the files opened by a raw_trace_reader struct and frees up the memory allocated for it.
+ * @param reader A pointer to a raw_trace_reader struct.
+*/
+void raw_trace_close(raw_trace_reader* reader){
+  for(int cpu = 0; cpu < reader->n_cpus; cpu++){
+    close(reader->streams[cpu].fd);
+    free(reader->streams[cpu].page);
+  }
+  free(reader->streams);
+  free(reader->heap);
+  free(reader);
+}
+
+/**
+ * @brief Allows to know which of the events known by the library an event is.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param event A pointer to a raw_event struct.
+ * @return E_SCHED_SWITCH, E_SCHED_WAKEUP, E_SCHED_MIGRATE_TASK, E_PRINT or E_RAW_DATA, 0 if the event is unknown.
+*/
+int raw_trace_event_flag(raw_trace_reader* reader, const raw_event* event){
+  for(int i = 0; i < N_RAW_FORMATS; i++){
+    if(reader->formats[i].id != -1 && reader->formats[i].id == event->type){
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Retrieves the value of a numeric field of an event using its format.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param event A pointer to a raw_event struct.
+ * @param event_flag The flag of the event, as returned by "raw_trace_event_flag()".
+ * @param field_name A pointer to a string that specifies the name of the field.
+ * @param value A pointer to a long long integer where to store the value of the field.
+ * @return 1 if the field has been found, 0 otherwise.
+*/
+int raw_trace_field(raw_trace_reader* reader, const raw_event* event, int event_flag, const char* field_name, long long* value){
+  const raw_event_field* field;
+
+  if(event_flag < 1 || event_flag > N_RAW_FORMATS){
+    return 0;
+  }
+  field = find_field(&reader->formats[event_flag - 1], field_name);
+  if(field == NULL || field->size > 8 || field->offset + field->size > event->size){
+    return 0;
+  }
+  *value = read_integer(event->data + field->offset, field->size);
+  return 1;
+}
+
+/**
+ * @brief Copies a string field of an event, always terminating it.
+ * @return 1 if the field has been found, 0 otherwise.
+*/
+static int copy_string_field(const raw_event_format* format, const raw_event* event, const char* field_name, char* dst, int dst_size){
+  const raw_event_field* field = find_field(format, field_name);
+  int len;
+
+  if(field == NULL || field->offset + field->size > event->size){
+    return 0;
+  }
+  len = field->size < dst_size - 1 ? field->size : dst_size - 1;
+  memcpy(dst, event->data + field->offset, len);
+  dst[len] = '\0';
+  return 1;
+}
+
+/**
+ * @brief Decodes the fields of a sched_switch event.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param event A pointer to a raw_event struct of type E_SCHED_SWITCH.
+ * @param sched_switch A pointer to a raw_sched_switch struct that will be filled with the decoded fields.
+ * @return 1 if the event has been decoded, 0 otherwise.
+*/
+int raw_trace_decode_sched_switch(raw_trace_reader* reader, const raw_event* event, raw_sched_switch* sched_switch){
+  const raw_event_format* format = &reader->formats[E_SCHED_SWITCH - 1];
+  long long prev_pid, prev_prio, prev_state, next_pid, next_prio;
+
+  if(format->id != event->type ||
+     !copy_string_field(format, event, "prev_comm", sched_switch->prev_comm, sizeof(sched_switch->prev_comm)) ||
+     !copy_string_field(format, event, "next_comm", sched_switch->next_comm, sizeof(sched_switch->next_comm)) ||
+     !raw_trace_field(reader, event, E_SCHED_SWITCH, "prev_pid", &prev_pid) ||
+     !raw_trace_field(reader, event, E_SCHED_SWITCH, "prev_prio", &prev_prio) ||
+     !raw_trace_field(reader, event, E_SCHED_SWITCH, "prev_state", &prev_state) ||
+     !raw_trace_field(reader, event, E_SCHED_SWITCH, "next_pid", &next_pid) ||
+     !raw_trace_field(reader, event, E_SCHED_SWITCH, "next_prio", &next_prio)){
+    return 0;
+  }
+  sched_switch->prev_pid = prev_pid;
+  sched_switch->prev_prio = prev_prio;
+  sched_switch->prev_state = prev_state;
+  sched_switch->next_pid = next_pid;
+  sched_switch->next_prio = next_prio;
+  return 1;
+}
+
+/**
+ * @brief Decodes a job marker written either by "trace_mark_job()" (print event) or by "trace_mark_job_raw_session()"
+ * (raw_data event).
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param event A pointer to a raw_event struct.
+ * @param marker A pointer to a raw_job_marker struct that will be filled with the decoded marker. For text markers the
+ * "payload" field is always 0, and the "worker" field is 0 unless the marker has been written by "trace_mark_worker_job_session()".
+ * @return 1 if the event is a job marker, 0 otherwise.
+*/
+int raw_trace_decode_job_marker(raw_trace_reader* reader, const raw_event* event, raw_job_marker* marker){
+  const raw_event_field* field;
+  char buf[32];
+  char *number, *end_ptr;
+  int len;
+  int event_flag = raw_trace_event_flag(reader, event);
+
+  if(event_flag == E_RAW_DATA){
+    field = find_field(&reader->formats[E_RAW_DATA - 1], "id");
+    if(field == NULL || field->offset + (int)sizeof(*marker) > event->size){
+      return 0;
+    }
+    memcpy(marker, event->data + field->offset, sizeof(*marker));
+    return marker->id == RAW_MARKER_ID && (marker->state == START || marker->state == STOP);
+  }
+
+  if(event_flag == E_PRINT){
+    field = find_field(&reader->formats[E_PRINT - 1], "buf");
+    if(field == NULL || field->offset >= event->size){
+      return 0;
+    }
+    len = event->size - field->offset < (int)sizeof(buf) - 1 ? event->size - field->offset : (int)sizeof(buf) - 1;
+    memcpy(buf, event->data + field->offset, len);
+    buf[len] = '\0';
+    bzero(marker, sizeof(*marker));
+    if(strncmp(buf, "start_job=", strlen("start_job=")) == 0){
+      marker->state = START;
+      number = buf + strlen("start_job=");
+    }else if(strncmp(buf, "end_job=", strlen("end_job=")) == 0){
+      marker->state = STOP;
+      number = buf + strlen("end_job=");
+    }else{
+      return 0;
+    }
+    marker->id = RAW_MARKER_ID;
+    marker->job_number = strtol(number, &end_ptr, 10);
+    if(end_ptr == number)
+      return 0;
+    // The markers of the concurrent workers look like "start_job=<worker>:<job_number>"
+    if(*end_ptr == ':'){
+      marker->worker = marker->job_number;
+      number = end_ptr + 1;
+      marker->job_number = strtol(number, &end_ptr, 10);
+    }
+    return end_ptr != number;
+  }
+  return 0;
+}
@@ -0,0 +1,185 @@
+#ifndef RAW_TRACE_H_
+#define RAW_TRACE_H_
+
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+
+#define E_PRINT 4		///>Macro used to refer to the ftrace print event, written by the trace_marker file.
+#define E_RAW_DATA 5	///>Macro used to refer to the ftrace raw_data event, written by the trace_marker_raw file.
+#define N_RAW_FORMATS 5	///>Number of event formats loaded by a raw_trace_reader. They are indexed by the event flag minus one.
+
+#define RAW_MAX_FIELDS 16	///>Max number of fields of an event format kept by a raw_event_format struct.
+#define RAW_MAX_FIELD_NAME 32	///>Max length of the name of a field of an event format.
+#define RAW_COMM_LEN 16	///>Length of the command name fields of the sched events.
+
+#define RAW_TRACE_FILENAME "trace_cpu%d.raw"	///>Name of the file, within an execution directory, that contains the raw trace of a CPU.
+#define HEADER_PAGE_FILENAME "header_page"		///>Name of the file, within an execution directory, that contains a copy of the tracefs events/header_page file.
+#define FORMAT_FILENAME "%s.format"	///>Name of the file, within an execution directory, that contains a copy of the format file of an event.
+
+/**
+ * @brief A structure that describes a field of an event as reported by its format file in the tracefs.
+*/
+typedef struct raw_event_field{
+	char name[RAW_MAX_FIELD_NAME]; ///> The name of the field.
+	int offset; ///> The offset in bytes of the field from the beginning of the event data.
+	int size; ///> The size in bytes of the field.
+} raw_event_field;
+
+/**
+ * @brief A structure that describes the binary layout of an event as reported by its format file in the tracefs.
+*/
+typedef struct raw_event_format{
+	int id; ///> The identifier of the event, stored in the common_type field of each event. It is -1 if the format is not available.
+	int n_fields; ///> The number of fields stored in the "fields" array.
+	raw_event_field fields[RAW_MAX_FIELDS]; ///> The fields of the event.
+} raw_event_format;
+
+/**
+ * @brief A structure that contains a single event read from the raw per-CPU traces. The "data" field points to a buffer owned by
+ * the reader and it's valid only until the next call to "raw_trace_next()".
+*/
+typedef struct raw_event{
+	int cpu; ///> The CPU that recorded the event.
+	__u64 timestamp; ///> The timestamp of the event in nanoseconds.
+	int type; ///> The identifier of the event (common_type field).
+	int pid; ///> The pid of the task that was running when the event was recorded (common_pid field).
+	const unsigned char* data; ///> A pointer to the event data, starting from the common fields.
+	int size; ///> The size in bytes of the event data.
+} raw_event;
+
+/**
+ * @brief A structure that contains the decoded fields of a sched_switch event.
+*/
+typedef struct raw_sched_switch{
+	char prev_comm[RAW_COMM_LEN + 1]; ///> The command name of the task that left the CPU.
+	pid_t prev_pid; ///> The pid of the task that left the CPU.
+	int prev_prio; ///> The priority of the task that left the CPU.
+	long prev_state; ///> The state of the task that left the CPU.
+	char next_comm[RAW_COMM_LEN + 1]; ///> The command name of the task that got the CPU.
+	pid_t next_pid; ///> The pid of the task that got the CPU.
+	int next_prio; ///> The priority of the task that got the CPU.
+} raw_sched_switch;
+
+/**
+ * @brief A structure that keeps the state of one of the per-CPU raw traces merged by a raw_trace_reader.
+*/
+typedef struct raw_cpu_stream{
+	int fd; ///> File descriptor of the raw trace file of the CPU.
+	unsigned char* page; ///> The page currently decoded.
+	__u64 page_timestamp; ///> Timestamp of the last event decoded in the current page.
+	int page_size; ///> Number of valid data bytes of the current page.
+	int offset; ///> Offset of the next event to decode in the current page.
+	raw_event event; ///> The next event of this CPU, not yet returned by the reader.
+} raw_cpu_stream;
+
+/**
+ * @brief A structure used to read the raw per-CPU traces saved by "log_trace()" with the USE_TRACE_RAW mode. The events of all
+ * the CPUs are merged by timestamp.
+*/
+typedef struct raw_trace_reader{
+	int n_cpus; ///> Number of per-CPU raw traces.
+	int page_size; ///> Size in bytes of a ring buffer page.
+	int commit_offset; ///> Offset of the commit field in the header of a ring buffer page.
+	int commit_size; ///> Size of the commit field in the header of a ring buffer page.
+	int data_offset; ///> Offset of the events in a ring buffer page.
+	raw_cpu_stream* streams; ///> The per-CPU streams.
+	int* heap; ///> A min-heap of indexes of the "streams" array, ordered by the timestamp of their next event.
+	int heap_size; ///> Number of streams with events left.
+	int last_cpu; ///> Index of the stream whose event was returned by the last call to "raw_trace_next()", or -1.
+	raw_event_format formats[N_RAW_FORMATS]; ///> Formats of the events known by the library, indexed by the event flag minus one.
+} raw_trace_reader;
+
+/**
+ * @brief Copies the header_page file and the format files of the events known by the library from a tracefs to a directory,
+ * so that the raw traces saved in that directory can be decoded offline.
+ * @param tracing_path The path to the root directory of the tracefs.
+ * @param dir_path The path to the directory where to save the files. It must already exist.
+*/
+void save_raw_trace_formats(const char* tracing_path, const char* dir_path);
+
+/**
+ * @brief Moves all the full pages available in a trace_pipe_raw file to another file through a pipe. The pages that are only
+ * partially filled can't be spliced, so if requested they are read with a plain read() at the end.
+ * @param fd_read The file descriptor of a trace_pipe_raw file opened in non-blocking mode.
+ * @param fd_write The file descriptor of the output file.
+ * @param pipe_fd The file descriptors of a pipe.
+ * @param page_size The size in bytes of a ring buffer page.
+ * @param page A buffer of "page_size" bytes used for the pages that can't be spliced. It is used only if "flush" is 1.
+ * @param file_path The path to the output file, used for error messages.
+ * @param flush A short integer value. Set it to 1 in order to move also the partially filled pages, 0 otherwise.
+ * @return The number of bytes moved to the output file.
+*/
+long splice_raw_pages(int fd_read, int fd_write, int pipe_fd[2], long page_size, char* page, const char* file_path, short flush);
+
+/**
+ * @brief Moves the raw content of the per-CPU ring buffers of a tracefs into one file per CPU, using splice() so that the pages
+ * are never copied in user space nor pretty-printed by the kernel. The format files needed to decode the traces offline
+ * are copied too.
+ * @param tracing_path The path to the root directory of the tracefs.
+ * @param dir_path The path to the directory where to save the raw traces. It must already exist.
+*/
+void capture_raw_trace(const char* tracing_path, const char* dir_path);
+
+/**
+ * @brief Opens the raw per-CPU traces saved in a directory by "capture_raw_trace()".
+ * @param dir_path The path to the directory that contains the raw traces.
+ * @return A pointer to a newly created raw_trace_reader struct. This structure must be deallocated using the "raw_trace_close()"
+ * function when you're done with it.
+*/
+raw_trace_reader* raw_trace_open(const char* dir_path);
+
+/**
+ * @brief Retrieves the next event, in timestamp order, among all the per-CPU raw traces.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param event A pointer to a raw_event struct that will be filled with the next event.
+ * @return 1 if an event has been retrieved, 0 if there are no events left.
+*/
+int raw_trace_next(raw_trace_reader* reader, raw_event* event);
+
+/**
+ * @brief Closes all the files opened by a raw_trace_reader struct and frees up the memory allocated for it.
+ * @param reader A pointer to a raw_trace_reader struct.
+*/
+void raw_trace_close(raw_trace_reader* reader);
+
+/**
+ * @brief Allows to know which of the events known by the library an event is.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param event A pointer to a raw_event struct.
+ * @return E_SCHED_SWITCH, E_SCHED_WAKEUP, E_SCHED_MIGRATE_TASK, E_PRINT or E_RAW_DATA, 0 if the event is unknown.
+*/
+int raw_trace_event_flag(raw_trace_reader* reader, const raw_event* event);
+
+/**
+ * @brief Decodes the fields of a sched_switch event.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param event A pointer to a raw_event struct of type E_SCHED_SWITCH.
+ * @param sched_switch A pointer to a raw_sched_switch struct that will be filled with the decoded fields.
+ * @return 1 if the event has been decoded, 0 otherwise.
+*/
+int raw_trace_decode_sched_switch(raw_trace_reader* reader, const raw_event* event, raw_sched_switch* sched_switch);
+
+/**
+ * @brief Decodes a job marker written either by "trace_mark_job()" (print event) or by "trace_mark_job_raw_session()"
+ * (raw_data event).
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param event A pointer to a raw_event struct.
+ * @param marker A pointer to a raw_job_marker struct that will be filled with the decoded marker. For text markers the
+ * "payload" field is always 0, and the "worker" field is 0 unless the marker has been written by "trace_mark_worker_job_session()".
+ * @return 1 if the event is a job marker, 0 otherwise.
+*/
+int raw_trace_decode_job_marker(raw_trace_reader* reader, const raw_event* event, raw_job_marker* marker);
+
+/**
+ * @brief Retrieves the value of a numeric field of an event using its format.
+ * @param reader A pointer to a raw_trace_reader struct.
+ * @param event A pointer to a raw_event struct.
+ * @param event_flag The flag of the event, as returned by "raw_trace_event_flag()".
+ * @param field_name A pointer to a string that specifies the name of the field.
+ * @param value A pointer to a long long integer where to store the value of the field.
+ * @return 1 if the field has been found, 0 otherwise.
+*/
+int raw_trace_field(raw_trace_reader* reader, const raw_event* event, int event_flag, const char* field_name, long long* value);
+
+#endif
@@ -0,0 +1,290 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include "sched_latency.h"
+
+/**
+ * @brief Empties a latency histogram.
+ * @param histogram A pointer to a latency_histogram struct.
+*/
+void latency_histogram_reset(latency_histogram* histogram){
+  bzero(histogram, sizeof(*histogram));
+}
+
+/**
+ * @brief Computes the index of the bucket that counts a value.
+ * @param value The value in nanoseconds.
+ * @return The index of the bucket.
+*/
+static int bucket_index(__u64 value){
+  int shift;
+
+  if(value < LATENCY_SUB_BUCKETS)
+    return (int)value;
+  // The most significant bit selects the power of two, the following LATENCY_SUB_BUCKET_BITS bits the bucket within it
+  shift = 63 - __builtin_clzll(value) - LATENCY_SUB_BUCKET_BITS;
+  return LATENCY_SUB_BUCKETS + shift * LATENCY_SUB_BUCKETS + (int)((value >> shift) - LATENCY_SUB_BUCKETS);
+}
+
+/**
+ * @brief Returns the range of the values counted by a bucket of a latency histogram.
+ * @param index The index of the bucket.
+ * @param lower A pointer to a 64 bit integer where to store the lowest value of the bucket.
+ * @param upper A pointer to a 64 bit integer where to store the highest value of the bucket.
+*/
+void latency_histogram_bucket_range(int index, __u64* lower, __u64* upper){
+  int shift;
+
+  if(index < LATENCY_SUB_BUCKETS){
+    *lower = *upper = index;
+    return;
+  }
+  shift = (index - LATENCY_SUB_BUCKETS) / LATENCY_SUB_BUCKETS;
+  *lower = (__u64)(LATENCY_SUB_BUCKETS + (index - LATENCY_SUB_BUCKETS) % LATENCY_SUB_BUCKETS) << shift;
+  *upper = *lower + ((1ULL << shift) - 1);
+}
+
+/**
+ * @brief Records a value into a latency histogram.
+ * @param histogram A pointer to a latency_histogram struct.
+ * @param value The value in nanoseconds.
+*/
+void latency_histogram_record(latency_histogram* histogram, __u64 value){
+  histogram->counts[bucket_index(value)]++;
+  histogram->count++;
+  if(value > histogram->max)
+    histogram->max = value;
+}
+
+/**
+ * @brief Adds all the values of a latency histogram to another one.
+ * @param dst A pointer to the latency_histogram struct to update.
+ * @param src A pointer to the latency_histogram struct to add.
+*/
+void latency_histogram_merge(latency_histogram* dst, const latency_histogram* src){
+  for(int i = 0; i < LATENCY_N_BUCKETS; i++){
+    dst->counts[i] += src->counts[i];
+  }
+  dst->count += src->count;
+  if(src->max > dst->max)
+    dst->max = src->max;
+}
+
+/**
+ * @brief Computes a percentile of the values recorded into a latency histogram.
+ * @param histogram A pointer to a latency_histogram struct.
+ * @param percentile The percentile, between 0 and 100.
+ * @return The highest value of the bucket that contains the percentile, never larger than the largest value recorded. It is 0 if the
+ * histogram is empty.
+*/
+__u64 latency_histogram_percentile(const latency_histogram* histogram, double percentile){
+  __u64 rank;
+  __u64 seen = 0;
+  __u64 lower, upper;
+
+  if(histogram->count == 0)
+    return 0;
+  // The rank of the percentile among the recorded values, starting from 1
+  rank = (__u64)(percentile / 100.0 * histogram->count + 0.999999);
+  if(rank < 1)
+    rank = 1;
+  for(int i = 0; i < LATENCY_N_BUCKETS; i++){
+    seen += histogram->counts[i];
+    if(seen >= rank){
+      latency_histogram_bucket_range(i, &lower, &upper);
+      return upper < histogram->max ? upper : histogram->max;
+    }
+  }
+  return histogram->max;
+}
+
+/**
+ * @brief Creates a latency engine that writes the "latency.txt" and "latency_hist.txt" files in an execution directory,
+ * overwriting them if they exist.
+ * @param dir_file_path The path to the execution directory. It must already exist.
+ * @param identifier The string that identifies the program execution.
+ * @param pid The pid of the traced process.
+ * @return A pointer to a newly created sched_latency_engine struct. This structure must be deallocated using the
+ * "destroy_sched_latency_engine()" function when you're done with it.
+*/
+sched_latency_engine* create_sched_latency_engine(const char* dir_file_path, const char* identifier, pid_t pid){
+  sched_latency_engine* engine;
+
+  engine = (sched_latency_engine*)calloc(1, sizeof(*engine));
+  if(engine == NULL){
+    fprintf(stderr, "create_sched_latency_engine: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  engine->pid = pid;
+  engine->identifier = strdup(identifier);
+  engine->file_path = (char*)calloc(strlen(dir_file_path) + 1 + strlen(LATENCY_FILENAME) + 1, sizeof(char));
+  engine->hist_file_path = (char*)calloc(strlen(dir_file_path) + 1 + strlen(LATENCY_HIST_FILENAME) + 1, sizeof(char));
+  if(engine->identifier == NULL || engine->file_path == NULL || engine->hist_file_path == NULL){
+    fprintf(stderr, "create_sched_latency_engine: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  sprintf(engine->file_path, "%s/%s", dir_file_path, LATENCY_FILENAME);
+  sprintf(engine->hist_file_path, "%s/%s", dir_file_path, LATENCY_HIST_FILENAME);
+  engine->file = fopen(engine->file_path, "w");
+  if(engine->file == NULL){
+    fprintf(stderr, "create_sched_latency_engine: error opening \"%s\" file. Aborting ...\n", engine->file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  return engine;
+}
+
+/**
+ * @brief Consumes a sched_wakeup event. It must be called in timestamp order with respect to the other events.
+ * @param engine A pointer to a sched_latency_engine struct.
+ * @param timestamp The timestamp of the event in nanoseconds.
+ * @param pid The pid of the task woken up.
+*/
+void sched_latency_wakeup(sched_latency_engine* engine, __u64 timestamp, pid_t pid){
+  // A second wakeup before the process runs doesn't delay it further, so the first one is kept
+  if(pid == engine->pid && engine->wakeup_timestamp == 0)
+    engine->wakeup_timestamp = timestamp;
+}
+
+/**
+ * @brief Consumes a sched_switch event. It must be called in timestamp order with respect to the other events.
+ * @param engine A pointer to a sched_latency_engine struct.
+ * @param timestamp The timestamp of the event in nanoseconds.
+ * @param prev_pid The pid of the task that left the CPU.
+ * @param next_pid The pid of the task that got the CPU.
+*/
+void sched_latency_sched_switch(sched_latency_engine* engine, __u64 timestamp, pid_t prev_pid, pid_t next_pid){
+  if(next_pid == engine->pid){
+    if(engine->wakeup_timestamp != 0 && engine->job_started)
+      latency_histogram_record(&engine->job, timestamp - engine->wakeup_timestamp);
+    engine->wakeup_timestamp = 0;
+  }else if(prev_pid == engine->pid){
+    // A wakeup received while the process was still running didn't make it runnable: it must sleep again to be woken up
+    engine->wakeup_timestamp = 0;
+  }
+}
+
+/**
+ * @brief Consumes a job marker. A START marker begins a new job, discarding an unfinished one. A STOP marker of the job in progress
+ * writes its latency percentiles to the latency file, while a STOP marker of another job discards the job in progress.
+ * @param engine A pointer to a sched_latency_engine struct.
+ * @param job_number The number of the job.
+ * @param state START or STOP.
+*/
+void sched_latency_job_marker(sched_latency_engine* engine, int job_number, int state){
+  latency_histogram* job = &engine->job;
+
+  if(state == START){
+    latency_histogram_reset(job);
+    engine->job_number = job_number;
+    engine->job_started = 1;
+    return;
+  }
+  if(engine->job_started && engine->job_number == job_number){
+    if(fprintf(engine->file, "%s, %d, %llu, %llu, %llu, %llu, %llu\n", engine->identifier, job_number, (unsigned long long)job->count,
+               (unsigned long long)latency_histogram_percentile(job, 50), (unsigned long long)latency_histogram_percentile(job, 99),
+               (unsigned long long)latency_histogram_percentile(job, 99.9), (unsigned long long)job->max) < 0){
+      fprintf(stderr, "sched_latency_job_marker: error writing to \"%s\" file. Aborting ...\n", engine->file_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    latency_histogram_merge(&engine->total, job);
+    engine->n_jobs++;
+  }
+  engine->job_started = 0;
+}
+
+/**
+ * @brief Consumes an event read from the raw per-CPU traces, ignoring the events that are neither sched_wakeup, sched_switch nor
+ * job markers.
+ * @param engine A pointer to a sched_latency_engine struct.
+ * @param reader A pointer to the raw_trace_reader struct that returned the event.
+ * @param event A pointer to a raw_event struct.
+*/
+void sched_latency_raw_event(sched_latency_engine* engine, raw_trace_reader* reader, const raw_event* event){
+  raw_sched_switch sched_switch;
+  raw_job_marker marker;
+  long long pid;
+
+  switch(raw_trace_event_flag(reader, event)){
+    case E_SCHED_WAKEUP:
+      if(raw_trace_field(reader, event, E_SCHED_WAKEUP, "pid", &pid))
+        sched_latency_wakeup(engine, event->timestamp, (pid_t)pid);
+      break;
+    case E_SCHED_SWITCH:
+      if(raw_trace_decode_sched_switch(reader, event, &sched_switch))
+        sched_latency_sched_switch(engine, event->timestamp, sched_switch.prev_pid, sched_switch.next_pid);
+      break;
+    default:
+      if(raw_trace_decode_job_marker(reader, event, &marker))
+        sched_latency_job_marker(engine, marker.job_number, marker.state);
+      break;
+  }
+}
+
+/**
+ * @brief Writes the histogram of all the jobs to the histogram file, closes the files and frees up the memory allocated for a
+ * sched_latency_engine struct. An unfinished job is discarded.
+ * @param engine A pointer to a sched_latency_engine struct.
+ * @return The number of jobs written to the latency file.
+*/
+int destroy_sched_latency_engine(sched_latency_engine* engine){
+  int n_jobs = engine->n_jobs;
+  FILE* hist_file;
+  __u64 lower, upper;
+
+  if(fclose(engine->file) == EOF){
+    fprintf(stderr, "destroy_sched_latency_engine: error closing \"%s\" file. Aborting ...\n", engine->file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  // Only the buckets with values are written, as "lower, upper, count" lines, so that the executions can be merged later
+  hist_file = fopen(engine->hist_file_path, "w");
+  if(hist_file == NULL){
+    fprintf(stderr, "destroy_sched_latency_engine: error opening \"%s\" file. Aborting ...\n", engine->hist_file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  for(int i = 0; i < LATENCY_N_BUCKETS; i++){
+    if(engine->total.counts[i] == 0)
+      continue;
+    latency_histogram_bucket_range(i, &lower, &upper);
+    fprintf(hist_file, "%llu, %llu, %llu\n", (unsigned long long)lower, (unsigned long long)upper, (unsigned long long)engine->total.counts[i]);
+  }
+  if(fclose(hist_file) == EOF){
+    fprintf(stderr, "destroy_sched_latency_engine: error closing \"%s\" file. Aborting ...\n", engine->hist_file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  free(engine->identifier);
+  free(engine->file_path);
+  free(engine->hist_file_path);
+  free(engine);
+  return n_jobs;
+}
+
+/**
+ * @brief Computes the scheduling latency of all the jobs contained in the raw per-CPU traces of an execution directory, writing its
+ * "latency.txt" and "latency_hist.txt" files. The traces must contain the sched_wakeup and sched_switch events of the process.
+ * @param dir_file_path The path to the execution directory that contains the raw traces.
+ * @param identifier The string that identifies the program execution.
+ * @param pid The pid of the traced process.
+ * @return The number of jobs written to the latency file.
+*/
+int compute_sched_latency(const char* dir_file_path, const char* identifier, pid_t pid){
+  sched_latency_engine* engine;
+  raw_trace_reader* reader;
+  raw_event event;
+
+  engine = create_sched_latency_engine(dir_file_path, identifier, pid);
+  reader = raw_trace_open(dir_file_path);
+  while(raw_trace_next(reader, &event)){
+    sched_latency_raw_event(engine, reader, &event);
+  }
+  raw_trace_close(reader);
+  return destroy_sched_latency_engine(engine);
+}
@@ -0,0 +1,148 @@
+#ifndef SCHED_LATENCY_H_
+#define SCHED_LATENCY_H_
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <linux/types.h>
+#include "raw_trace.h"
+
+#define LATENCY_FILENAME "latency.txt"						///>Name of the file, within an execution directory, that contains one line of scheduling latency percentiles per job.
+#define LATENCY_HIST_FILENAME "latency_hist.txt"	///>Name of the file, within an execution directory, that contains the buckets of the latency histogram of all its jobs.
+#define LATENCY_SUB_BUCKET_BITS 5									///>Bits of a value kept by the histogram below its most significant one: the relative error of a bucket is at most 1/2^5.
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BUCKET_BITS)	///>Number of linear buckets into which each power of two is split.
+#define LATENCY_N_BUCKETS (LATENCY_SUB_BUCKETS * (64 - LATENCY_SUB_BUCKET_BITS + 1))	///>Number of buckets needed to cover every 64 bit value.
+
+/**
+ * @brief A log-linear histogram of latencies in nanoseconds, as the HDR histograms: the values below LATENCY_SUB_BUCKETS have a
+ * bucket each, while every following power of two is split into LATENCY_SUB_BUCKETS buckets of the same width. It keeps the same
+ * relative precision from nanoseconds to seconds with a fixed amount of memory, and two histograms can be merged by adding their
+ * buckets, so that the percentiles of several jobs or executions are exact up to the width of a bucket.
+*/
+typedef struct latency_histogram{
+	__u64 counts[LATENCY_N_BUCKETS]; ///> The number of values recorded in each bucket.
+	__u64 count; ///> The number of values recorded.
+	__u64 max; ///> The largest value recorded.
+} latency_histogram;
+
+/**
+ * @brief A structure that measures the scheduling latency of a process while the events are consumed in timestamp order: the time
+ * elapsed from a sched_wakeup event of the process to the sched_switch event that gives it a CPU. Each job has its own histogram,
+ * written as a line of the "latency.txt" file of the execution directory, and all the jobs are merged into the histogram written
+ * to the "latency_hist.txt" file.
+*/
+typedef struct sched_latency_engine{
+	pid_t pid; ///> The pid of the traced process.
+	char* identifier; ///> The string that identifies the program execution, written in each line.
+	char* file_path; ///> The path to the latency file, used for error messages.
+	char* hist_file_path; ///> The path to the histogram file.
+	FILE* file; ///> The latency file.
+	__u64 wakeup_timestamp; ///> Timestamp of the last sched_wakeup event of the process not yet followed by a sched_switch, or 0.
+	int job_number; ///> The number of the job in progress.
+	short job_started; ///> 1 if a job is in progress, 0 otherwise.
+	latency_histogram job; ///> The histogram of the job in progress.
+	latency_histogram total; ///> The histogram of all the jobs written to the latency file.
+	int n_jobs; ///> Number of jobs written to the latency file.
+} sched_latency_engine;
+
+/**
+ * @brief Empties a latency histogram.
+ * @param histogram A pointer to a latency_histogram struct.
+*/
+void latency_histogram_reset(latency_histogram* histogram);
+
+/**
+ * @brief Records a value into a latency histogram.
+ * @param histogram A pointer to a latency_histogram struct.
+ * @param value The value in nanoseconds.
+*/
+void latency_histogram_record(latency_histogram* histogram, __u64 value);
+
+/**
+ * @brief Adds all the values of a latency histogram to another one.
+ * @param dst A pointer to the latency_histogram struct to update.
+ * @param src A pointer to the latency_histogram struct to add.
+*/
+void latency_histogram_merge(latency_histogram* dst, const latency_histogram* src);
+
+/**
+ * @brief Computes a percentile of the values recorded into a latency histogram.
+ * @param histogram A pointer to a latency_histogram struct.
+ * @param percentile The percentile, between 0 and 100.
+ * @return The highest value of the bucket that contains the percentile, never larger than the largest value recorded. It is 0 if the
+ * histogram is empty.
+*/
+__u64 latency_histogram_percentile(const latency_histogram* histogram, double percentile);
+
+/**
+ * @brief Returns the range of the values counted by a bucket of a latency histogram.
+ * @param index The index of the bucket.
+ * @param lower A pointer to a 64 bit integer where to store the lowest value of the bucket.
+ * @param upper A pointer to a 64 bit integer where to store the highest value of the bucket.
+*/
+void latency_histogram_bucket_range(int index, __u64* lower, __u64* upper);
+
+/**
+ * @brief Creates a latency engine that writes the "latency.txt" and "latency_hist.txt" files in an execution directory,
+ * overwriting them if they exist.
+ * @param dir_file_path The path to the execution directory. It must already exist.
+ * @param identifier The string that identifies the program execution.
+ * @param pid The pid of the traced process.
+ * @return A pointer to a newly created sched_latency_engine struct. This structure must be deallocated using the
+ * "destroy_sched_latency_engine()" function when you're done with it.
+*/
+sched_latency_engine* create_sched_latency_engine(const char* dir_file_path, const char* identifier, pid_t pid);
+
+/**
+ * @brief Consumes a sched_wakeup event. It must be called in timestamp order with respect to the other events.
+ * @param engine A pointer to a sched_latency_engine struct.
+ * @param timestamp The timestamp of the event in nanoseconds.
+ * @param pid The pid of the task woken up.
+*/
+void sched_latency_wakeup(sched_latency_engine* engine, __u64 timestamp, pid_t pid);
+
+/**
+ * @brief Consumes a sched_switch event. It must be called in timestamp order with respect to the other events.
+ * @param engine A pointer to a sched_latency_engine struct.
+ * @param timestamp The timestamp of the event in nanoseconds.
+ * @param prev_pid The pid of the task that left the CPU.
+ * @param next_pid The pid of the task that got the CPU.
+*/
+void sched_latency_sched_switch(sched_latency_engine* engine, __u64 timestamp, pid_t prev_pid, pid_t next_pid);
+
+/**
+ * @brief Consumes a job marker. A START marker begins a new job, discarding an unfinished one. A STOP marker of the job in progress
+ * writes its latency percentiles to the latency file, while a STOP marker of another job discards the job in progress.
+ * @param engine A pointer to a sched_latency_engine struct.
+ * @param job_number The number of the job.
+ * @param state START or STOP.
+*/
+void sched_latency_job_marker(sched_latency_engine* engine, int job_number, int state);
+
+/**
+ * @brief Consumes an event read from the raw per-CPU traces, ignoring the events that are neither sched_wakeup, sched_switch nor
+ * job markers.
+ * @param engine A pointer to a sched_latency_engine struct.
+ * @param reader A pointer to the raw_trace_reader struct that returned the event.
+ * @param event A pointer to a raw_event struct.
+*/
+void sched_latency_raw_event(sched_latency_engine* engine, raw_trace_reader* reader, const raw_event* event);
+
+/**
+ * @brief Writes the histogram of all the jobs to the histogram file, closes the files and frees up the memory allocated for a
+ * sched_latency_engine struct. An unfinished job is discarded.
+ * @param engine A pointer to a sched_latency_engine struct.
+ * @return The number of jobs written to the latency file.
+*/
+int destroy_sched_latency_engine(sched_latency_engine* engine);
+
+/**
+ * @brief Computes the scheduling latency of all the jobs contained in the raw per-CPU traces of an execution directory, writing its
+ * "latency.txt" and "latency_hist.txt" files. The traces must contain the sched_wakeup and sched_switch events of the process.
+ * @param dir_file_path The path to the execution directory that contains the raw traces.
+ * @param identifier The string that identifies the program execution.
+ * @param pid The pid of the traced process.
+ * @return The number of jobs written to the latency file.
+*/
+int compute_sched_latency(const char* dir_file_path, const char* identifier, pid_t pid);
+
+#endif
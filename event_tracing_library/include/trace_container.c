@@ -0,0 +1,367 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include "trace_container.h"
+
+#define COMM_HASH_SIZE 131072	///>Number of slots of the hash table used to intern the command names. It must be a power of 2 greater than TRACE_CONTAINER_MAX_COMMS.
+
+/**
+ * @brief A structure used by the writer to intern the command names: each distinct name is stored once in the comm table of the
+ * container and the records refer to it with its index.
+*/
+typedef struct comm_table{
+  char (*names)[RAW_COMM_LEN]; ///> The distinct command names, in order of appearance.
+  int n_names; ///> Number of distinct command names.
+  int* slots; ///> Open addressing hash table of indexes of the "names" array, -1 if the slot is empty.
+} comm_table;
+
+/**
+ * @brief Retrieves the index of a command name in the comm table, adding it if it's the first time it appears.
+ * @param table A pointer to a comm_table struct.
+ * @param comm A pointer to a terminated string of at most RAW_COMM_LEN characters.
+ * @return The index of the command name.
+*/
+static __u16 intern_comm(comm_table* table, const char* comm){
+  unsigned long hash = 5381;
+  char name[RAW_COMM_LEN] = {0};
+  int slot;
+
+  strncpy(name, comm, RAW_COMM_LEN);
+  for(int i = 0; i < RAW_COMM_LEN && name[i] != '\0'; i++)
+    hash = hash * 33 + (unsigned char)name[i];
+
+  for(slot = hash & (COMM_HASH_SIZE - 1); table->slots[slot] != -1; slot = (slot + 1) & (COMM_HASH_SIZE - 1)){
+    if(memcmp(table->names[table->slots[slot]], name, RAW_COMM_LEN) == 0)
+      return table->slots[slot];
+  }
+  if(table->n_names == TRACE_CONTAINER_MAX_COMMS){
+    fprintf(stderr, "write_trace_container: too many distinct command names. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  memcpy(table->names[table->n_names], name, RAW_COMM_LEN);
+  table->slots[slot] = table->n_names;
+  return table->n_names++;
+}
+
+/**
+ * @brief Writes a block of bytes to the container file, aborting in case of error.
+ * @param file The container file.
+ * @param data A pointer to the bytes to write.
+ * @param size The number of bytes to write.
+ * @param file_path The path to the container file, used for error messages.
+*/
+static void write_block(FILE* file, const void* data, size_t size, const char* file_path){
+  if(size > 0 && fwrite(data, size, 1, file) != 1){
+    fprintf(stderr, "write_trace_container: error writing to \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Converts the raw per-CPU traces saved in an execution directory into a binary trace container ("trace.bin") with
+ * fixed-width records, delta-encoded timestamps, interned command names and an index of the job boundaries.
+ * @param dir_file_path The path to the execution directory that contains the raw traces.
+ * @param remove_raw A short integer value. Set it to 1 in order to remove the raw traces once converted, 0 otherwise.
+*/
+void write_trace_container(const char* dir_file_path, short remove_raw){
+  raw_trace_reader* reader;
+  raw_event event;
+  raw_sched_switch sched_switch;
+  raw_job_marker marker;
+  container_header header = {0};
+  container_trailer trailer = {0};
+  container_record record;
+  comm_table comms = {0};
+  container_job_index* index = NULL;
+  int index_capacity = 0;
+  int open_job = -1;
+  __u64 last_timestamp = 0;
+  __u64 offset;
+  char file_path[PATH_MAX];
+  FILE* file;
+
+  reader = raw_trace_open(dir_file_path);
+  comms.names = calloc(TRACE_CONTAINER_MAX_COMMS, sizeof(*comms.names));
+  comms.slots = (int*)malloc(COMM_HASH_SIZE * sizeof(*comms.slots));
+  if(comms.names == NULL || comms.slots == NULL){
+    fprintf(stderr, "write_trace_container: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  memset(comms.slots, -1, COMM_HASH_SIZE * sizeof(*comms.slots));
+
+  snprintf(file_path, PATH_MAX, "%s/%s", dir_file_path, TRACE_CONTAINER_FILENAME);
+  file = fopen(file_path, "wb");
+  if(file == NULL){
+    fprintf(stderr, "write_trace_container: error opening \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  // The header is rewritten at the end, once the base timestamp is known
+  memcpy(header.magic, TRACE_CONTAINER_MAGIC, sizeof(header.magic));
+  header.record_size = sizeof(container_record);
+  header.n_cpus = reader->n_cpus;
+  write_block(file, &header, sizeof(header), file_path);
+  offset = sizeof(header);
+
+  while(raw_trace_next(reader, &event)){
+    bzero(&record, sizeof(record));
+    if(raw_trace_event_flag(reader, &event) == E_SCHED_SWITCH && raw_trace_decode_sched_switch(reader, &event, &sched_switch)){
+      record.sched_switch.type = RECORD_SCHED_SWITCH;
+      record.sched_switch.prev_prio = sched_switch.prev_prio;
+      record.sched_switch.next_prio = sched_switch.next_prio;
+      record.sched_switch.prev_pid = sched_switch.prev_pid;
+      record.sched_switch.next_pid = sched_switch.next_pid;
+      record.sched_switch.prev_comm = intern_comm(&comms, sched_switch.prev_comm);
+      record.sched_switch.next_comm = intern_comm(&comms, sched_switch.next_comm);
+      record.sched_switch.prev_state = sched_switch.prev_state;
+    }else if(raw_trace_decode_job_marker(reader, &event, &marker)){
+      record.marker.type = marker.state == START ? RECORD_JOB_START : RECORD_JOB_END;
+      record.marker.job_number = marker.job_number;
+      record.marker.pid = event.pid;
+      record.marker.payload = marker.payload;
+    }else{
+      continue;
+    }
+    record.marker.cpu = event.cpu;
+
+    if(offset == sizeof(header)){
+      header.base_timestamp = last_timestamp = event.timestamp;
+    }
+    // A delta that doesn't fit 32 bits (about 4.3 seconds) is preceded by the absolute timestamp
+    if(event.timestamp < last_timestamp || event.timestamp - last_timestamp > UINT_MAX){
+      container_record time_record = {0};
+      time_record.marker.type = RECORD_TIME;
+      time_record.marker.cpu = event.cpu;
+      time_record.marker.payload = event.timestamp;
+      write_block(file, &time_record, sizeof(time_record), file_path);
+      offset += sizeof(time_record);
+      last_timestamp = event.timestamp;
+    }
+    record.marker.delta = event.timestamp - last_timestamp;
+
+    if(record.marker.type == RECORD_JOB_START){
+      if(open_job == -1 || index[open_job].end_offset != 0){
+        if(open_job + 1 == index_capacity){
+          index_capacity = index_capacity == 0 ? 64 : index_capacity * 2;
+          index = (container_job_index*)realloc(index, index_capacity * sizeof(*index));
+          if(index == NULL){
+            fprintf(stderr, "write_trace_container: error allocating memory. Aborting ...\n");
+            PRINT_ERROR;
+            exit(EXIT_FAILURE);
+          }
+        }
+        open_job++;
+      }
+      // A job started again without its end marker replaces the incomplete entry
+      bzero(&index[open_job], sizeof(index[open_job]));
+      index[open_job].job_number = record.marker.job_number;
+      index[open_job].start_offset = offset;
+      index[open_job].base_timestamp = last_timestamp;
+    }else if(record.marker.type == RECORD_JOB_END && open_job != -1 && index[open_job].end_offset == 0
+             && index[open_job].job_number == record.marker.job_number){
+      index[open_job].end_offset = offset + sizeof(record);
+    }
+    write_block(file, &record, sizeof(record), file_path);
+    offset += sizeof(record);
+    last_timestamp = event.timestamp;
+  }
+  raw_trace_close(reader);
+
+  // Only the jobs with both markers are indexed
+  if(open_job != -1 && index[open_job].end_offset == 0){
+    open_job--;
+  }
+
+  trailer.comms_offset = offset;
+  for(int i = 0; i < comms.n_names; i++){
+    write_block(file, comms.names[i], RAW_COMM_LEN, file_path);
+  }
+  trailer.index_offset = trailer.comms_offset + (__u64)comms.n_names * RAW_COMM_LEN;
+  write_block(file, index, (open_job + 1) * sizeof(*index), file_path);
+  trailer.n_comms = comms.n_names;
+  trailer.n_jobs = open_job + 1;
+  memcpy(trailer.magic, TRACE_CONTAINER_MAGIC, sizeof(trailer.magic));
+  write_block(file, &trailer, sizeof(trailer), file_path);
+
+  if(fseek(file, 0, SEEK_SET) == -1){
+    fprintf(stderr, "write_trace_container: error seeking \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  write_block(file, &header, sizeof(header), file_path);
+  if(fclose(file) == EOF){
+    fprintf(stderr, "write_trace_container: error closing \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  if(remove_raw){
+    for(int cpu = 0; cpu < header.n_cpus; cpu++){
+      snprintf(file_path, PATH_MAX, "%s/" RAW_TRACE_FILENAME, dir_file_path, cpu);
+      unlink(file_path);
+    }
+  }
+  free(comms.names);
+  free(comms.slots);
+  free(index);
+}
+
+/**
+ * @brief Reads a block of bytes at a given offset of the container file, aborting in case of error.
+ * @param container A pointer to a trace_container struct.
+ * @param offset The offset of the block.
+ * @param data A pointer to the buffer that will be filled with the block.
+ * @param size The number of bytes to read.
+*/
+static void read_block(trace_container* container, long offset, void* data, size_t size){
+  if(fseek(container->file, offset, offset < 0 ? SEEK_END : SEEK_SET) == -1 || (size > 0 && fread(data, size, 1, container->file) != 1)){
+    fprintf(stderr, "trace_container: error reading the container file. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Opens a binary trace container, loading its comm table and its job index. The reading starts from the first record.
+ * @param file_path The path to the container file.
+ * @return A pointer to a newly created trace_container struct. This structure must be deallocated using the
+ * "trace_container_close()" function when you're done with it.
+*/
+trace_container* trace_container_open(const char* file_path){
+  trace_container* container;
+  char (*names)[RAW_COMM_LEN];
+
+  container = (trace_container*)calloc(1, sizeof(*container));
+  if(container == NULL){
+    fprintf(stderr, "trace_container_open: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  container->file = fopen(file_path, "rb");
+  if(container->file == NULL){
+    fprintf(stderr, "trace_container_open: error opening \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  read_block(container, 0, &container->header, sizeof(container->header));
+  read_block(container, -(long)sizeof(container->trailer), &container->trailer, sizeof(container->trailer));
+  if(memcmp(container->header.magic, TRACE_CONTAINER_MAGIC, sizeof(container->header.magic)) != 0
+     || memcmp(container->trailer.magic, TRACE_CONTAINER_MAGIC, sizeof(container->trailer.magic)) != 0
+     || container->header.record_size != sizeof(container_record)){
+    fprintf(stderr, "trace_container_open: \"%s\" is not a valid trace container. Aborting ...\n", file_path);
+    exit(EXIT_FAILURE);
+  }
+
+  names = calloc(container->trailer.n_comms + 1, sizeof(*names));
+  container->comms = calloc(container->trailer.n_comms + 1, sizeof(*container->comms));
+  container->index = (container_job_index*)calloc(container->trailer.n_jobs + 1, sizeof(*container->index));
+  if(names == NULL || container->comms == NULL || container->index == NULL){
+    fprintf(stderr, "trace_container_open: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  read_block(container, container->trailer.comms_offset, names, container->trailer.n_comms * sizeof(*names));
+  for(int i = 0; i < container->trailer.n_comms; i++){
+    memcpy(container->comms[i], names[i], RAW_COMM_LEN);
+  }
+  read_block(container, container->trailer.index_offset, container->index, container->trailer.n_jobs * sizeof(*container->index));
+  free(names);
+
+  container->timestamp = container->header.base_timestamp;
+  container->offset = sizeof(container->header);
+  container->end_offset = container->trailer.comms_offset;
+  read_block(container, container->offset, NULL, 0);
+  return container;
+}
+
+/**
+ * @brief Moves the reading to the records of a job, using the job index. After this call "trace_container_next()" returns only
+ * the records of that job, from its RECORD_JOB_START record to its RECORD_JOB_END record.
+ * @param container A pointer to a trace_container struct.
+ * @param job_number The number of the job.
+ * @return 1 if the job has been found in the index, 0 otherwise.
+*/
+int trace_container_seek_job(trace_container* container, int job_number){
+  for(int i = 0; i < container->trailer.n_jobs; i++){
+    if(container->index[i].job_number == job_number){
+      container->timestamp = container->index[i].base_timestamp;
+      container->offset = container->index[i].start_offset;
+      container->end_offset = container->index[i].end_offset;
+      read_block(container, container->offset, NULL, 0);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Retrieves a command name from the comm table of a container.
+ * @param container A pointer to a trace_container struct.
+ * @param index The index of the command name.
+ * @return A pointer to a terminated string, "<...>" if the index is not valid.
+*/
+static const char* container_comm(trace_container* container, __u16 index){
+  return index < container->trailer.n_comms ? container->comms[index] : "<...>";
+}
+
+/**
+ * @brief Reads the next event of a binary trace container.
+ * @param container A pointer to a trace_container struct.
+ * @param event A pointer to a container_event struct that will be filled with the next event.
+ * @return 1 if an event has been read, 0 if there are no events left.
+*/
+int trace_container_next(trace_container* container, container_event* event){
+  container_record record;
+
+  while(container->offset + sizeof(record) <= container->end_offset){
+    if(fread(&record, sizeof(record), 1, container->file) != 1){
+      fprintf(stderr, "trace_container_next: error reading the container file. Aborting ...\n");
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    container->offset += sizeof(record);
+    if(record.marker.type == RECORD_TIME){
+      container->timestamp = record.marker.payload;
+      continue;
+    }
+    container->timestamp += record.marker.delta;
+
+    bzero(event, sizeof(*event));
+    event->type = record.marker.type;
+    event->cpu = record.marker.cpu;
+    event->timestamp = container->timestamp;
+    if(record.marker.type == RECORD_SCHED_SWITCH){
+      strcpy(event->sched_switch.prev_comm, container_comm(container, record.sched_switch.prev_comm));
+      event->sched_switch.prev_pid = record.sched_switch.prev_pid;
+      event->sched_switch.prev_prio = record.sched_switch.prev_prio;
+      event->sched_switch.prev_state = record.sched_switch.prev_state;
+      strcpy(event->sched_switch.next_comm, container_comm(container, record.sched_switch.next_comm));
+      event->sched_switch.next_pid = record.sched_switch.next_pid;
+      event->sched_switch.next_prio = record.sched_switch.next_prio;
+    }else{
+      event->job_number = record.marker.job_number;
+      event->pid = record.marker.pid;
+      event->payload = record.marker.payload;
+    }
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Closes a binary trace container and frees up the memory allocated for the trace_container struct.
+ * @param container A pointer to a trace_container struct.
+*/
+void trace_container_close(trace_container* container){
+  fclose(container->file);
+  free(container->comms);
+  free(container->index);
+  free(container);
+}
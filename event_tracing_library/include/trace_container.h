@@ -0,0 +1,152 @@
+#ifndef TRACE_CONTAINER_H_
+#define TRACE_CONTAINER_H_
+
+#include <stdio.h>
+#include <linux/types.h>
+#include "raw_trace.h"
+
+#define TRACE_CONTAINER_FILENAME "trace.bin"	///>Name of the file, within an execution directory, that contains the binary trace container.
+#define TRACE_CONTAINER_MAGIC "ETRCBIN1"	///>Magic string written in the header and in the trailer of a binary trace container.
+#define TRACE_CONTAINER_MAX_COMMS 65535	///>Max number of distinct command names that can be interned in a binary trace container.
+
+#define RECORD_SCHED_SWITCH 1	///>Type of a container record that contains a sched_switch event.
+#define RECORD_JOB_START 2		///>Type of a container record that marks the beginning of a job.
+#define RECORD_JOB_END 3			///>Type of a container record that marks the end of a job.
+#define RECORD_TIME 4					///>Type of a container record that contains an absolute timestamp, used when a delta doesn't fit 32 bits.
+
+/**
+ * @brief The header written at the beginning of a binary trace container.
+*/
+typedef struct container_header{
+	char magic[8]; ///> Always TRACE_CONTAINER_MAGIC.
+	__u32 record_size; ///> Size in bytes of every record.
+	__u32 n_cpus; ///> Number of CPUs of the traced machine.
+	__u64 base_timestamp; ///> Timestamp in nanoseconds which the delta of the first record is relative to.
+} container_header;
+
+/**
+ * @brief A container record that contains a sched_switch event. The command names are indexes of the comm table of the container.
+*/
+typedef struct container_switch{
+	__u32 delta; ///> Nanoseconds elapsed since the previous record.
+	__u8 type; ///> Always RECORD_SCHED_SWITCH.
+	__u8 cpu; ///> The CPU that recorded the event.
+	__u8 prev_prio; ///> The priority of the task that left the CPU.
+	__u8 next_prio; ///> The priority of the task that got the CPU.
+	__s32 prev_pid; ///> The pid of the task that left the CPU.
+	__s32 next_pid; ///> The pid of the task that got the CPU.
+	__u16 prev_comm; ///> Index of the command name of the task that left the CPU.
+	__u16 next_comm; ///> Index of the command name of the task that got the CPU.
+	__u32 prev_state; ///> The state of the task that left the CPU.
+} container_switch;
+
+/**
+ * @brief A container record that marks the beginning or the end of a job, or that contains an absolute timestamp.
+*/
+typedef struct container_marker{
+	__u32 delta; ///> Nanoseconds elapsed since the previous record. Always 0 for RECORD_TIME records.
+	__u8 type; ///> RECORD_JOB_START, RECORD_JOB_END or RECORD_TIME.
+	__u8 cpu; ///> The CPU that recorded the event.
+	__u16 reserved; ///> Unused, always 0.
+	__s32 job_number; ///> The number of the job.
+	__s32 pid; ///> The pid of the task that marked the job.
+	__s64 payload; ///> The payload of the raw job markers, or the absolute timestamp of a RECORD_TIME record.
+} container_marker;
+
+/**
+ * @brief A fixed-width record of a binary trace container. The "type" field is at the same offset in both layouts.
+*/
+typedef union container_record{
+	container_switch sched_switch; ///> The layout of RECORD_SCHED_SWITCH records.
+	container_marker marker; ///> The layout of the other records.
+} container_record;
+
+/**
+ * @brief An entry of the job index written at the end of a binary trace container. It maps a job to the byte range of its records.
+*/
+typedef struct container_job_index{
+	__s32 job_number; ///> The number of the job.
+	__u32 reserved; ///> Unused, always 0.
+	__u64 start_offset; ///> Offset of the RECORD_JOB_START record of the job.
+	__u64 end_offset; ///> Offset of the byte after the RECORD_JOB_END record of the job.
+	__u64 base_timestamp; ///> Timestamp which the delta of the record at "start_offset" is relative to.
+} container_job_index;
+
+/**
+ * @brief The trailer written at the end of a binary trace container, used to find the comm table and the job index.
+*/
+typedef struct container_trailer{
+	__u64 comms_offset; ///> Offset of the comm table: "n_comms" names of RAW_COMM_LEN bytes each.
+	__u64 index_offset; ///> Offset of the job index: "n_jobs" container_job_index structs.
+	__u32 n_comms; ///> Number of interned command names.
+	__u32 n_jobs; ///> Number of jobs in the index.
+	char magic[8]; ///> Always TRACE_CONTAINER_MAGIC.
+} container_trailer;
+
+/**
+ * @brief A decoded event of a binary trace container, with absolute timestamp and resolved command names.
+*/
+typedef struct container_event{
+	int type; ///> RECORD_SCHED_SWITCH, RECORD_JOB_START or RECORD_JOB_END.
+	int cpu; ///> The CPU that recorded the event.
+	__u64 timestamp; ///> The timestamp of the event in nanoseconds.
+	raw_sched_switch sched_switch; ///> The sched_switch fields, valid only for RECORD_SCHED_SWITCH events.
+	int job_number; ///> The number of the job, valid only for job markers.
+	int pid; ///> The pid of the task that marked the job, valid only for job markers.
+	long payload; ///> The payload of the job marker, valid only for job markers.
+} container_event;
+
+/**
+ * @brief A structure used to read a binary trace container.
+*/
+typedef struct trace_container{
+	FILE* file; ///> The container file.
+	container_header header; ///> The header of the container.
+	container_trailer trailer; ///> The trailer of the container.
+	char (*comms)[RAW_COMM_LEN + 1]; ///> The comm table, with terminated strings.
+	container_job_index* index; ///> The job index.
+	__u64 timestamp; ///> Timestamp of the last record read.
+	__u64 offset; ///> Offset of the next record to read.
+	__u64 end_offset; ///> Offset where the reading must stop.
+} trace_container;
+
+/**
+ * @brief Converts the raw per-CPU traces saved in an execution directory into a binary trace container ("trace.bin") with
+ * fixed-width records, delta-encoded timestamps, interned command names and an index of the job boundaries.
+ * @param dir_file_path The path to the execution directory that contains the raw traces.
+ * @param remove_raw A short integer value. Set it to 1 in order to remove the raw traces once converted, 0 otherwise.
+*/
+void write_trace_container(const char* dir_file_path, short remove_raw);
+
+/**
+ * @brief Opens a binary trace container, loading its comm table and its job index. The reading starts from the first record.
+ * @param file_path The path to the container file.
+ * @return A pointer to a newly created trace_container struct. This structure must be deallocated using the
+ * "trace_container_close()" function when you're done with it.
+*/
+trace_container* trace_container_open(const char* file_path);
+
+/**
+ * @brief Moves the reading to the records of a job, using the job index. After this call "trace_container_next()" returns only
+ * the records of that job, from its RECORD_JOB_START record to its RECORD_JOB_END record.
+ * @param container A pointer to a trace_container struct.
+ * @param job_number The number of the job.
+ * @return 1 if the job has been found in the index, 0 otherwise.
+*/
+int trace_container_seek_job(trace_container* container, int job_number);
+
+/**
+ * @brief Reads the next event of a binary trace container.
+ * @param container A pointer to a trace_container struct.
+ * @param event A pointer to a container_event struct that will be filled with the next event.
+ * @return 1 if an event has been read, 0 if there are no events left.
+*/
+int trace_container_next(trace_container* container, container_event* event);
+
+/**
+ * @brief Closes a binary trace container and frees up the memory allocated for the trace_container struct.
+ * @param container A pointer to a trace_container struct.
+*/
+void trace_container_close(trace_container* container);
+
+#endif
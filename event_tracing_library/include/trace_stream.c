@@ -0,0 +1,236 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "trace_stream.h"
+#include "raw_trace.h"
+
+/**
+ * @brief Moves to the output file all the text available in the trace_pipe file, using the fixed-size buffer of the stream.
+ * @param stream A pointer to a trace_stream struct in text mode.
+*/
+static void drain_trace_pipe(trace_stream* stream){
+  ssize_t bytes_read;
+
+  while((bytes_read = read(stream->fd_read[0], stream->buffer, TRACE_STREAM_BUFFER_SIZE)) > 0){
+    if(write(stream->fd_write[0], stream->buffer, bytes_read) != bytes_read){
+      fprintf(stderr, "trace_stream: error writing to \"%s\" file. Aborting ...\n", stream->file_paths[0]);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    stream->bytes_written += bytes_read;
+  }
+  if(bytes_read == -1 && errno != EAGAIN && errno != EINTR){
+    fprintf(stderr, "trace_stream: error reading the kernel trace. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief The body of the consumer thread. It sleeps in poll() until the kernel signals new data in one of the drained files or
+ * until "stop_trace_stream()" writes to the wakeup pipe. In raw mode only full pages are moved while the jobs are running.
+ * @param arg A pointer to the trace_stream struct.
+ * @return Always NULL.
+*/
+static void* trace_stream_thread(void* arg){
+  trace_stream* stream = (trace_stream*)arg;
+  struct pollfd* fds;
+  int stop = 0;
+
+  pthread_setname_np(pthread_self(), TRACE_STREAM_THREAD_NAME);
+  fds = (struct pollfd*)calloc(stream->n_fds + 1, sizeof(*fds));
+  if(fds == NULL){
+    fprintf(stderr, "trace_stream: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  for(int i = 0; i < stream->n_fds; i++){
+    fds[i].fd = stream->fd_read[i];
+    fds[i].events = POLLIN;
+  }
+  fds[stream->n_fds].fd = stream->wakeup_fd[0];
+  fds[stream->n_fds].events = POLLIN;
+
+  while(!stop){
+    if(poll(fds, stream->n_fds + 1, -1) == -1){
+      if(errno == EINTR)
+        continue;
+      fprintf(stderr, "trace_stream: error waiting for the kernel trace. Aborting ...\n");
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    stop = fds[stream->n_fds].revents != 0;
+    for(int i = 0; i < stream->n_fds; i++){
+      if(stream->fd_read[i] == -1 || (fds[i].revents == 0 && !stop))
+        continue;
+      if(stream->mode == USE_TRACE_RAW){
+        // Once stopped, the partially filled pages are flushed too
+        stream->bytes_written += splice_raw_pages(stream->fd_read[i], stream->fd_write[i], stream->pipe_fd, stream->page_size,
+                                                  stream->buffer, stream->file_paths[i], stop);
+      }else{
+        drain_trace_pipe(stream);
+      }
+    }
+  }
+  free(fds);
+  return NULL;
+}
+
+/**
+ * @brief Opens the output file of one of the drained tracefs files.
+ * @param stream A pointer to a trace_stream struct.
+ * @param index The index of the drained file.
+ * @param dir_file_path The path to the execution directory.
+ * @param file_name The name of the output file.
+*/
+static void open_stream_output(trace_stream* stream, int index, const char* dir_file_path, const char* file_name){
+  stream->file_paths[index] = (char*)calloc(strlen(dir_file_path) + 1 + strlen(file_name) + 1, sizeof(char));
+  if(stream->file_paths[index] == NULL){
+    fprintf(stderr, "start_trace_stream: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  sprintf(stream->file_paths[index], "%s/%s", dir_file_path, file_name);
+  stream->fd_write[index] = open(stream->file_paths[index], O_WRONLY | O_CREAT | O_TRUNC, 0777);
+  if(stream->fd_write[index] == -1){
+    fprintf(stderr, "start_trace_stream: error opening \"%s\" file. Aborting ...\n", stream->file_paths[index]);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Starts a consumer thread that drains the kernel trace into the execution directory while the jobs are running. The
+ * thread always uses the SCHED_OTHER policy, whatever the policy of the calling thread is.
+ * @param tracing_path The path to the root directory of the tracefs. Set it to NULL in order to use the default one (TRACING_PATH).
+ * @param dir_path The path to a directory where to save various job executions and trace results. It must be the same provided
+ * to "log_execution_info()".
+ * @param identifier The string that identifies the program execution.
+ * @param mode A short integer value. Set it to USE_TRACE_PIPE to save the text trace in the "trace.txt" file, or to USE_TRACE_RAW
+ * to save the binary per-CPU traces in the "trace_cpuN.raw" files.
+ * @return A pointer to a newly created trace_stream struct. It must be stopped and deallocated using the "stop_trace_stream()"
+ * function.
+*/
+trace_stream* start_trace_stream(const char* tracing_path, const char* dir_path, const char* identifier, short mode){
+  trace_stream* stream;
+  pthread_attr_t attr;
+  struct sched_param param = {0};
+  char* dir_file_path;
+  char src_path[PATH_MAX];
+  char file_name[NAME_MAX];
+
+  if(mode != USE_TRACE_PIPE && mode != USE_TRACE_RAW){
+    fprintf(stderr, "start_trace_stream: invalid mode. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  if(tracing_path == NULL){
+    tracing_path = TRACING_PATH;
+  }
+
+  stream = (trace_stream*)malloc(sizeof(*stream));
+  if(stream == NULL){
+    fprintf(stderr, "start_trace_stream: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  bzero(stream, sizeof(*stream));
+  stream->mode = mode;
+  stream->page_size = sysconf(_SC_PAGESIZE);
+  stream->n_fds = mode == USE_TRACE_RAW ? sysconf(_SC_NPROCESSORS_CONF) : 1;
+  stream->fd_read = (int*)calloc(stream->n_fds, sizeof(*stream->fd_read));
+  stream->fd_write = (int*)calloc(stream->n_fds, sizeof(*stream->fd_write));
+  stream->file_paths = (char**)calloc(stream->n_fds, sizeof(*stream->file_paths));
+  stream->buffer = (char*)malloc(mode == USE_TRACE_RAW ? stream->page_size : TRACE_STREAM_BUFFER_SIZE);
+  if(stream->fd_read == NULL || stream->fd_write == NULL || stream->file_paths == NULL || stream->buffer == NULL){
+    fprintf(stderr, "start_trace_stream: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  if(pipe(stream->pipe_fd) == -1 || pipe(stream->wakeup_fd) == -1){
+    fprintf(stderr, "start_trace_stream: error creating a pipe. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  dir_file_path = create_execution_directory(dir_path, identifier);
+  if(mode == USE_TRACE_RAW){
+    save_raw_trace_formats(tracing_path, dir_file_path);
+  }
+  for(int i = 0; i < stream->n_fds; i++){
+    if(mode == USE_TRACE_RAW){
+      snprintf(src_path, PATH_MAX, "%s/per_cpu/cpu%d/trace_pipe_raw", tracing_path, i);
+      snprintf(file_name, NAME_MAX, RAW_TRACE_FILENAME, i);
+    }else{
+      snprintf(src_path, PATH_MAX, "%s/trace_pipe", tracing_path);
+      snprintf(file_name, NAME_MAX, "trace.txt");
+    }
+    // An offline CPU has no per_cpu directory: its raw trace is left empty and poll() ignores it
+    stream->fd_read[i] = open(src_path, O_RDONLY | O_NONBLOCK);
+    if(stream->fd_read[i] == -1 && (mode != USE_TRACE_RAW || errno != ENOENT)){
+      fprintf(stderr, "start_trace_stream: error opening \"%s\" file. Aborting ...\n", src_path);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    open_stream_output(stream, i, dir_file_path, file_name);
+  }
+  free(dir_file_path);
+
+  // The consumer thread must not inherit a real-time policy from the traced thread
+  pthread_attr_init(&attr);
+  pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+  pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+  pthread_attr_setschedparam(&attr, &param);
+  if(pthread_create(&stream->thread, &attr, trace_stream_thread, stream) != 0){
+    fprintf(stderr, "start_trace_stream: error creating the consumer thread. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  pthread_attr_destroy(&attr);
+  return stream;
+}
+
+/**
+ * @brief Stops a consumer thread started with "start_trace_stream()" after it has flushed the tail of the kernel trace not yet
+ * drained, then it closes all the files and frees up the memory allocated for the trace_stream struct. It replaces the
+ * "log_trace()" call at the end of the execution.
+ * @param stream A pointer to a trace_stream struct.
+ * @return The number of bytes saved by the consumer thread.
+*/
+unsigned long long stop_trace_stream(trace_stream* stream){
+  unsigned long long bytes_written;
+
+  if(write(stream->wakeup_fd[1], "1", 1) != 1){
+    fprintf(stderr, "stop_trace_stream: error waking up the consumer thread. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  pthread_join(stream->thread, NULL);
+  bytes_written = stream->bytes_written;
+
+  for(int i = 0; i < stream->n_fds; i++){
+    if(stream->fd_read[i] != -1)
+      close(stream->fd_read[i]);
+    close(stream->fd_write[i]);
+    free(stream->file_paths[i]);
+  }
+  close(stream->pipe_fd[0]);
+  close(stream->pipe_fd[1]);
+  close(stream->wakeup_fd[0]);
+  close(stream->wakeup_fd[1]);
+  free(stream->fd_read);
+  free(stream->fd_write);
+  free(stream->file_paths);
+  free(stream->buffer);
+  free(stream);
+  return bytes_written;
+}
@@ -0,0 +1,52 @@
+#ifndef TRACE_STREAM_H_
+#define TRACE_STREAM_H_
+
+#include <pthread.h>
+#include "event_tracing.h"
+
+#define TRACE_STREAM_BUFFER_SIZE 65536	///>Size of the only buffer used by a trace_stream consumer thread to move the text trace.
+#define TRACE_STREAM_THREAD_NAME "trace_stream"	///>Name given to the consumer thread, so that its events are not confused with the traced process.
+
+/**
+ * @brief A structure that represents a consumer thread that drains the kernel trace into the execution directory while the jobs
+ * are running, so that the ring buffer never overwrites the events of the first jobs. The thread sleeps in poll() until the
+ * kernel signals new data, and it uses a single fixed-size buffer (text mode) or no buffer at all (raw mode, using splice()).
+*/
+typedef struct trace_stream{
+	pthread_t thread; ///> The consumer thread.
+	short mode; ///> USE_TRACE_PIPE to drain the trace_pipe file, USE_TRACE_RAW to drain the per_cpu/cpuN/trace_pipe_raw files.
+	int n_fds; ///> Number of files drained: 1 in text mode, the number of CPUs in raw mode.
+	int* fd_read; ///> File descriptors of the drained tracefs files.
+	int* fd_write; ///> File descriptors of the output files.
+	char** file_paths; ///> Paths of the output files, used for error messages.
+	int pipe_fd[2]; ///> The pipe used to splice the raw pages.
+	int wakeup_fd[2]; ///> The pipe used to wake up the consumer thread when it must stop.
+	long page_size; ///> Size in bytes of a ring buffer page.
+	char* buffer; ///> The buffer used in text mode, or the one used for the partially filled pages in raw mode.
+	unsigned long long bytes_written; ///> Number of bytes moved to the output files. Read it only after "stop_trace_stream()".
+} trace_stream;
+
+/**
+ * @brief Starts a consumer thread that drains the kernel trace into the execution directory while the jobs are running. The
+ * thread always uses the SCHED_OTHER policy, whatever the policy of the calling thread is.
+ * @param tracing_path The path to the root directory of the tracefs. Set it to NULL in order to use the default one (TRACING_PATH).
+ * @param dir_path The path to a directory where to save various job executions and trace results. It must be the same provided
+ * to "log_execution_info()".
+ * @param identifier The string that identifies the program execution.
+ * @param mode A short integer value. Set it to USE_TRACE_PIPE to save the text trace in the "trace.txt" file, or to USE_TRACE_RAW
+ * to save the binary per-CPU traces in the "trace_cpuN.raw" files.
+ * @return A pointer to a newly created trace_stream struct. It must be stopped and deallocated using the "stop_trace_stream()"
+ * function.
+*/
+trace_stream* start_trace_stream(const char* tracing_path, const char* dir_path, const char* identifier, short mode);
+
+/**
+ * @brief Stops a consumer thread started with "start_trace_stream()" after it has flushed the tail of the kernel trace not yet
+ * drained, then it closes all the files and frees up the memory allocated for the trace_stream struct. It replaces the
+ * "log_trace()" call at the end of the execution.
+ * @param stream A pointer to a trace_stream struct.
+ * @return The number of bytes saved by the consumer thread.
+*/
+unsigned long long stop_trace_stream(trace_stream* stream);
+
+#endif
@@ -0,0 +1,232 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <dlfcn.h>
+#include <libgen.h>
+#include <sys/types.h>
+#include "workload.h"
+
+/**
+ * @brief Wraps a workload built into the program, such as the default jobs of test_app, in a workload_module struct.
+ * @param w A pointer to the workload struct. It is not copied.
+ * @return A pointer to a newly created workload_module struct. This structure must be deallocated using the
+ * "close_workload()" function when you're done with it.
+*/
+workload_module* open_workload(const workload* w){
+  workload_module* module;
+
+  module = (workload_module*)calloc(1, sizeof(*module));
+  if(module == NULL){
+    fprintf(stderr, "open_workload: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  module->workload = w;
+  return module;
+}
+
+/**
+ * @brief Opens a plugin with dlopen() and looks up its workload struct.
+ * @param file_path A pointer to the path of the plugin.
+ * @param handle A pointer to the variable where to store the handle of the plugin.
+ * @return A pointer to the workload struct, NULL if the plugin can't be opened or doesn't export a WORKLOAD_SYMBOL of the current
+ * WORKLOAD_API_VERSION. In this last case the plugin is closed.
+*/
+static const workload* open_plugin(const char* file_path, void** handle){
+  const workload* w;
+
+  *handle = dlopen(file_path, RTLD_NOW | RTLD_LOCAL);
+  if(*handle == NULL){
+    fprintf(stderr, "load_workload: warning, skipping \"%s\": %s\n", file_path, dlerror());
+    return NULL;
+  }
+  w = (const workload*)dlsym(*handle, WORKLOAD_SYMBOL);
+  if(w == NULL || w->api_version != WORKLOAD_API_VERSION || w->name == NULL || w->run == NULL){
+    fprintf(stderr, "load_workload: warning, skipping \"%s\": no valid \"%s\" symbol of version %d\n", file_path, WORKLOAD_SYMBOL,
+            WORKLOAD_API_VERSION);
+    dlclose(*handle);
+    return NULL;
+  }
+  return w;
+}
+
+/**
+ * @brief Opens the plugins of a directory one by one, in alphabetical order, calling a function on the workload of each of them
+ * until it returns a value other than 0. The plugin for which the function returned 0 is closed.
+ * @param dir_path A pointer to the path of the directory.
+ * @param callback The function called on each workload, with its handle and the argument given to this function.
+ * @param arg A pointer passed to the callback.
+ * @return The number of workloads visited.
+*/
+static int scan_plugins(const char* dir_path, int (*callback)(const workload*, void*, void*), void* arg){
+  char file_path[PATH_MAX];
+  struct dirent** entries;
+  const workload* w;
+  void* handle;
+  size_t len, suffix_len = strlen(WORKLOAD_SUFFIX);
+  int n_entries, n_workloads = 0, stop = 0;
+
+  n_entries = scandir(dir_path, &entries, NULL, alphasort);
+  if(n_entries == -1){
+    fprintf(stderr, "load_workload: error opening \"%s\" directory. Aborting ...\n", dir_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  for(int i = 0; i < n_entries; i++){
+    len = strlen(entries[i]->d_name);
+    if(!stop && len > suffix_len && strcmp(entries[i]->d_name + len - suffix_len, WORKLOAD_SUFFIX) == 0){
+      snprintf(file_path, sizeof(file_path), "%s/%s", dir_path, entries[i]->d_name);
+      w = open_plugin(file_path, &handle);
+      if(w != NULL){
+        n_workloads++;
+        stop = callback(w, handle, arg);
+        if(!stop)
+          dlclose(handle);
+      }
+    }
+    free(entries[i]);
+  }
+  free(entries);
+  return n_workloads;
+}
+
+/**
+ * @brief The search of "load_workload()".
+*/
+struct workload_search{
+  const char* name;
+  workload_module* module;
+};
+
+/**
+ * @brief The "scan_plugins()" callback of "load_workload()", which stops at the workload with the name searched.
+ * @param w A pointer to a workload struct.
+ * @param handle The handle of its plugin.
+ * @param arg A pointer to a workload_search struct, whose module is filled when the workload is found.
+ * @return 1 if the workload has been found, 0 otherwise.
+*/
+static int match_workload(const workload* w, void* handle, void* arg){
+  struct workload_search* search = (struct workload_search*)arg;
+
+  if(strcmp(w->name, search->name) != 0)
+    return 0;
+  search->module->workload = w;
+  search->module->handle = handle;
+  return 1;
+}
+
+/**
+ * @brief Loads a workload from the plugins of a directory, opening with dlopen() each WORKLOAD_SUFFIX file until the one that
+ * exports a workload with the given name is found. The files that can't be opened, or that don't export a WORKLOAD_SYMBOL of
+ * the current WORKLOAD_API_VERSION, are skipped.
+ * @param dir_path A pointer to the path of the directory.
+ * @param name A pointer to the name of the workload.
+ * @return A pointer to a newly created workload_module struct, NULL if no plugin exports the workload. This structure must be
+ * deallocated using the "close_workload()" function when you're done with it.
+*/
+workload_module* load_workload(const char* dir_path, const char* name){
+  struct workload_search search;
+
+  search.name = name;
+  search.module = open_workload(NULL);
+  scan_plugins(dir_path, match_workload, &search);
+  if(search.module->workload == NULL){
+    free(search.module);
+    return NULL;
+  }
+  return search.module;
+}
+
+/**
+ * @brief The "scan_plugins()" callback of "list_workloads()", which prints a workload.
+ * @param w A pointer to a workload struct.
+ * @param handle The handle of its plugin.
+ * @param arg The stream where to print the workload.
+ * @return Always 0, so that all the plugins are visited.
+*/
+static int print_workload(const workload* w, void* handle, void* arg){
+  fprintf((FILE*)arg, "\t%s: %s\n", w->name, w->description != NULL ? w->description : "");
+  return 0;
+}
+
+/**
+ * @brief Prints the name and the description of the workloads exported by the plugins of a directory, one per line.
+ * @param dir_path A pointer to the path of the directory.
+ * @param stream The stream where to print the workloads.
+ * @return The number of workloads found.
+*/
+int list_workloads(const char* dir_path, FILE* stream){
+  return scan_plugins(dir_path, print_workload, stream);
+}
+
+/**
+ * @brief Computes the path of the default workloads directory, which is the WORKLOAD_DIR_NAME directory next to the executable
+ * of the calling process.
+ * @return A pointer to a newly allocated string with the path. It must be freed when you're done with it.
+*/
+char* default_workload_dir(void){
+  char exe_path[PATH_MAX];
+  char* dir_path;
+  ssize_t len;
+
+  len = readlink("/proc/self/exe", exe_path, sizeof(exe_path) - 1);
+  if(len == -1){
+    fprintf(stderr, "default_workload_dir: error reading the path of the executable. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  exe_path[len] = '\0';
+  dir_path = (char*)malloc(PATH_MAX);
+  if(dir_path == NULL){
+    fprintf(stderr, "default_workload_dir: error allocating memory. Aborting ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  snprintf(dir_path, PATH_MAX, "%s/%s", dirname(exe_path), WORKLOAD_DIR_NAME);
+  return dir_path;
+}
+
+/**
+ * @brief Creates the state of a workload, calling its "init" callback. It must be called before the jobs, in the process that
+ * runs them.
+ * @param module A pointer to a workload_module struct.
+*/
+void workload_init(workload_module* module){
+  if(module->workload->init != NULL)
+    module->state = module->workload->init();
+}
+
+/**
+ * @brief Runs a job of a workload.
+ * @param module A pointer to a workload_module struct.
+ * @param param The parameter of the job.
+*/
+void workload_run(workload_module* module, long param){
+  module->workload->run(module->state, param);
+}
+
+/**
+ * @brief Frees up the state of a workload, calling its "teardown" callback.
+ * @param module A pointer to a workload_module struct.
+*/
+void workload_teardown(workload_module* module){
+  if(module->workload->teardown != NULL)
+    module->workload->teardown(module->state);
+  module->state = NULL;
+}
+
+/**
+ * @brief Closes a workload, unloading its plugin, and frees up the memory allocated for the workload_module struct. The state
+ * must have been freed up with "workload_teardown()".
+ * @param module A pointer to a workload_module struct.
+*/
+void close_workload(workload_module* module){
+  if(module->handle != NULL)
+    dlclose(module->handle);
+  free(module);
+}
@@ -0,0 +1,98 @@
+#ifndef WORKLOAD_H_
+#define WORKLOAD_H_
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <linux/types.h>
+#include "event_tracing.h"
+
+#define WORKLOAD_API_VERSION 1								///>Version of the workload struct, checked when a plugin is loaded.
+#define WORKLOAD_SYMBOL "workload_plugin"					///>Name of the workload struct exported by each plugin.
+#define WORKLOAD_SUFFIX ".so"								///>Suffix of the plugin files searched in the workloads directory.
+#define WORKLOAD_DIR_NAME "workloads"						///>Name of the default workloads directory, next to the executable.
+
+/**
+ * @brief A structure that describes a kind of job. A plugin is a shared object that exports a constant workload struct named
+ * WORKLOAD_SYMBOL, defined with the WORKLOAD_API_VERSION it has been compiled with. The state of a workload (buffers, file
+ * descriptors) is created by "init" outside the jobs, so that "run" measures only the work of a job.
+*/
+typedef struct workload{
+	int api_version; ///> The WORKLOAD_API_VERSION the workload has been compiled with.
+	const char* name; ///> The name of the workload, logged as the details of the execution information.
+	const char* description; ///> A short description of the workload.
+	void* (*init)(void); ///> Creates the state of the workload, or returns NULL if it has none. It can be NULL.
+	void (*run)(void* state, long param); ///> Runs a job of the workload, whose amount of work is proportional to param.
+	void (*teardown)(void* state); ///> Frees up the state of the workload. It can be NULL.
+} workload;
+
+/**
+ * @brief A structure that represents a workload ready to run, either built into the program or loaded from a plugin.
+*/
+typedef struct workload_module{
+	const workload* workload; ///> A pointer to the workload struct.
+	void* state; ///> The state created by the "init" callback of the workload.
+	void* handle; ///> The handle returned by dlopen(), NULL for the built-in workloads.
+} workload_module;
+
+/**
+ * @brief Wraps a workload built into the program, such as the default jobs of test_app, in a workload_module struct.
+ * @param w A pointer to the workload struct. It is not copied.
+ * @return A pointer to a newly created workload_module struct. This structure must be deallocated using the
+ * "close_workload()" function when you're done with it.
+*/
+workload_module* open_workload(const workload* w);
+
+/**
+ * @brief Loads a workload from the plugins of a directory, opening with dlopen() each WORKLOAD_SUFFIX file until the one that
+ * exports a workload with the given name is found. The files that can't be opened, or that don't export a WORKLOAD_SYMBOL of
+ * the current WORKLOAD_API_VERSION, are skipped.
+ * @param dir_path A pointer to the path of the directory.
+ * @param name A pointer to the name of the workload.
+ * @return A pointer to a newly created workload_module struct, NULL if no plugin exports the workload. This structure must be
+ * deallocated using the "close_workload()" function when you're done with it.
+*/
+workload_module* load_workload(const char* dir_path, const char* name);
+
+/**
+ * @brief Prints the name and the description of the workloads exported by the plugins of a directory, one per line.
+ * @param dir_path A pointer to the path of the directory.
+ * @param stream The stream where to print the workloads.
+ * @return The number of workloads found.
+*/
+int list_workloads(const char* dir_path, FILE* stream);
+
+/**
+ * @brief Computes the path of the default workloads directory, which is the WORKLOAD_DIR_NAME directory next to the executable
+ * of the calling process.
+ * @return A pointer to a newly allocated string with the path. It must be freed when you're done with it.
+*/
+char* default_workload_dir(void);
+
+/**
+ * @brief Creates the state of a workload, calling its "init" callback. It must be called before the jobs, in the process that
+ * runs them.
+ * @param module A pointer to a workload_module struct.
+*/
+void workload_init(workload_module* module);
+
+/**
+ * @brief Runs a job of a workload.
+ * @param module A pointer to a workload_module struct.
+ * @param param The parameter of the job.
+*/
+void workload_run(workload_module* module, long param);
+
+/**
+ * @brief Frees up the state of a workload, calling its "teardown" callback.
+ * @param module A pointer to a workload_module struct.
+*/
+void workload_teardown(workload_module* module);
+
+/**
+ * @brief Closes a workload, unloading its plugin, and frees up the memory allocated for the workload_module struct. The state
+ * must have been freed up with "workload_teardown()".
+ * @param module A pointer to a workload_module struct.
+*/
+void close_workload(workload_module* module);
+
+#endif
@@ -0,0 +1,110 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "array.h"
+
+IntArray *int_array_create(size_t capacity){
+  IntArray *array = (IntArray *)malloc(sizeof(IntArray));
+  if (array == NULL){
+    fprintf(stderr, "ERROR int_array_create: malloc cannot allocate memory\n");
+    return NULL;
+  }
+  if (capacity < ARRAY_MIN_CAPACITY){
+    capacity = ARRAY_MIN_CAPACITY;
+  }
+  array->data = (int *)malloc(capacity * sizeof(int));
+  if (array->data == NULL){
+    fprintf(stderr, "ERROR int_array_create: malloc cannot allocate memory\n");
+    free(array);
+    return NULL;
+  }
+  array->size = 0;
+  array->capacity = capacity;
+  return array;
+}
+
+void int_array_destroy(IntArray *array){
+  if (array == NULL){
+    return;
+  }
+  free(array->data);
+  free(array);
+}
+
+int int_array_push(IntArray *array, int value){
+  if (array->size == array->capacity){
+    // Doubling the capacity keeps the cost of the pushes amortized constant
+    int *data = (int *)realloc(array->data, 2 * array->capacity * sizeof(int));
+    if (data == NULL){
+      fprintf(stderr, "ERROR int_array_push: realloc cannot allocate memory\n");
+      return -1;
+    }
+    array->data = data;
+    array->capacity *= 2;
+  }
+  array->data[array->size++] = value;
+  return 0;
+}
+
+void int_array_clear(IntArray *array){
+  array->size = 0;
+}
+
+IntArray * int_array_clone(IntArray *array){
+  if (array == NULL){
+    return NULL;
+  }
+  IntArray *clone = int_array_create(array->size);
+  if (clone == NULL){
+    return NULL;
+  }
+  memcpy(clone->data, array->data, array->size * sizeof(int));
+  clone->size = array->size;
+  return clone;
+}
+
+static void int_array_merge(const int *src, int *dst, size_t begin, size_t middle, size_t end){
+  size_t i = begin, j = middle, k = begin;
+
+  while (i < middle && j < end){
+    dst[k++] = (src[i] <= src[j]) ? src[i++] : src[j++];
+  }
+  while (i < middle){
+    dst[k++] = src[i++];
+  }
+  while (j < end){
+    dst[k++] = src[j++];
+  }
+}
+
+void int_array_sort(IntArray *array){
+  // The same bottom-up merge sort of the lists, comparing the elements inline and moving them between two buffers
+  size_t n = array->size;
+  size_t middle, end;
+  int *src = array->data;
+  int *dst, *tmp;
+
+  if (n < 2){
+    return;
+  }
+  dst = (int *)malloc(n * sizeof(int));
+  if (dst == NULL){
+    fprintf(stderr, "ERROR int_array_sort: malloc cannot allocate memory\n");
+    exit(EXIT_FAILURE);
+  }
+  tmp = dst;
+  for (size_t width = 1; width < n; width *= 2){
+    for (size_t begin = 0; begin < n; begin += 2 * width){
+      middle = (begin + width < n) ? begin + width : n;
+      end = (begin + 2 * width < n) ? begin + 2 * width : n;
+      int_array_merge(src, dst, begin, middle, end);
+    }
+    int *swap = src;
+    src = dst;
+    dst = swap;
+  }
+  if (src != array->data){
+    memcpy(array->data, src, n * sizeof(int));
+  }
+  free(tmp);
+}
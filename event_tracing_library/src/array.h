@@ -0,0 +1,22 @@
+#ifndef ARRAY_H_
+#define ARRAY_H_
+
+#include <stddef.h>
+
+#define ARRAY_MIN_CAPACITY 16
+
+typedef struct IntArray
+{
+  int *data;
+  size_t size;
+  size_t capacity;
+} IntArray;
+
+IntArray * int_array_create(size_t capacity);
+void int_array_destroy(IntArray *array);
+int int_array_push(IntArray *array, int value);
+void int_array_clear(IntArray *array);
+IntArray * int_array_clone(IntArray *array);
+void int_array_sort(IntArray *array);
+
+#endif
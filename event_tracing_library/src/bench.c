@@ -0,0 +1,381 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <argp.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "../include/event_tracing.h"
+#include "../include/perf_counters.h"
+
+#define DEFAULT_ITERATIONS 1000000 //Default value of ITERATIONS command line argument
+#define DEFAULT_OUTPUT NULL //Default value of OUTPUT command line argument
+#define BENCH_VERSION "1.0" //Version of the library measured, written to each row of the OUTPUT file
+#define BENCH_CSV_HEADER "id,version,operation,scenario,iterations,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns,cycles_per_op,cycles_source\n"
+
+/**
+ * @brief A structure used to contain the command line arguments parsed from the user input.
+*/
+struct arguments {
+  long iterations; //It is a long integer value representing the number of calls of each operation in each scenario
+  char* output; //It is a string value representing the path of the CSV file where to append the results
+};
+
+/**
+ * @brief A structure used to contain what the operations need: the tracefs files, the execution information logged and the
+ * directory where it is logged.
+*/
+struct bench_context {
+  tracing_session* session; //It is the tracing session of the scenario, NULL if the tracefs is not available
+  exec_info* e_info; //It is the execution information logged by log_execution_info()
+  char* dir_path; //It is the temporary directory where the execution information is logged
+};
+
+/**
+ * @brief A structure used to describe an operation measured by the harness.
+*/
+struct bench_operation {
+  const char* name; //It is the name of the operation, as written to the results
+  void (*call)(struct bench_context* ctx, long i); //It is the function that calls the operation once
+  short needs_tracefs; //It is a flag used to specify that the operation can be measured only when the tracefs is available
+};
+
+//Program version.
+const char *argp_program_version = "Event Tracing Library " BENCH_VERSION;
+
+//Program bug report address.
+const char *argp_program_bug_address = "<riccardo.maino@edu.unito.it>";
+
+// Program documentation.
+static char doc[] = "This program measures the cost per call of the functions of the 'event_tracing' library, so that it can be subtracted \
+from the measured job times. Each operation is called ITERATIONS times in each scenario, timing each call with CLOCK_MONOTONIC, and its \
+mean and percentiles in nanoseconds are printed, together with the CPU cycles per call when the cycles hardware counter is available. \
+Possible [OPTION...] could be the following ones:\
+\vThe scenarios are the following ones:\n\
+\tevents_disabled: The tracefs is used, with all the events disabled.\n\
+\tsched_switch_enabled: The tracefs is used, with the sched_switch event of this process enabled.\n\
+\tlight: The tracefs is not available, so the library measures the jobs with the unprivileged backend.\n\n\
+The 'timer' operation is the cost of the two clock_gettime() calls around each measured call, included in the other results.\n";
+
+// The command line options accepted to obtain the arguments contained in the 'struct arguments' structure
+static struct argp_option options[] = {
+  {"iterations", 'n', "ITERATIONS", 0, "A long integer used to set the number of calls of each operation in each scenario. The ITERATIONS argument must be a positive long integer. Default is 1000000."},
+  {"output", 'o', "OUTPUT", 0, "A string used to set the path of a CSV file where to append the results, one row per operation and scenario, writing the header if the file is empty. Appending the results of several versions of the library to the same file allows to track its regressions."},
+  {0}
+};
+
+/**
+ * @brief Parses a single command line argument.
+ * @param key An integer that represents a command line argument.
+ * @param arg A pointer to the value of the command line argument.
+ * @param state A pointer to a structure that contains the state of the parser.
+ * @return 0 if the argument has been parsed, ARGP_ERR_UNKNOWN otherwise.
+*/
+static error_t parse_opt(int key, char *arg, struct argp_state *state){
+  struct arguments *arguments = state->input;
+  char* end_ptr;
+
+  errno = 0;
+  switch (key){
+    case 'n':
+      arguments->iterations = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--iterations' option");
+      }
+      if(arguments->iterations <= 0){
+        argp_error(state, "Invalid argument for '--iterations' option");
+      }
+      break;
+    case 'o':
+      arguments->output = arg;
+      break;
+    default:
+      return ARGP_ERR_UNKNOWN;
+  }
+  return 0;
+}
+
+//The ARGP parser
+static struct argp argp = { options, parse_opt, 0, doc };
+
+void call_timer(struct bench_context* ctx, long i);
+void call_trace_mark_job(struct bench_context* ctx, long i);
+void call_trace_mark_job_session(struct bench_context* ctx, long i);
+void call_trace_mark_job_raw_session(struct bench_context* ctx, long i);
+void call_tracing_write(struct bench_context* ctx, long i);
+void call_log_execution_info(struct bench_context* ctx, long i);
+void call_set_scheduler_policy(struct bench_context* ctx, long i);
+void run_bench(struct bench_context* ctx, const struct bench_operation* op, const char* scenario, long iterations, __u64* samples,
+               perf_counters* counters, const char* id, FILE* output);
+void remove_directory(const char* dir_path);
+
+// The operations measured in each scenario
+static const struct bench_operation operations[] = {
+  {"timer", call_timer, 0},
+  {"trace_mark_job", call_trace_mark_job, 0},
+  {"trace_mark_job_session", call_trace_mark_job_session, 1},
+  {"trace_mark_job_raw_session", call_trace_mark_job_raw_session, 1},
+  {"tracing_write", call_tracing_write, 1},
+  {"log_execution_info", call_log_execution_info, 0},
+  {"set_scheduler_policy", call_set_scheduler_policy, 0}
+};
+
+int main(int argc, char *argv[]){
+  struct arguments arguments;                // A structure used to store the command line arguments
+  struct bench_context ctx;                  // The context passed to the operations
+  const char* scenarios[2];                  // The names of the scenarios run
+  int n_scenarios;                           // The number of scenarios run
+  int n_operations;                          // The number of operations measured
+  __u64* samples;                            // The duration of each call of the operation measured
+  perf_counters* counters;                   // A pointer to a structure that counts the CPU cycles, if available
+  FILE* output = NULL;                       // The CSV file where to append the results, if requested
+  char dir_template[] = "/tmp/bench_XXXXXX"; // The template of the temporary directory where the execution information is logged
+
+  // Default values of command line arguments
+  arguments.iterations = DEFAULT_ITERATIONS;
+  arguments.output = DEFAULT_OUTPUT;
+
+  // Parse command line arguments
+  if(argp_parse(&argp, argc, argv, 0, 0, &arguments) != 0){
+    fprintf(stderr, "Parsing command line arguments error ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  samples = (__u64*)malloc(arguments.iterations * sizeof(__u64));
+  ctx.dir_path = mkdtemp(dir_template);
+  if(samples == NULL || ctx.dir_path == NULL){
+    fprintf(stderr, "Error allocating the resources of the harness ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  if(arguments.output != NULL){
+    output = fopen(arguments.output, "a");
+    if(output == NULL){
+      fprintf(stderr, "Error opening \"%s\" file ...\n", arguments.output);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    if(ftell(output) == 0)
+      fputs(BENCH_CSV_HEADER, output);
+  }
+  ctx.e_info = create_exec_info(0, 0, "Bench");
+  ctx.session = NULL;
+  counters = create_perf_counters(0);
+  n_operations = sizeof(operations) / sizeof(operations[0]);
+
+  if(tracefs_available()){
+    scenarios[0] = "events_disabled";
+    scenarios[1] = "sched_switch_enabled";
+    n_scenarios = 2;
+  }else{
+    scenarios[0] = "light";
+    n_scenarios = 1;
+  }
+
+  printf("*** Execution ID: %s\n", ctx.e_info->id);
+  printf("*** ITERATIONS: %ld, cycles counter: %s\n", arguments.iterations, counters->fd[PERF_CYCLES] != -1 ? "available" : "not available");
+  printf("%-28s %-22s %10s %10s %10s %10s %10s %12s %10s\n", "OPERATION", "SCENARIO", "MEAN_NS", "P50_NS", "P90_NS", "P99_NS",
+         "P99.9_NS", "MAX_NS", "CYCLES/OP");
+  for(int s = 0; s < n_scenarios; s++){
+    // Setting up the tracefs as test_app does, so that the markers are written to a ring buffer that is recording
+    if(strcmp(scenarios[s], "light") != 0){
+      ctx.session = create_tracing_session(NULL);
+      ENABLE_TRACING_SESSION(ctx.session);
+      if(strcmp(scenarios[s], "sched_switch_enabled") == 0){
+        set_event_filter_session(ctx.session, getpid(), E_SCHED_SWITCH, SET);
+        event_record_session(ctx.session, E_SCHED_SWITCH, ENABLE);
+      }
+    }
+    for(int o = 0; o < n_operations; o++){
+      if(operations[o].needs_tracefs && ctx.session == NULL)
+        continue;
+      run_bench(&ctx, &operations[o], scenarios[s], arguments.iterations, samples, counters, ctx.e_info->id, output);
+    }
+    if(ctx.session != NULL){
+      event_record_session(ctx.session, E_SCHED_SWITCH, DISABLE);
+      set_event_filter_session(ctx.session, getpid(), E_SCHED_SWITCH, RESET);
+      clean_trace_session(ctx.session);
+      DISABLE_TRACING_SESSION(ctx.session);
+      destroy_tracing_session(ctx.session);
+      ctx.session = NULL;
+    }
+  }
+
+  if(output != NULL){
+    fclose(output);
+    printf("*** DONE. The results have been appended to '%s'\n", arguments.output);
+  }
+  remove_directory(ctx.dir_path);
+  destroy_perf_counters(counters);
+  destroy_exec_info(ctx.e_info);
+  free(samples);
+  return 0;
+}
+
+
+/**
+ * @brief It compares two unsigned 64-bit integers, in order to sort the samples with qsort()
+ * @param a is the pointer to the first value
+ * @param b is the pointer to the second value
+ * @return an integer greater than 0 if a > b, lower than 0 if a < b, 0 otherwise
+*/
+int compare_u64(const void* a, const void* b){
+  __u64 x = *(const __u64*)a;
+  __u64 y = *(const __u64*)b;
+
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief It measures an operation, calling it after a warm-up as many times as the iterations and timing each call, then it prints
+ * its results and appends them to the CSV file, if any
+ * @param ctx is the context passed to the operation
+ * @param op is the operation
+ * @param scenario is the name of the scenario
+ * @param iterations is the number of calls
+ * @param samples is the array where to store the duration of each call
+ * @param counters is the structure that counts the CPU cycles of all the calls
+ * @param id is the identifier of this run of the harness
+ * @param output is the CSV file, NULL if the results are only printed
+*/
+void run_bench(struct bench_context* ctx, const struct bench_operation* op, const char* scenario, long iterations, __u64* samples,
+               perf_counters* counters, const char* id, FILE* output){
+  struct timespec start, end;
+  long warmup = iterations / 100 < 1000 ? iterations / 100 : 1000;
+  double mean = 0, cycles = -1;
+  const char* cycles_source = "none";
+  __u64 p50, p90, p99, p999, max;
+
+  for(long i = 0; i < warmup; i++){
+    op->call(ctx, i);
+  }
+  perf_counters_job_start(counters);
+  for(long i = 0; i < iterations; i++){
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    op->call(ctx, i);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    samples[i] = (end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec;
+  }
+  perf_counters_job_end(counters, NULL);
+
+  for(long i = 0; i < iterations; i++){
+    mean += samples[i];
+  }
+  mean /= iterations;
+  qsort(samples, iterations, sizeof(__u64), compare_u64);
+  p50 = samples[(long)(0.5 * (iterations - 1))];
+  p90 = samples[(long)(0.9 * (iterations - 1))];
+  p99 = samples[(long)(0.99 * (iterations - 1))];
+  p999 = samples[(long)(0.999 * (iterations - 1))];
+  max = samples[iterations - 1];
+  if(counters->fd[PERF_CYCLES] != -1){
+    cycles = (double)counters->values[PERF_CYCLES] / iterations;
+    cycles_source = "perf";
+  }
+
+  printf("%-28s %-22s %10.1f %10llu %10llu %10llu %10llu %12llu %10.1f\n", op->name, scenario, mean, (unsigned long long)p50,
+         (unsigned long long)p90, (unsigned long long)p99, (unsigned long long)p999, (unsigned long long)max, cycles);
+  fflush(stdout);
+  if(output != NULL){
+    fprintf(output, "%s,%s,%s,%s,%ld,%.1f,%llu,%llu,%llu,%llu,%llu,%.1f,%s\n", id, BENCH_VERSION, op->name, scenario, iterations, mean,
+            (unsigned long long)p50, (unsigned long long)p90, (unsigned long long)p99, (unsigned long long)p999,
+            (unsigned long long)max, cycles, cycles_source);
+    fflush(output);
+  }
+}
+
+/**
+ * @brief It removes the temporary directory where the execution information has been logged, with the execution directories in it
+ * @param dir_path is the path of the directory
+*/
+void remove_directory(const char* dir_path){
+  char path[PATH_MAX];
+  struct dirent* entry;
+  struct stat st;
+  DIR* dir;
+
+  dir = opendir(dir_path);
+  if(dir == NULL)
+    return;
+  while((entry = readdir(dir)) != NULL){
+    if(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+      continue;
+    snprintf(path, sizeof(path), "%s/%s", dir_path, entry->d_name);
+    if(lstat(path, &st) == 0 && S_ISDIR(st.st_mode))
+      remove_directory(path);
+    else
+      unlink(path);
+  }
+  closedir(dir);
+  rmdir(dir_path);
+}
+
+/**
+ * @brief It does nothing, in order to measure the cost of timing a call
+ * @param ctx is not used
+ * @param i is not used
+*/
+void call_timer(struct bench_context* ctx, long i){
+}
+
+/**
+ * @brief It marks the beginning of a job on even iterations and its end on odd ones, opening the trace_marker file at each call,
+ * or measuring the job with the unprivileged backend if the tracefs is not available
+ * @param ctx is not used
+ * @param i is the iteration
+*/
+void call_trace_mark_job(struct bench_context* ctx, long i){
+  trace_mark_job(i / 2 + 1, i % 2 == 0 ? START : STOP);
+}
+
+/**
+ * @brief It marks the beginning or the end of a job with a text marker, on the trace_marker file kept open by the session
+ * @param ctx contains the tracing session
+ * @param i is the iteration
+*/
+void call_trace_mark_job_session(struct bench_context* ctx, long i){
+  trace_mark_job_session(ctx->session, i / 2 + 1, i % 2 == 0 ? START : STOP);
+}
+
+/**
+ * @brief It marks the beginning or the end of a job with a binary record, on the trace_marker_raw file kept open by the session
+ * @param ctx contains the tracing session
+ * @param i is the iteration
+*/
+void call_trace_mark_job_raw_session(struct bench_context* ctx, long i){
+  trace_mark_job_raw_session(ctx->session, i / 2 + 1, i % 2 == 0 ? START : STOP, i);
+}
+
+/**
+ * @brief It writes a short string to the trace_marker file, opening it at each call
+ * @param ctx is not used
+ * @param i is not used
+*/
+void call_tracing_write(struct bench_context* ctx, long i){
+  tracing_write(TRACE_MARKER_PATH, "bench");
+}
+
+/**
+ * @brief It appends the execution information of a job to the exec.txt file of the temporary directory
+ * @param ctx contains the execution information and the directory
+ * @param i is the iteration, used as job number
+*/
+void call_log_execution_info(struct bench_context* ctx, long i){
+  ctx->e_info->job_number = i + 1;
+  log_execution_info(ctx->dir_path, ctx->e_info->id, ctx->e_info, NULL, DEFAULT_INFO);
+}
+
+/**
+ * @brief It sets the SCHED_OTHER policy of this process, which keeps the policy it already has, so that only the cost of the call is
+ * measured and the following operations aren't affected
+ * @param ctx is not used
+ * @param i is not used
+*/
+void call_set_scheduler_policy(struct bench_context* ctx, long i){
+  set_scheduler_policy(0, SCHED_OTHER, 0, NULL);
+}
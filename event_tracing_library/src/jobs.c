@@ -0,0 +1,215 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include "jobs.h"
+#include "array.h"
+
+// The jobs of the MODE argument of test_app, in the order of their values
+const workload builtin_workloads[] = {
+  {WORKLOAD_API_VERSION, "EmptyLoop", "Empty loop job", NULL, do_work, NULL},
+  {WORKLOAD_API_VERSION, "VariablesExchanging", "Variables exchanging job", NULL, do_work_exchanging, NULL},
+  {WORKLOAD_API_VERSION, "ListOrdering", "List ordering job", init_ordering, do_work_ordering, teardown_ordering},
+  {WORKLOAD_API_VERSION, "ArrayOrdering", "Array ordering job", init_ordering, do_work_array_ordering, teardown_ordering},
+  {WORKLOAD_API_VERSION, "ListOrderingPool", "List ordering job with a free-list pool allocator", init_ordering_pool, do_work_ordering, teardown_ordering},
+  {WORKLOAD_API_VERSION, "ListOrderingArena", "List ordering job with a bump arena allocator", init_ordering_arena, do_work_ordering, teardown_ordering}
+};
+const int n_builtin_workloads = sizeof(builtin_workloads) / sizeof(builtin_workloads[0]);
+
+//The number of elements of the lists of the ordering jobs, set before the workloads are initialized
+static int ordering_length = ORDERING_DEFAULT_LENGTH;
+
+/**
+ * @brief It sets the number of elements of the lists of the ordering jobs created from now on, since the workloads are
+ * initialized without arguments
+ * @param length is the number of elements
+*/
+void set_ordering_length(int length){
+  ordering_length = length;
+}
+
+/**
+ * @brief It checks whether a job sorts lists or arrays, whose length is then logged as an extra metric
+ * @param w is the workload of the job
+ * @return 1 if it is an ordering job, 0 otherwise
+*/
+int is_ordering_job(const workload* w){
+  return w->run == do_work_ordering || w->run == do_work_array_ordering;
+}
+
+/**
+ * @brief It opens a job by name, searching it among the built-in jobs and then among the plugins of a directory
+ * @param name is the name of the job
+ * @param dir_path is the path of the directory of the plugins
+ * @return a pointer to the workload_module struct of the job, NULL if it isn't found
+*/
+workload_module* open_job(const char* name, const char* dir_path){
+  for(int i = 0; i < n_builtin_workloads; i++){
+    if(strcmp(name, builtin_workloads[i].name) == 0)
+      return open_workload(&builtin_workloads[i]);
+  }
+  return load_workload(dir_path, name);
+}
+
+/**
+ * @brief It prints the name and the description of the built-in jobs and of the plugins of a directory, one per line
+ * @param dir_path is the path of the directory of the plugins
+ * @param stream is the stream where to print the jobs
+*/
+void list_jobs(const char* dir_path, FILE* stream){
+  for(int i = 0; i < n_builtin_workloads; i++)
+    fprintf(stream, "\t%s: %s\n", builtin_workloads[i].name, builtin_workloads[i].description);
+  list_workloads(dir_path, stream);
+}
+
+/**
+ * @brief It performs a basic empty loop.
+ * @param state is not used, since the job has no state.
+ * @param param is used as the upper bound of the loop index.
+ */
+void do_work(void* state, long param){
+  long num = param;
+  for (long i = 0; i < num; i++){
+  }
+}
+
+/**
+ * @brief It performs a loop where some random variables are swapped each other.
+ * @param state is not used, since the job has no state.
+ * @param param is used as the upper bound of the loop index.
+ */
+void do_work_exchanging(void* state, long param){
+  long num = param;
+  int a, b, temp;
+  srand(time(NULL));
+  for (long i = 0; i < num; i++){
+    a = rand() % 1000 + 1;
+    b = rand() % 1000 + 1;
+    temp = a;
+    a = b;
+    b = temp;
+  }
+}
+
+
+/**
+ * @brief It is the comparing function for integers
+ * @param a is the pointer to the first integer value to be compared
+ * @param b is the pointer to the second integer values to be compared
+ * @return an integer greater than 0 if and only if a > b or an integer lower than 0 if and only if a < b,
+ * otherwise it return 0 if and only if a == b
+*/
+int compare_integer(void* a, void* b){
+  return *(int *)a - *(int *)b;
+}
+
+/**
+ * @brief It creates the state of the ordering job, with ordering_length pseudo-random values
+ * @param allocator is the allocator of the lists, NULL to use malloc()
+ * @return a pointer to the state
+ */
+struct ordering_state* create_ordering_state(ListAllocator* allocator){
+  struct ordering_state* ordering;
+  unsigned int seed = ORDERING_SEED;
+
+  ordering = (struct ordering_state*)malloc(sizeof(*ordering));
+  if(ordering == NULL || (ordering->values = (int*)malloc(ordering_length * sizeof(int))) == NULL){
+    fprintf(stderr, "Error allocating the state of the ordering job ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  for(int i = 0; i < ordering_length; i++)
+    ordering->values[i] = rand_r(&seed);
+  ordering->allocator = allocator;
+  ordering->length = ordering_length;
+  return ordering;
+}
+
+/**
+ * @brief It creates the state of the ordering job whose lists are allocated with malloc()
+ * @return a pointer to the state
+ */
+void* init_ordering(void){
+  return create_ordering_state(NULL);
+}
+
+/**
+ * @brief It creates the state of the ordering job whose lists are allocated from a free-list pool, so that freed nodes are
+ * reused without malloc()
+ * @return a pointer to the state
+ */
+void* init_ordering_pool(void){
+  ListAllocator* allocator = list_pool_allocator_create(LIST_POOL_CHUNK_BLOCKS);
+  if(allocator == NULL)
+    exit(EXIT_FAILURE);
+  return create_ordering_state(allocator);
+}
+
+/**
+ * @brief It creates the state of the ordering job whose lists are allocated from a bump arena, which is reset after each list.
+ * The chunks of the arena fit a whole list
+ * @return a pointer to the state
+ */
+void* init_ordering_arena(void){
+  size_t list_size = sizeof(List) + (size_t)ordering_length * sizeof(Node) * 2;
+  ListAllocator* allocator = list_arena_allocator_create(list_size > LIST_ARENA_CHUNK_SIZE ? list_size : LIST_ARENA_CHUNK_SIZE);
+  if(allocator == NULL)
+    exit(EXIT_FAILURE);
+  return create_ordering_state(allocator);
+}
+
+/**
+ * @brief It destroys the state of the ordering job
+ * @param state is the state
+ */
+void teardown_ordering(void* state){
+  struct ordering_state* ordering = (struct ordering_state*)state;
+
+  list_allocator_destroy(ordering->allocator);
+  free(ordering->values);
+  free(ordering);
+}
+
+/**
+ * @brief It performs a loop where it creates, sorts and deletes a list.
+ * @param state is the state of the job, with the values of the list and its allocator.
+ * @param param is used as the upper bound of the loop index.
+ */
+void do_work_ordering(void* state, long param){
+  struct ordering_state* ordering = (struct ordering_state*)state;
+  long num = param;
+
+  for(long i = 0; i<num; i++){
+    List * list = list_create_with(ordering->allocator);
+    for(int j = 0; j < ordering->length; j++)
+      list_add(list, &ordering->values[j]);
+    list_sort(list, compare_integer);
+    list_destroy(list);
+    list_allocator_reset(ordering->allocator);
+  }
+}
+
+/**
+ * @brief It performs a loop where it creates, sorts and deletes an array, with the same values and the same merge sort of the
+ * list ordering job. The elements are stored inline in a single allocation and compared without calling a function, so the
+ * difference from the list ordering job is the cost of the cache misses and of the indirect calls of the list.
+ * @param state is the state of the job, with the values of the array.
+ * @param param is used as the upper bound of the loop index.
+ */
+void do_work_array_ordering(void* state, long param){
+  struct ordering_state* ordering = (struct ordering_state*)state;
+  long num = param;
+
+  for(long i = 0; i<num; i++){
+    IntArray * array = int_array_create(ordering->length);
+    if(array == NULL)
+      exit(EXIT_FAILURE);
+    // The values are pushed in the order of the nodes of the list, which are added at its head, so both sort the same sequence
+    for(int j = ordering->length - 1; j >= 0; j--)
+      int_array_push(array, ordering->values[j]);
+    int_array_sort(array);
+    int_array_destroy(array);
+  }
+}
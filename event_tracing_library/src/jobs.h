@@ -0,0 +1,65 @@
+#ifndef JOBS_H_
+#define JOBS_H_
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <linux/types.h>
+#include "../include/workload.h"
+#include "list.h"
+
+#define ORDERING_SEED 1 //Seed of the values of the lists of the ordering jobs, fixed so that all the executions sort the same lists
+#define ORDERING_DEFAULT_LENGTH 5 //Default number of elements of the lists of the ordering jobs
+
+/**
+ * @brief A structure used to contain the state of the list ordering jobs, created before the jobs.
+*/
+struct ordering_state {
+  ListAllocator* allocator; //It is the allocator of the lists and their nodes, NULL to use malloc()
+  int* values; //It is the array of the values added to each list
+  int length; //It is an integer value representing the number of elements of each list
+};
+
+// The built-in jobs, in the order of the values of the MODE argument of test_app
+extern const workload builtin_workloads[];
+extern const int n_builtin_workloads;
+
+/**
+ * @brief It sets the number of elements of the lists of the ordering jobs created from now on, since the workloads are
+ * initialized without arguments
+ * @param length is the number of elements
+*/
+void set_ordering_length(int length);
+
+/**
+ * @brief It checks whether a job sorts lists or arrays, whose length is then logged as an extra metric
+ * @param w is the workload of the job
+ * @return 1 if it is an ordering job, 0 otherwise
+*/
+int is_ordering_job(const workload* w);
+
+/**
+ * @brief It opens a job by name, searching it among the built-in jobs and then among the plugins of a directory
+ * @param name is the name of the job
+ * @param dir_path is the path of the directory of the plugins
+ * @return a pointer to the workload_module struct of the job, NULL if it isn't found
+*/
+workload_module* open_job(const char* name, const char* dir_path);
+
+/**
+ * @brief It prints the name and the description of the built-in jobs and of the plugins of a directory, one per line
+ * @param dir_path is the path of the directory of the plugins
+ * @param stream is the stream where to print the jobs
+*/
+void list_jobs(const char* dir_path, FILE* stream);
+
+void do_work(void* state, long param);
+void do_work_exchanging(void* state, long param);
+void do_work_ordering(void* state, long param);
+void do_work_array_ordering(void* state, long param);
+struct ordering_state* create_ordering_state(ListAllocator* allocator);
+void* init_ordering(void);
+void* init_ordering_pool(void);
+void* init_ordering_arena(void);
+void teardown_ordering(void* state);
+
+#endif
@@ -1,15 +1,229 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <stddef.h>
 #include "list.h"
 
+// The lists and their nodes are served by the same allocator, so the blocks of a pool fit both
+#define LIST_BLOCK_SIZE (sizeof(List) > sizeof(Node) ? sizeof(List) : sizeof(Node))
+
+typedef struct PoolChunk
+{
+  struct PoolChunk *next;
+} PoolChunk;
+
+typedef struct Pool
+{
+  void *free_list;
+  PoolChunk *chunks;
+  int blocks_per_chunk;
+} Pool;
+
+typedef struct ArenaChunk
+{
+  struct ArenaChunk *next;
+  size_t used;
+  size_t capacity;
+  max_align_t data[];
+} ArenaChunk;
+
+typedef struct Arena
+{
+  ArenaChunk *first;
+  ArenaChunk *current;
+  size_t chunk_size;
+} Arena;
+
+static void *malloc_alloc(ListAllocator *allocator, size_t size){
+  (void)allocator;
+  return malloc(size);
+}
+
+static void malloc_free(ListAllocator *allocator, void *ptr){
+  (void)allocator;
+  free(ptr);
+}
+
+static ListAllocator malloc_allocator = {malloc_alloc, malloc_free, NULL, NULL, NULL};
+
+ListAllocator * list_malloc_allocator(){
+  return &malloc_allocator;
+}
+
+static void *pool_alloc(ListAllocator *allocator, size_t size){
+  Pool *pool = (Pool *)allocator->ctx;
+  void *block;
+
+  if (size > LIST_BLOCK_SIZE){
+    fprintf(stderr, "ERROR pool_alloc: the pool cannot serve blocks of %zu bytes\n", size);
+    return NULL;
+  }
+  if (pool->free_list == NULL){
+    // A new chunk is a header followed by blocks_per_chunk blocks, which are threaded on the free list
+    PoolChunk *chunk = (PoolChunk *)malloc(sizeof(PoolChunk) + (size_t)pool->blocks_per_chunk * LIST_BLOCK_SIZE);
+    if (chunk == NULL){
+      fprintf(stderr, "ERROR pool_alloc: malloc cannot allocate memory\n");
+      return NULL;
+    }
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    for (int i = pool->blocks_per_chunk - 1; i >= 0; i--){
+      block = (char *)(chunk + 1) + (size_t)i * LIST_BLOCK_SIZE;
+      *(void **)block = pool->free_list;
+      pool->free_list = block;
+    }
+  }
+  block = pool->free_list;
+  pool->free_list = *(void **)block;
+  return block;
+}
+
+static void pool_free(ListAllocator *allocator, void *ptr){
+  Pool *pool = (Pool *)allocator->ctx;
+
+  if (ptr == NULL){
+    return;
+  }
+  *(void **)ptr = pool->free_list;
+  pool->free_list = ptr;
+}
+
+static void pool_destroy(ListAllocator *allocator){
+  Pool *pool = (Pool *)allocator->ctx;
+
+  while (pool->chunks != NULL){
+    PoolChunk *next = pool->chunks->next;
+    free(pool->chunks);
+    pool->chunks = next;
+  }
+  free(pool);
+  free(allocator);
+}
+
+ListAllocator * list_pool_allocator_create(int blocks_per_chunk){
+  ListAllocator *allocator = (ListAllocator *)malloc(sizeof(ListAllocator));
+  Pool *pool = (Pool *)malloc(sizeof(Pool));
+  if (allocator == NULL || pool == NULL || blocks_per_chunk <= 0){
+    fprintf(stderr, "ERROR list_pool_allocator_create: cannot create the pool\n");
+    free(allocator);
+    free(pool);
+    return NULL;
+  }
+  pool->free_list = NULL;
+  pool->chunks = NULL;
+  pool->blocks_per_chunk = blocks_per_chunk;
+  allocator->alloc = pool_alloc;
+  allocator->free = pool_free;
+  allocator->reset = NULL;
+  allocator->destroy = pool_destroy;
+  allocator->ctx = pool;
+  return allocator;
+}
+
+static ArenaChunk *arena_chunk_create(size_t capacity){
+  ArenaChunk *chunk = (ArenaChunk *)malloc(sizeof(ArenaChunk) + capacity);
+  if (chunk == NULL){
+    fprintf(stderr, "ERROR arena_chunk_create: malloc cannot allocate memory\n");
+    return NULL;
+  }
+  chunk->next = NULL;
+  chunk->used = 0;
+  chunk->capacity = capacity;
+  return chunk;
+}
+
+static void *arena_alloc(ListAllocator *allocator, size_t size){
+  Arena *arena = (Arena *)allocator->ctx;
+  void *ptr;
+
+  size = (size + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t);
+  // The chunks left by a reset are reused before allocating new ones
+  while (arena->current->used + size > arena->current->capacity){
+    if (arena->current->next == NULL){
+      arena->current->next = arena_chunk_create(size > arena->chunk_size ? size : arena->chunk_size);
+      if (arena->current->next == NULL){
+        return NULL;
+      }
+    }
+    arena->current = arena->current->next;
+    arena->current->used = 0;
+  }
+  ptr = (char *)arena->current->data + arena->current->used;
+  arena->current->used += size;
+  return ptr;
+}
+
+static void arena_free(ListAllocator *allocator, void *ptr){
+  // The nodes of an arena are freed all together by its reset
+  (void)allocator;
+  (void)ptr;
+}
+
+static void arena_reset(ListAllocator *allocator){
+  Arena *arena = (Arena *)allocator->ctx;
+
+  arena->current = arena->first;
+  arena->current->used = 0;
+}
+
+static void arena_destroy(ListAllocator *allocator){
+  Arena *arena = (Arena *)allocator->ctx;
+
+  while (arena->first != NULL){
+    ArenaChunk *next = arena->first->next;
+    free(arena->first);
+    arena->first = next;
+  }
+  free(arena);
+  free(allocator);
+}
+
+ListAllocator * list_arena_allocator_create(size_t chunk_size){
+  ListAllocator *allocator = (ListAllocator *)malloc(sizeof(ListAllocator));
+  Arena *arena = (Arena *)malloc(sizeof(Arena));
+  if (allocator == NULL || arena == NULL || chunk_size == 0 || (arena->first = arena_chunk_create(chunk_size)) == NULL){
+    fprintf(stderr, "ERROR list_arena_allocator_create: cannot create the arena\n");
+    free(allocator);
+    free(arena);
+    return NULL;
+  }
+  arena->current = arena->first;
+  arena->chunk_size = chunk_size;
+  allocator->alloc = arena_alloc;
+  allocator->free = arena_free;
+  allocator->reset = arena_reset;
+  allocator->destroy = arena_destroy;
+  allocator->ctx = arena;
+  return allocator;
+}
+
+void list_allocator_reset(ListAllocator *allocator){
+  if (allocator != NULL && allocator->reset != NULL){
+    allocator->reset(allocator);
+  }
+}
+
+void list_allocator_destroy(ListAllocator *allocator){
+  if (allocator != NULL && allocator->destroy != NULL){
+    allocator->destroy(allocator);
+  }
+}
+
 List *list_create(){
-  List *list = (List *)malloc(sizeof(List));
+  return list_create_with(NULL);
+}
+
+List *list_create_with(ListAllocator *allocator){
+  if (allocator == NULL){
+    allocator = &malloc_allocator;
+  }
+  List *list = (List *)allocator->alloc(allocator, sizeof(List));
   if (list == NULL){
-    fprintf(stderr, "ERROR list_create: malloc cannot allocate memory\n");
+    fprintf(stderr, "ERROR list_create: cannot allocate memory\n");
     return NULL;
   }
   list->head = NULL;
   list->size = 0;
+  list->allocator = allocator;
   return list;
 }
 
@@ -17,44 +231,53 @@ void list_destroy(List *list){
   if (list == NULL){
     return;
   }
+  ListAllocator *allocator = list->allocator;
   Node *current = list->head;
   while (current != NULL){
     Node *next = current->next;
-    free(current);
+    allocator->free(allocator, current);
     current = next;
   }
-  free(list);
+  allocator->free(allocator, list);
 }
 
 List * list_clone(List * l){
-  List * clone = (List *)malloc(sizeof(*clone));
-  if(l != NULL && l->head == NULL){
-    clone->head = list_clone_aux(l->head, NULL);
-    clone->size = l->size;
+  if(l == NULL){
+    return NULL;
+  }
+  List * clone = list_create_with(l->allocator);
+  if(clone == NULL){
+    return NULL;
   }
+  clone->head = list_clone_aux(l->head, l->allocator);
+  clone->size = l->size;
   return clone;
 }
 
-Node * list_clone_aux(Node *l, Node*clone){
-  if(l == NULL){
-    return NULL;
-  }else{
-    clone = list_clone_aux(l->next, clone);
-    Node *new_node = (Node *)malloc(sizeof(Node));
+Node * list_clone_aux(Node *l, ListAllocator *allocator){
+  // The copies are appended to the tail, so the stack doesn't grow with the length of the list
+  Node head;
+  Node *tail = &head;
+  head.next = NULL;
+  while(l != NULL){
+    Node *new_node = (Node *)allocator->alloc(allocator, sizeof(Node));
     if (new_node == NULL){
-      fprintf(stderr, "ERROR list_add: malloc cannot allocate memory\n");
+      fprintf(stderr, "ERROR list_clone: cannot allocate memory\n");
       exit(EXIT_FAILURE);
     }
-    new_node->data = l;
-    new_node->next = clone;
-    return new_node;
+    new_node->data = l->data;
+    new_node->next = NULL;
+    tail->next = new_node;
+    tail = new_node;
+    l = l->next;
   }
+  return head.next;
 }
 
 void list_add(List *list, void *data){
-  Node *new_node = (Node *)malloc(sizeof(Node));
+  Node *new_node = (Node *)list->allocator->alloc(list->allocator, sizeof(Node));
   if (new_node == NULL){
-    fprintf(stderr, "ERROR list_add: malloc cannot allocate memory\n");
+    fprintf(stderr, "ERROR list_add: cannot allocate memory\n");
     return;
   }
   new_node->data = data;
@@ -77,7 +300,7 @@ void list_delete(List *list, void *data, int (*compare)(void *, void *)){
       }else{
         prev->next = current->next;
       }
-      free(current);
+      list->allocator->free(list->allocator, current);
       list->size--;
       return;
     }
@@ -98,31 +321,61 @@ void list_print(List *l){
   printf("NULL. Size: %d\n", l->size);
 }
 
+void list_sort(List *list, int (*compare)(void *, void *)){
+  if (list == NULL){
+    return;
+  }
+  list->head = mergesort(list->head, compare);
+}
+
 Node* mergesort(Node* l, int (*compare)(void *, void *)){
-  if(l == NULL || l->next == NULL){
-    return l;
-  }else{
-    Node *m = split(l);
-    l = mergesort(l, compare);
-    m = mergesort(m, compare);
-    return merge(l, m, compare);
+  // Bottom-up: bins[i] holds a sorted run of 2^i nodes, which come before the nodes of the lower bins, so the merges are stable
+  // and the stack doesn't grow with the length of the list
+  Node *bins[LIST_SORT_BINS] = {NULL};
+  Node *run;
+  int i, max_bin = 0;
+
+  while(l != NULL){
+    run = l;
+    l = l->next;
+    run->next = NULL;
+    for(i = 0; i < LIST_SORT_BINS - 1 && bins[i] != NULL; i++){
+      run = merge(bins[i], run, compare);
+      bins[i] = NULL;
+    }
+    if(bins[i] != NULL){
+      run = merge(bins[i], run, compare);
+    }
+    bins[i] = run;
+    if(i > max_bin){
+      max_bin = i;
+    }
+  }
+  run = NULL;
+  for(i = 0; i <= max_bin; i++){
+    if(bins[i] != NULL){
+      run = merge(bins[i], run, compare);
+    }
   }
+  return run;
 }
 
 Node* merge(Node *l, Node *m, int (*compare)(void *, void *)){
-  if(l == NULL){
-    return m;
-  }else if(m == NULL){
-    return l;
-  }else{
-    if(compare(l->data, m->data) < 0){
-      l->next = merge(l->next, m, compare);
-      return l;
+  Node head;
+  Node *tail = &head;
+
+  while(l != NULL && m != NULL){
+    if(compare(l->data, m->data) <= 0){
+      tail->next = l;
+      l = l->next;
     }else{
-      m->next = merge(l, m->next, compare);
-      return m;
+      tail->next = m;
+      m = m->next;
     }
+    tail = tail->next;
   }
+  tail->next = (l != NULL) ? l : m;
+  return head.next;
 }
 
 Node* split(Node *l){
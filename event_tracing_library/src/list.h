@@ -1,6 +1,21 @@
 #ifndef LIST_H_
 #define LIST_H_
 
+#include <stddef.h>
+
+#define LIST_POOL_CHUNK_BLOCKS 64
+#define LIST_ARENA_CHUNK_SIZE 4096
+#define LIST_SORT_BINS 64
+
+typedef struct ListAllocator
+{
+  void *(*alloc)(struct ListAllocator *allocator, size_t size);
+  void (*free)(struct ListAllocator *allocator, void *ptr);
+  void (*reset)(struct ListAllocator *allocator);
+  void (*destroy)(struct ListAllocator *allocator);
+  void *ctx;
+} ListAllocator;
+
 typedef struct _Node
 {
   void *data;
@@ -11,16 +26,24 @@ typedef struct List
 {
   Node *head;
   int size;
+  ListAllocator *allocator;
 } List;
 
 List * list_create();
+List * list_create_with(ListAllocator *allocator);
 void list_destroy(List *list);
 void list_add(List *list, void *data);
 void list_delete(List *list, void *data, int (*compare)(void *, void *));
+void list_sort(List *list, int (*compare)(void *, void *));
 Node* mergesort(Node* l, int (*compare)(void *, void *));
 Node* merge(Node *l, Node *m, int (*compare)(void *, void *));
 Node* split(Node *l);
 List* list_clone(List *l);
-Node* list_clone_aux(Node *l, Node *clone);
+Node* list_clone_aux(Node *l, ListAllocator *allocator);
+ListAllocator * list_malloc_allocator();
+ListAllocator * list_pool_allocator_create(int blocks_per_chunk);
+ListAllocator * list_arena_allocator_create(size_t chunk_size);
+void list_allocator_reset(ListAllocator *allocator);
+void list_allocator_destroy(ListAllocator *allocator);
 
 #endif
@@ -0,0 +1,158 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <argp.h>
+#include <string.h>
+#include <errno.h>
+#include "../include/event_tracing.h"
+#include "../include/raw_trace.h"
+
+#define COMM_TABLE_SIZE 4096 //Number of entries of the table used to remember the command name of each pid
+
+/**
+ * @brief A structure used to contain the command line arguments parsed from the user input.
+*/
+struct arguments {
+  char* dirpath; //It is a string value representing the execution directory that contains the raw traces
+  char* output; //It is a string value representing the path of the text trace to create
+};
+
+/**
+ * @brief An entry of the table used to remember the command name of a pid, learned from the sched_switch events.
+*/
+struct comm_entry {
+  int pid;
+  char comm[RAW_COMM_LEN + 1];
+};
+
+//Program version.
+const char *argp_program_version = "Raw Trace Dump 1.0";
+
+//Program bug report address.
+const char *argp_program_bug_address = "<riccardo.maino@edu.unito.it>";
+
+// Program documentation.
+static char doc[] = "This program merges by timestamp the per-CPU raw traces saved by the 'event_tracing' library with the USE_TRACE_RAW mode \
+and writes them in the same text format of the /sys/kernel/tracing/trace file, so that they can be analyzed by the Python module.";
+
+static char args_doc[] = "DIRPATH";
+
+// The command line options accepted to obtain the arguments contained in the 'struc arguments' structure
+static struct argp_option options[] = {
+  {"output", 'o', "OUTPUT", 0, "A string used to set the path of the text trace to create. Default is 'DIRPATH/trace.txt'."},
+  {0}
+};
+
+//Function used by the command line arguments parser to correctly obtain arguments.
+static error_t parse_opt(int key, char *arg, struct argp_state *state) {
+  struct arguments *arguments = state->input;
+  switch(key){
+    case 'o':
+      arguments->output = arg;
+      break;
+    case ARGP_KEY_ARG:
+      if(state->arg_num >= 1){
+        argp_usage(state);
+      }
+      arguments->dirpath = arg;
+      break;
+    case ARGP_KEY_END:
+      if(state->arg_num < 1){
+        argp_usage(state);
+      }
+      break;
+    default:
+      return ARGP_ERR_UNKNOWN;
+  }
+  return 0;
+}
+
+//The ARGP parser
+static struct argp argp = { options, parse_opt, args_doc, doc };
+
+/**
+ * @brief Converts the prev_state field of a sched_switch event to the letters used by the kernel in the text trace.
+ * @param state The value of the prev_state field.
+ * @return A pointer to a constant string.
+*/
+const char* state_to_str(long state){
+  const char* letters = "SDTtXZPI";
+  static char str[2];
+
+  if(state == 0)
+    return "R";
+  for(int i = 0; i < 8; i++){
+    if(state & (1 << i)){
+      str[0] = letters[i];
+      return str;
+    }
+  }
+  return "R+";
+}
+
+int main(int argc, char *argv[]){
+  struct arguments arguments;       // A structure used to store the command line arguments
+  struct comm_entry* comm_table;    // A table used to remember the command name of each pid
+  raw_trace_reader* reader;         // The reader of the raw traces
+  raw_event event;                  // The current event
+  raw_sched_switch sched_switch;    // The current sched_switch event decoded
+  raw_job_marker marker;            // The current job marker decoded
+  char output_path[PATH_MAX];
+  struct comm_entry* entry;
+  FILE* output;
+  int event_flag;
+  long events = 0;
+
+  arguments.dirpath = NULL;
+  arguments.output = NULL;
+  if(argp_parse(&argp, argc, argv, 0, 0, &arguments) != 0){
+    fprintf(stderr, "Parsing command line arguments error ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  if(arguments.output == NULL){
+    snprintf(output_path, PATH_MAX, "%s/trace.txt", arguments.dirpath);
+    arguments.output = output_path;
+  }
+
+  output = fopen(arguments.output, "w");
+  comm_table = (struct comm_entry*)calloc(COMM_TABLE_SIZE, sizeof(*comm_table));
+  if(output == NULL || comm_table == NULL){
+    fprintf(stderr, "Error opening \"%s\" file ...\n", arguments.output);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  reader = raw_trace_open(arguments.dirpath);
+  while(raw_trace_next(reader, &event)){
+    event_flag = raw_trace_event_flag(reader, &event);
+    if(event_flag == E_SCHED_SWITCH && raw_trace_decode_sched_switch(reader, &event, &sched_switch)){
+      comm_table[sched_switch.prev_pid % COMM_TABLE_SIZE].pid = sched_switch.prev_pid;
+      strcpy(comm_table[sched_switch.prev_pid % COMM_TABLE_SIZE].comm, sched_switch.prev_comm);
+      comm_table[sched_switch.next_pid % COMM_TABLE_SIZE].pid = sched_switch.next_pid;
+      strcpy(comm_table[sched_switch.next_pid % COMM_TABLE_SIZE].comm, sched_switch.next_comm);
+      fprintf(output, "%16s-%-7d [%03d] ..... %llu.%06llu: sched_switch: prev_comm=%s prev_pid=%d prev_prio=%d prev_state=%s ==> next_comm=%s next_pid=%d next_prio=%d\n",
+              sched_switch.prev_comm, event.pid, event.cpu, event.timestamp / 1000000000ULL, (event.timestamp % 1000000000ULL) / 1000ULL,
+              sched_switch.prev_comm, sched_switch.prev_pid, sched_switch.prev_prio, state_to_str(sched_switch.prev_state),
+              sched_switch.next_comm, sched_switch.next_pid, sched_switch.next_prio);
+      events++;
+    }else if(raw_trace_decode_job_marker(reader, &event, &marker)){
+      entry = &comm_table[event.pid % COMM_TABLE_SIZE];
+      fprintf(output, "%16s-%-7d [%03d] ..... %llu.%06llu: tracing_mark_write: %s_job=",
+              entry->pid == event.pid && entry->comm[0] != '\0' ? entry->comm : "<...>",
+              event.pid, event.cpu, event.timestamp / 1000000000ULL, (event.timestamp % 1000000000ULL) / 1000ULL,
+              marker.state == START ? "start" : "end");
+      // The markers of the concurrent workers keep the worker that ran the job
+      if(marker.worker != 0)
+        fprintf(output, "%u:", marker.worker);
+      fprintf(output, "%d\n", marker.job_number);
+      events++;
+    }
+  }
+  raw_trace_close(reader);
+  fclose(output);
+  free(comm_table);
+
+  printf("*** %ld events written to '%s'\n", events, arguments.output);
+  return 0;
+}
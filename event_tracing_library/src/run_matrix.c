@@ -0,0 +1,666 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <argp.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#include <limits.h>
+#include <time.h>
+#include <sched.h>
+#include "../include/event_tracing.h"
+#include "../include/exec_logger.h"
+#include "../include/job_metrics.h"
+#include "../include/light_metrics.h"
+#include "../include/workload.h"
+#include "jobs.h"
+
+#define DEFAULT_CONFIG NULL //Default value of CONFIG command line argument
+#define DEFAULT_RESPATH "../../results" //Default value of RESPATH command line argument
+#define DEFAULT_LIGHT 0 //Default flag of LIGHT command line argument
+#define DEFAULT_WORKLOADS NULL //Default value of WORKLOADS command line argument
+#define DEFAULT_DRYRUN 0 //Default flag of DRYRUN command line argument
+#define DEFAULT_WORKLOAD "ListOrdering" //Default value of the "workloads" key of the matrix, the default job of test_app
+#define DEFAULT_PARAMETER 10000 //Default value of the "params" key of the matrix
+#define DEFAULT_INCREASE 10000 //Default value of the "increase" key of the matrix
+#define DEFAULT_MAX_JOBS 50 //Default value of the "jobs" key of the matrix
+#define DEFAULT_REPETITIONS 1 //Default value of the "repetitions" key of the matrix
+#define DEFAULT_WAIT 0 //Default value of the "wait" key of the matrix, in milliseconds
+#define MATRIX_MAX_VALUES 32 //Maximum number of values of a key of the matrix
+#define MATRIX_MAX_EXPERIMENTS 64 //Maximum number of [experiment] sections of the matrix
+#define MATRIX_MAX_RUNS 9999 //Maximum number of runs, so that their identifier fits the EXEC_RECORD_ID_SIZE of the binary log
+#define MATRIX_NAME_SIZE 64 //Size of the name of a workload of the matrix
+#define MATRIX_LINE_SIZE 1024 //Maximum length of a line of the matrix file
+
+/**
+ * @brief A structure used to contain the command line arguments parsed from the user input.
+*/
+struct arguments {
+  char* config; //It is a string value representing the path of the matrix file
+  char* respath; //It is a string value representing the path of the directory where the results of the runs are saved
+  unsigned int seed; //It is an integer value representing the seed of the random order of the runs
+  short has_seed; //It is a flag used to specify that the SEED argument has been provided
+  short light; //It is a flag used to specify that the jobs are measured without the tracefs
+  char* workloads; //It is a string value representing the path of the directory where to search the workload plugins
+  short dryrun; //It is a flag used to specify that the runs are only printed, in the order they would be executed
+};
+
+/**
+ * @brief A structure used to contain an [experiment] section of the matrix, whose runs are the combinations of its lists.
+*/
+struct experiment {
+  char workloads[MATRIX_MAX_VALUES][MATRIX_NAME_SIZE]; //It is the array of the names of the jobs
+  int n_workloads; //It is an integer value representing the number of jobs
+  int policies[MATRIX_MAX_VALUES]; //It is the array of the scheduling policies
+  int n_policies; //It is an integer value representing the number of scheduling policies
+  int priorities[MATRIX_MAX_VALUES]; //It is the array of the scheduler priorities, combined only with the policies they are valid for
+  int n_priorities; //It is an integer value representing the number of scheduler priorities
+  long params[MATRIX_MAX_VALUES]; //It is the array of the parameters of the first job of the runs
+  int n_params; //It is an integer value representing the number of parameters
+  long increase; //It is a long integer value representing the increase of the parameter after each job
+  int jobs; //It is an integer value representing the number of jobs of each run
+  int repetitions; //It is an integer value representing the number of runs of each combination
+  int length; //It is an integer value representing the number of elements of the lists sorted by the ordering jobs
+  long wait; //It is a long integer value representing the milliseconds waited between the jobs
+};
+
+/**
+ * @brief A structure used to contain the matrix of the experiments parsed from the CONFIG file.
+*/
+struct matrix {
+  struct experiment defaults; //It is the experiment of the keys set before the first section, inherited by all the sections
+  struct experiment experiments[MATRIX_MAX_EXPERIMENTS]; //It is the array of the [experiment] sections
+  int n_experiments; //It is an integer value representing the number of sections
+  unsigned int seed; //It is an integer value representing the seed of the random order of the runs
+  short has_seed; //It is a flag used to specify that the "seed" key has been set
+};
+
+/**
+ * @brief A structure used to contain a run of the matrix, a sequence of jobs in a single execution directory.
+*/
+struct run {
+  const struct experiment* experiment; //It is the experiment the run belongs to
+  const char* workload; //It is the name of the job
+  int policy; //It is the scheduling policy
+  int priority; //It is the scheduler priority
+  long param; //It is the parameter of the first job
+  int repetition; //It is the number of the repetition of the combination, from 1
+};
+
+//Program version.
+const char *argp_program_version = "Event Tracing Library 1.0";
+
+//Program bug report address.
+const char *argp_program_bug_address = "<riccardo.maino@edu.unito.it>";
+
+// Program documentation.
+static char doc[] = "This program runs a matrix of executions of the jobs of test_app, described by the CONFIG file, in a single process. \
+The runs are executed in a random order, so that a drift of the machine during the matrix doesn't bias any combination, and they share \
+a single tracing session, which is cleaned between the runs. Each run is saved in its own execution directory, named after the \
+execution ID followed by the number of the run, in the same format of test_app. Possible [OPTION...] could be the following ones:\
+\vThe CONFIG file is made of 'key = value' lines, where the values of the lists are comma separated and '#' starts a comment. \
+The keys set before the first '[experiment]' line are the defaults of all the experiments, and if there are no '[experiment]' lines \
+they are a single experiment. The runs of an experiment are all the combinations of its lists, each repeated REPETITIONS times:\n\
+\tworkloads: The names of the jobs, built-in or plugins, such as 'EmptyLoop'. Default is 'ListOrdering'.\n\
+\tpolicies: The scheduling policies, such as 'SCHED_FIFO'. SCHED_DEADLINE is not supported. Default is 'SCHED_OTHER'.\n\
+\tpriorities: The scheduler priorities. The real-time policies are combined with the priorities from 1 to 99, the others with 0. Default is 0.\n\
+\tparams: The parameters of the first job of the runs. Default is 10000.\n\
+\tincrease: The increase of the parameter after each job. Default is 10000.\n\
+\tjobs: The number of jobs of each run. Default is 50.\n\
+\trepetitions: The number of runs of each combination. Default is 1.\n\
+\tlength: The number of elements of the lists and the arrays of the ordering jobs. Default is 5.\n\
+\twait: The milliseconds waited between the jobs. Default is 0.\n\
+\tseed: The seed of the order of the runs, overridden by the '--seed' option. Default is random.\n";
+
+// The command line options accepted to obtain the arguments contained in the 'struct arguments' structure
+static struct argp_option options[] = {
+  {"config", 'c', "CONFIG", 0, "A string used to set the path of the matrix file. It is required."},
+  {"respath", 'r', "RESPATH", 0, "A string used to set the path of the directory where the results of the runs are saved. Default is '../../results'."},
+  {"seed", 's', "SEED", 0, "A non-negative integer used to set the seed of the random order of the runs, printed at the beginning of the matrix, so that an order can be repeated. Default is the 'seed' key of the CONFIG file, or a random seed."},
+  {"light", 'L', 0, 0, "A flag used to measure the jobs without the tracefs, as the '--light' option of test_app does. It is used automatically when the tracefs is not available."},
+  {"workloads", 'y', "DIR", 0, "A string used to set the path of the directory where to search the workload plugins. Default is the 'workloads' directory next to the executable."},
+  {"dry-run", 'd', 0, 0, "A flag used to print the runs in the order they would be executed, without executing them."},
+  {0}
+};
+
+/**
+ * @brief Parses a single command line argument.
+ * @param key An integer that represents a command line argument.
+ * @param arg A pointer to the value of the command line argument.
+ * @param state A pointer to a structure that contains the state of the parser.
+ * @return 0 if the argument has been parsed, ARGP_ERR_UNKNOWN otherwise.
+*/
+static error_t parse_opt(int key, char *arg, struct argp_state *state){
+  struct arguments *arguments = state->input;
+  char* end_ptr;
+  long seed;
+
+  errno = 0;
+  switch (key){
+    case 'c':
+      arguments->config = arg;
+      break;
+    case 'r':
+      arguments->respath = arg;
+      break;
+    case 's':
+      seed = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--seed' option");
+      }
+      if(seed < 0 || seed > UINT_MAX){
+        argp_error(state, "Invalid argument for '--seed' option");
+      }
+      arguments->seed = (unsigned int)seed;
+      arguments->has_seed = 1;
+      break;
+    case 'L':
+      arguments->light = 1;
+      break;
+    case 'y':
+      arguments->workloads = arg;
+      break;
+    case 'd':
+      arguments->dryrun = 1;
+      break;
+    case ARGP_KEY_END:
+      if(arguments->config == NULL){
+        argp_error(state, "The '--config' option is required");
+      }
+      if(!arguments->light && !arguments->dryrun && !tracefs_available()){
+        arguments->light = 1;
+      }
+      break;
+    default:
+      return ARGP_ERR_UNKNOWN;
+  }
+  return 0;
+}
+
+//The ARGP parser
+static struct argp argp = { options, parse_opt, 0, doc };
+
+void parse_matrix(const char* file_path, struct matrix* matrix);
+int parse_key(struct experiment* experiment, const char* key, char* value);
+int parse_policy(const char* str);
+const char* policy_name(int policy);
+int build_runs(const struct matrix* matrix, struct run* runs);
+void shuffle_runs(struct run* runs, int n_runs, unsigned int seed);
+void check_workloads(const struct matrix* matrix, const char* dir_path);
+void execute_run(const struct run* run, int number, const char* identifier, const char* dir_path, const char* respath,
+                 tracing_session* session, light_metrics* light);
+
+int main(int argc, char *argv[]){
+  struct arguments arguments;                // A structure used to store the command line arguments
+  struct matrix* matrix;                     // A pointer to the matrix parsed from the CONFIG file
+  struct run* runs;                          // The runs of the matrix, in the order they are executed
+  int n_runs;                                // The number of runs
+  unsigned int seed;                         // The seed of the order of the runs
+  char* dir_path;                            // The path of the directory of the workload plugins
+  char* identifier;                          // The execution ID shared by the runs, followed by the number of each run
+  tracing_session* session = NULL;           // A pointer to a structure that keeps open the tracefs files for all the runs
+  light_metrics* light = NULL;               // A pointer to a structure that measures the jobs without the tracefs, if requested
+  struct timespec matrix_start, matrix_end;  // The beginning and the end of the matrix
+
+  // Default values of command line arguments
+  arguments.config = DEFAULT_CONFIG;
+  arguments.respath = DEFAULT_RESPATH;
+  arguments.seed = 0;
+  arguments.has_seed = 0;
+  arguments.light = DEFAULT_LIGHT;
+  arguments.workloads = DEFAULT_WORKLOADS;
+  arguments.dryrun = DEFAULT_DRYRUN;
+
+  // Parse command line arguments
+  if(argp_parse(&argp, argc, argv, 0, 0, &arguments) != 0){
+    fprintf(stderr, "Parsing command line arguments error ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  // Parsing the matrix and checking that all its jobs exist before running any of them
+  matrix = (struct matrix*)malloc(sizeof(*matrix));
+  runs = (struct run*)malloc(MATRIX_MAX_RUNS * sizeof(*runs));
+  if(matrix == NULL || runs == NULL){
+    fprintf(stderr, "Error allocating the matrix ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  parse_matrix(arguments.config, matrix);
+  dir_path = arguments.workloads != NULL ? strdup(arguments.workloads) : default_workload_dir();
+  check_workloads(matrix, dir_path);
+  n_runs = build_runs(matrix, runs);
+
+  // Shuffling the runs, so that the combinations are spread over the whole matrix
+  if(arguments.has_seed)
+    seed = arguments.seed;
+  else if(matrix->has_seed)
+    seed = matrix->seed;
+  else
+    seed = (unsigned int)time(NULL) ^ (unsigned int)getpid();
+  shuffle_runs(runs, n_runs, seed);
+
+  printf("*** Starting ...\n");
+  printf("*** Matrix: %d runs of %d experiments, SEED: %u\n", n_runs, matrix->n_experiments, seed);
+  if(arguments.dryrun){
+    for(int i = 0; i < n_runs; i++)
+      printf("%d: %s %s %d PARAM %ld INC %ld JOBS %d REPETITION %d\n", i+1, runs[i].workload, policy_name(runs[i].policy),
+             runs[i].priority, runs[i].param, runs[i].experiment->increase, runs[i].experiment->jobs, runs[i].repetition);
+    free(dir_path);
+    free(runs);
+    free(matrix);
+    return 0;
+  }
+
+  // Opening the tracefs files once for all the runs, which trace only the sched_switch events of this process
+  if(!arguments.light){
+    session = create_tracing_session(NULL);
+    ENABLE_TRACING_SESSION(session);
+    set_event_filter_session(session, getpid(), E_SCHED_SWITCH, SET);
+  }else{
+    printf("*** The jobs are measured without the tracefs\n");
+    light = create_light_metrics();
+  }
+  identifier = generate_execution_identifier(1);
+  printf("*** Execution ID: %s\n", identifier);
+  printf("*** Executing ...\n");
+
+  clock_gettime(CLOCK_MONOTONIC, &matrix_start);
+  for(int i = 0; i < n_runs; i++){
+    execute_run(&runs[i], i+1, identifier, dir_path, arguments.respath, session, light);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &matrix_end);
+
+  // Leaving the real-time policy of the last run
+  set_scheduler_policy(0, SCHED_OTHER, 0, NULL);
+  if(light != NULL){
+    destroy_light_metrics(light);
+  }
+  if(session != NULL){
+    DISABLE_TRACING_SESSION(session);
+    destroy_tracing_session(session);
+  }
+  free(identifier);
+  free(dir_path);
+  free(runs);
+  free(matrix);
+
+  printf("*** DONE. %d runs in %.1f seconds. All has been correctly saved under '%s' path\n", n_runs,
+         (matrix_end.tv_sec - matrix_start.tv_sec) + (matrix_end.tv_nsec - matrix_start.tv_nsec) / 1e9, arguments.respath);
+  printf("*** Terminating\n");
+  return 0;
+}
+
+/**
+ * @brief It runs the jobs of a run of the matrix, saving them in the execution directory of the run. The jobs are marked in the
+ * shared tracing session, whose trace is saved and cleaned at the end of the run, or measured without the tracefs
+ * @param run is the run to execute
+ * @param number is the number of the run in the order of execution, appended to the execution ID
+ * @param identifier is the execution ID shared by the runs
+ * @param dir_path is the path of the directory of the workload plugins
+ * @param respath is the path of the directory where the results are saved
+ * @param session is the tracing session, NULL if the jobs are measured without the tracefs
+ * @param light is the unprivileged measurement of the jobs, NULL if the tracefs is used
+*/
+void execute_run(const struct run* run, int number, const char* identifier, const char* dir_path, const char* respath,
+                 tracing_session* session, light_metrics* light){
+  const struct experiment* experiment = run->experiment;
+  exec_info* execution_info;
+  workload_module* job_workload;
+  exec_logger* logger;
+  job_metrics_engine* metrics_engine = NULL;
+  job_metrics job;
+  struct timespec tp;
+  char* dir_file_path;
+  long param = run->param;
+
+  tp.tv_sec = experiment->wait / 1000;
+  tp.tv_nsec = (experiment->wait % 1000) * 1000000;
+
+  // Each run has its own execution ID, so that it is saved in its own directory as an execution of test_app
+  execution_info = create_exec_info(0, param, NULL);
+  free(execution_info->id);
+  if(asprintf(&execution_info->id, "%s-%04d", identifier, number) == -1){
+    fprintf(stderr, "Error allocating the execution ID of the run ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  set_ordering_length(experiment->length);
+  job_workload = open_job(run->workload, dir_path);
+  execution_info->details = (char*)job_workload->workload->name;
+  if(is_ordering_job(job_workload->workload)){
+    exec_info_set_metric(execution_info, "list_length", experiment->length);
+  }
+  exec_info_set_metric(execution_info, "repetition", run->repetition);
+  set_scheduler_policy(0, run->policy, run->priority, execution_info);
+
+  printf("*** Run %d: %s %s %d PARAM %ld (ID: %s)\n", number, execution_info->details, execution_info->sched_policy,
+         execution_info->sched_priority, param, execution_info->id);
+  fflush(stdout);
+
+  logger = create_exec_logger(respath, execution_info->id, EXEC_LOG_TEXT, 0);
+  if(light != NULL){
+    dir_file_path = create_execution_directory(respath, execution_info->id);
+    metrics_engine = create_job_metrics_engine(dir_file_path, execution_info->id, NULL);
+    free(dir_file_path);
+  }
+  workload_init(job_workload);
+  // Dropping the events recorded since the previous run, such as the ones of its logging
+  if(session != NULL){
+    clean_trace_session(session);
+    event_record_session(session, E_SCHED_SWITCH, ENABLE);
+  }
+  for(int i = 0; i < experiment->jobs; i++){
+    execution_info->parameter = param;
+    execution_info->job_number = i+1;
+    if(light != NULL)
+      light_metrics_job_start(light, i+1);
+    else
+      trace_mark_job_session(session, i+1, START);
+    workload_run(job_workload, param);
+    if(light != NULL)
+      light_metrics_job_end(light, &job, execution_info);
+    else
+      trace_mark_job_session(session, i+1, STOP);
+    exec_logger_log(logger, execution_info);
+    if(metrics_engine != NULL)
+      job_metrics_write(metrics_engine, &job);
+    if(experiment->wait > 0 && nanosleep(&tp, NULL) != 0){
+      fprintf(stderr, "Nanosleep has been interrupted ...\n");
+    }
+    param += experiment->increase;
+  }
+  if(session != NULL){
+    event_record_session(session, E_SCHED_SWITCH, DISABLE);
+  }
+  workload_teardown(job_workload);
+  close_workload(job_workload);
+  if(metrics_engine != NULL){
+    destroy_job_metrics_engine(metrics_engine);
+  }
+  destroy_exec_logger(logger);
+  if(session != NULL){
+    log_trace_session(session, respath, execution_info->id, USE_TRACE);
+  }
+  destroy_exec_info(execution_info);
+}
+
+/**
+ * @brief It parses the matrix file. The keys set before the first [experiment] section are inherited by all the sections, and if
+ * there are no sections they make up a single experiment. The program is terminated if the file is not valid
+ * @param file_path is the path of the matrix file
+ * @param matrix is the structure where to store the matrix
+*/
+void parse_matrix(const char* file_path, struct matrix* matrix){
+  char line[MATRIX_LINE_SIZE];
+  char *start, *end, *value;
+  struct experiment* experiment;
+  FILE* file;
+  int line_number = 0;
+  long seed;
+
+  memset(matrix, 0, sizeof(*matrix));
+  experiment = &matrix->defaults;
+  strcpy(experiment->workloads[0], DEFAULT_WORKLOAD);
+  experiment->n_workloads = 1;
+  experiment->policies[0] = SCHED_OTHER;
+  experiment->n_policies = 1;
+  experiment->priorities[0] = 0;
+  experiment->n_priorities = 1;
+  experiment->params[0] = DEFAULT_PARAMETER;
+  experiment->n_params = 1;
+  experiment->increase = DEFAULT_INCREASE;
+  experiment->jobs = DEFAULT_MAX_JOBS;
+  experiment->repetitions = DEFAULT_REPETITIONS;
+  experiment->length = ORDERING_DEFAULT_LENGTH;
+  experiment->wait = DEFAULT_WAIT;
+
+  file = fopen(file_path, "r");
+  if(file == NULL){
+    fprintf(stderr, "parse_matrix: error opening \"%s\" file. Aborting ...\n", file_path);
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  while(fgets(line, sizeof(line), file) != NULL){
+    line_number++;
+    // Removing the comment and the surrounding spaces
+    if((end = strchr(line, '#')) != NULL)
+      *end = '\0';
+    for(start = line; isspace((unsigned char)*start); start++);
+    for(end = start + strlen(start); end > start && isspace((unsigned char)*(end - 1)); end--);
+    *end = '\0';
+    if(*start == '\0')
+      continue;
+    if(strcmp(start, "[experiment]") == 0){
+      if(matrix->n_experiments == MATRIX_MAX_EXPERIMENTS){
+        fprintf(stderr, "parse_matrix: error at line %d of \"%s\": more than %d experiments. Aborting ...\n", line_number, file_path,
+                MATRIX_MAX_EXPERIMENTS);
+        exit(EXIT_FAILURE);
+      }
+      experiment = &matrix->experiments[matrix->n_experiments++];
+      *experiment = matrix->defaults;
+      continue;
+    }
+    if((value = strchr(start, '=')) == NULL){
+      fprintf(stderr, "parse_matrix: error at line %d of \"%s\": expected 'key = value' or '[experiment]'. Aborting ...\n", line_number,
+              file_path);
+      exit(EXIT_FAILURE);
+    }
+    for(end = value; end > start && isspace((unsigned char)*(end - 1)); end--);
+    *end = '\0';
+    for(value++; isspace((unsigned char)*value); value++);
+    if(strcmp(start, "seed") == 0){
+      seed = strtol(value, &end, 10);
+      if(end == value || *end != '\0' || seed < 0 || seed > UINT_MAX){
+        fprintf(stderr, "parse_matrix: error at line %d of \"%s\": invalid value of 'seed'. Aborting ...\n", line_number, file_path);
+        exit(EXIT_FAILURE);
+      }
+      matrix->seed = (unsigned int)seed;
+      matrix->has_seed = 1;
+    }else if(parse_key(experiment, start, value) == -1){
+      fprintf(stderr, "parse_matrix: error at line %d of \"%s\": invalid key or value of '%s'. Aborting ...\n", line_number, file_path,
+              start);
+      exit(EXIT_FAILURE);
+    }
+  }
+  fclose(file);
+  if(matrix->n_experiments == 0){
+    matrix->experiments[0] = matrix->defaults;
+    matrix->n_experiments = 1;
+  }
+}
+
+/**
+ * @brief It parses a key of an experiment of the matrix
+ * @param experiment is the experiment where to store the value
+ * @param key is the name of the key
+ * @param value is the value of the key, a comma separated list for the lists. It is modified by the parsing
+ * @return 0 if the key and its value are valid, -1 otherwise
+*/
+int parse_key(struct experiment* experiment, const char* key, char* value){
+  char *item, *save_ptr, *end_ptr;
+  long number;
+  int n_values = 0;
+
+  for(item = strtok_r(value, ",", &save_ptr); item != NULL; item = strtok_r(NULL, ",", &save_ptr)){
+    for(; isspace((unsigned char)*item); item++);
+    for(end_ptr = item + strlen(item); end_ptr > item && isspace((unsigned char)*(end_ptr - 1)); end_ptr--);
+    *end_ptr = '\0';
+    if(*item == '\0' || n_values == MATRIX_MAX_VALUES)
+      return -1;
+    if(strcmp(key, "workloads") == 0){
+      if(strlen(item) >= MATRIX_NAME_SIZE)
+        return -1;
+      strcpy(experiment->workloads[n_values], item);
+    }else if(strcmp(key, "policies") == 0){
+      if((experiment->policies[n_values] = parse_policy(item)) == -1)
+        return -1;
+    }else{
+      errno = 0;
+      number = strtol(item, &end_ptr, 10);
+      if(errno != 0 || end_ptr == item || *end_ptr != '\0')
+        return -1;
+      if(strcmp(key, "priorities") == 0 && number >= 0 && number <= 99)
+        experiment->priorities[n_values] = number;
+      else if(strcmp(key, "params") == 0 && number > 0)
+        experiment->params[n_values] = number;
+      else if(n_values > 0)
+        return -1;
+      else if(strcmp(key, "increase") == 0 && number >= 0)
+        experiment->increase = number;
+      else if(strcmp(key, "jobs") == 0 && number > 0 && number <= INT_MAX)
+        experiment->jobs = number;
+      else if(strcmp(key, "repetitions") == 0 && number > 0 && number <= MATRIX_MAX_RUNS)
+        experiment->repetitions = number;
+      else if(strcmp(key, "length") == 0 && number > 0 && number <= INT_MAX)
+        experiment->length = number;
+      else if(strcmp(key, "wait") == 0 && number >= 0)
+        experiment->wait = number;
+      else
+        return -1;
+    }
+    n_values++;
+  }
+  if(n_values == 0)
+    return -1;
+  if(strcmp(key, "workloads") == 0)
+    experiment->n_workloads = n_values;
+  else if(strcmp(key, "policies") == 0)
+    experiment->n_policies = n_values;
+  else if(strcmp(key, "priorities") == 0)
+    experiment->n_priorities = n_values;
+  else if(strcmp(key, "params") == 0)
+    experiment->n_params = n_values;
+  return 0;
+}
+
+/**
+ * @brief It converts the name of a scheduling policy into its value. SCHED_DEADLINE is not supported, since its reservation needs
+ * the runtime, the deadline and the period of the jobs
+ * @param str is the name of the policy, such as "SCHED_FIFO"
+ * @return the value of the policy, or -1 if the name is not valid
+*/
+int parse_policy(const char* str){
+  if(strcmp("SCHED_OTHER", str) == 0)
+    return SCHED_OTHER;
+  else if(strcmp("SCHED_FIFO", str) == 0)
+    return SCHED_FIFO;
+  else if(strcmp("SCHED_RR", str) == 0)
+    return SCHED_RR;
+  else if(strcmp("SCHED_BATCH", str) == 0)
+    return SCHED_BATCH;
+  else if(strcmp("SCHED_IDLE", str) == 0)
+    return SCHED_IDLE;
+  return -1;
+}
+
+/**
+ * @brief It converts a scheduling policy into its name
+ * @param policy is the value of the policy
+ * @return the name of the policy
+*/
+const char* policy_name(int policy){
+  switch(policy){
+    case SCHED_FIFO:
+      return "SCHED_FIFO";
+    case SCHED_RR:
+      return "SCHED_RR";
+    case SCHED_BATCH:
+      return "SCHED_BATCH";
+    case SCHED_IDLE:
+      return "SCHED_IDLE";
+    default:
+      return "SCHED_OTHER";
+  }
+}
+
+/**
+ * @brief It builds the runs of the matrix, combining the lists of each experiment. A real-time policy is combined only with the
+ * priorities from 1 to 99, and the other policies only with the priority 0. The program is terminated if an experiment has no
+ * valid combination or if the runs are more than MATRIX_MAX_RUNS
+ * @param matrix is the matrix
+ * @param runs is the array of MATRIX_MAX_RUNS elements where to store the runs
+ * @return the number of runs
+*/
+int build_runs(const struct matrix* matrix, struct run* runs){
+  const struct experiment* experiment;
+  int n_runs = 0, n_combinations, realtime;
+
+  for(int e = 0; e < matrix->n_experiments; e++){
+    experiment = &matrix->experiments[e];
+    n_combinations = 0;
+    for(int p = 0; p < experiment->n_policies; p++){
+      realtime = experiment->policies[p] == SCHED_FIFO || experiment->policies[p] == SCHED_RR;
+      for(int q = 0; q < experiment->n_priorities; q++){
+        if(realtime != (experiment->priorities[q] > 0))
+          continue;
+        n_combinations++;
+        for(int w = 0; w < experiment->n_workloads; w++){
+          for(int k = 0; k < experiment->n_params; k++){
+            for(int r = 0; r < experiment->repetitions; r++){
+              if(n_runs == MATRIX_MAX_RUNS){
+                fprintf(stderr, "build_runs: error, the matrix has more than %d runs. Aborting ...\n", MATRIX_MAX_RUNS);
+                exit(EXIT_FAILURE);
+              }
+              runs[n_runs].experiment = experiment;
+              runs[n_runs].workload = experiment->workloads[w];
+              runs[n_runs].policy = experiment->policies[p];
+              runs[n_runs].priority = experiment->priorities[q];
+              runs[n_runs].param = experiment->params[k];
+              runs[n_runs].repetition = r+1;
+              n_runs++;
+            }
+          }
+        }
+      }
+    }
+    if(n_combinations == 0){
+      fprintf(stderr, "build_runs: error, experiment %d has no valid combination of policies and priorities. Aborting ...\n", e+1);
+      exit(EXIT_FAILURE);
+    }
+  }
+  return n_runs;
+}
+
+/**
+ * @brief It shuffles the runs with the Fisher-Yates algorithm
+ * @param runs is the array of the runs
+ * @param n_runs is the number of runs
+ * @param seed is the seed of the random order, so that the same seed gives the same order
+*/
+void shuffle_runs(struct run* runs, int n_runs, unsigned int seed){
+  struct run tmp;
+  int j;
+
+  for(int i = n_runs - 1; i > 0; i--){
+    j = rand_r(&seed) % (i + 1);
+    tmp = runs[i];
+    runs[i] = runs[j];
+    runs[j] = tmp;
+  }
+}
+
+/**
+ * @brief It checks that all the jobs of the matrix exist, before running any of them. If a job isn't found, the available ones are
+ * printed and the program is terminated
+ * @param matrix is the matrix
+ * @param dir_path is the path of the directory of the workload plugins
+*/
+void check_workloads(const struct matrix* matrix, const char* dir_path){
+  const struct experiment* experiment;
+  workload_module* module;
+
+  for(int e = 0; e < matrix->n_experiments; e++){
+    experiment = &matrix->experiments[e];
+    for(int w = 0; w < experiment->n_workloads; w++){
+      module = open_job(experiment->workloads[w], dir_path);
+      if(module == NULL){
+        fprintf(stderr, "Workload '%s' not found. The available workloads are:\n", experiment->workloads[w]);
+        list_jobs(dir_path, stderr);
+        exit(EXIT_FAILURE);
+      }
+      close_workload(module);
+    }
+  }
+}
@@ -1,361 +1,1081 @@
-#define _POSIX_C_SOURCE 199309L
-#define _GNU_SOURCE
-#include <stdio.h>
-#include <stdlib.h>
-#include <math.h>
-#include <unistd.h>
-#include <argp.h>
-#include <string.h>
-#include <errno.h>
-#include <limits.h>
-#include <time.h>
-#include <sys/wait.h>
-#include "../include/event_tracing.h"
-#include "list.h"
-
-#define DEFAULT_RESPATH "../../results" //Default value of RESPATH command line argument
-#define DEFAULT_PARAMETER 10000 //Default value of PARAM command line argument
-#define DEFAULT_MODE 3 //Default value of MODE command line argument
-#define DEFAULT_MAX_JOBS 50 //Default value of JOBS command line argument
-#define DEFAULT_POLICY SCHED_OTHER //Default value of POLICY command line argument
-#define DEFAULT_PRIORITY 0 //Default value of PRIO command line argument
-#define DEFAULT_NOWAIT 0 //Default flag of NOWAIT command line argument
-#define DEFAULT_INCREASE 10000 //Default value of INC command line argument
-#define MAX_VALUE 1000000
-#define MIN_VALUE 100
-
-/**
- * @brief A structure used to contain the command line arguments parsed from the user input. These arguments
- * will be used to set up some options of this execution.
-*/
-struct arguments {
-  long param; //It is a long integer value representing the parameter value to use with the first job
-  long inc; //It is a long integer value representing the increase amount to be added to the PARAM argument for each iteration of a job
-  int mode; //It is an integer value representing the kind of job to perform
-  int policy; //It is an integer value representing the scheduling policy to use with the jobs executed
-  int priority; //It is an integer value representing the scheduler priority to use with the jobs executed
-  int jobs; //It is an integer value representing the number of jobs to perform
-  char* respath; //It is a string value representing the path where to save all the results
-  short nowait; //It is a flag used to specify to omit waiting between each job.
-};
-
-//Program version.
-const char *argp_program_version = "Event Tracing Library 1.0";
-
-//Program bug report address.
-const char *argp_program_bug_address = "<riccardo.maino@edu.unito.it>";
-
-// Program documentation.
-static char doc[] = "This program demonstrates the usage of the 'event_tracing' library. Possible [OPTION...] could be the following ones:\
-\vThe arguments of the options MODE, POLICY and PRIO must comply with and respect the following values.\n\n\
-[MODE] possible integer values:\n\
-\t1: Empty loop job.\n\
-\t2: Variables exchanging job.\n\
-\t3: List ordering job.\n\n\
-[POLICY] possible string values:\n\
-\tSCHED_OTHER: Non-real-time scheduling policy.\n\
-\tSCHED_FIFO: Real-time scheduling policy.\n\
-\tSCHED_RR: Real-time scheduling policy.\n\
-\tSCHED_BATCH: Non-real-time scheduling policy.\n\
-\tSCHED_IDLE: Non-real-time scheduling policy.\n\
-\tSCHED_DEADLINE: Deadline scheduling policy.\n\n\
-[PRIO] possible integer values:\n\
-\t1 (low priority) to 99 (high priority): For SCHED_FIFO or SCHED_RR.\n\
-\t0: For all the others policies.\n";
-
-// The command line options accepted to obtain the arguments contained in the 'struc arguments' structure
-static struct argp_option options[] = {
-  {"param", 'p', "PARAM", 0, "A long integer used to set the parameter value to use with the first job. The PARAM argument must be a positive long integer. Default is 10000."},
-  {"mode", 'm', "MODE", 0, "An integer used to set the kind of the job to perform. The MODE argument must be an integer value between the ones specified in the below section. Default is 3."},
-  {"policy", 's', "POLICY", 0, "A string used to set the scheduling policy of the jobs executed. The POLICY argument must be a string value between the ones specified in the below section. Default is SCHED_OTHER."},
-  {"priority", 'l', "PRIO", 0, "An integer used to set the scheduler priority of the jobs executed. The PRIO argument must be an intger value between the ones specified in the below section. Default is 0."},
-  {"jobs", 'j', "JOBS", 0, "An integer used to set the number of jobs executed. The JOBS argument must be a positive integer. Default is 50."},
-  {"respath", 'r', "RESPATH", 0, "A string used to set the path where to save all the tracing related data. Default is '../../results'."},
-  {"nowait", 'w', "NOWAIT", OPTION_ARG_OPTIONAL, "A flag used to specify to omit waiting of one second between each job."},
-  {"increase", 'i', "INC", 0, "A long integer used to set the increase amount to be added for each iteration to the PARAM argument for each execution iteration of a job. This means that each job will be executed with a different parameter value. Default is 10000."},
-  {0}
-};
-
-//Function used by the command line arguments parser to correctly obtain arguments.
-static error_t parse_opt(int key, char *arg, struct argp_state *state) {
-  char *end_ptr;
-  //Get the input argument from argp_parse, which we know is a pointer to our arguments structure.
-  struct arguments *arguments = state->input;
-  switch(key){
-    case 'p':
-      arguments->param = strtol(arg, &end_ptr, 10);
-      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
-        argp_error(state, "Error converting to integer the argument for '--param' option");
-      }
-      if(arguments->param < 0){
-        argp_error(state, "Invalid argument for '--param' option");
-      }
-      break;
-    case 'm':
-      arguments->mode = strtol(arg, &end_ptr, 10);
-      if(errno != 0 || end_ptr == optarg || *end_ptr != '\0'){
-        argp_error(state, "Error converting to integer the argument for '--mode' option");
-      }
-      if(arguments->mode != 1 && arguments->mode != 2 && arguments->mode != 3){
-        argp_error(state, "Invalid argument for '--mode' option");
-      }
-      break;
-    case 's':
-      if(strcmp("SCHED_OTHER", arg) == 0)
-        arguments->policy= SCHED_OTHER;
-      else if(strcmp("SCHED_FIFO", arg) == 0)
-        arguments->policy = SCHED_FIFO;
-      else if(strcmp("SCHED_RR", arg) == 0)
-        arguments->policy = SCHED_RR;
-      else if(strcmp("SCHED_BATCH", arg) == 0)
-        arguments->policy = SCHED_BATCH;
-      else if(strcmp("SCHED_IDLE", arg) == 0)
-        arguments->policy = SCHED_IDLE;
-      else if(strcmp("SCHED_DEADLINE", arg) == 0)
-        arguments->policy = SCHED_DEADLINE;
-      else
-        argp_error(state, "Invalid argument for '--policy' option");
-      break;
-    case 'l':
-      arguments->priority = strtol(arg, &end_ptr, 10);
-      if(errno != 0 || end_ptr == optarg || *end_ptr != '\0'){
-        argp_error(state, "Error converting to integer the argument for '--priority' option");
-      }
-      if(arguments->priority < 0 || arguments->priority > 99){
-        argp_error(state, "Invalid argument for '--priority' option");
-      }
-      break;
-    case 'j':
-      arguments->jobs = strtol(arg, &end_ptr, 10);
-      if(errno != 0 || end_ptr == optarg || *end_ptr != '\0'){
-        argp_error(state, "Error converting to integer the argument for '--jobs' option");
-      }
-      if(arguments->jobs < 0){
-        argp_error(state, "Invalid argument for '--njobs' option");
-      }
-      break;
-    case 'i':
-      arguments->inc = strtol(arg, &end_ptr, 10);
-      if(errno != 0 || end_ptr == optarg || *end_ptr != '\0'){
-        argp_error(state, "Error converting to integer the argument for '--increase' option");
-      }
-      break;
-    case 'r':
-      arguments->respath = arg;
-      break;
-    case 'w':
-      arguments->nowait = 1;
-      break;
-    case ARGP_KEY_END:
-      if(state->arg_num != 0){
-        argp_error(state, "Found one or more no-option arguments");
-      }
-      if((arguments->policy == SCHED_FIFO || arguments->policy == SCHED_RR) && (arguments->priority == 0)){
-        argp_error(state, "Invalid argument for '--priority' option used with SCHED_FIFO or SCHED_RR policy. It must be between 1 and 99");
-      }
-      if((arguments->policy != SCHED_FIFO && arguments->policy != SCHED_RR) && (arguments->priority != 0)){
-        argp_error(state, "Invalid argument for '--priority' option used with a different policy from SCHED_FIFO and SCHED_RR. It must be 0");
-      }
-      break;
-    default:
-      return ARGP_ERR_UNKNOWN;
-  }
-  return 0;
-}
-
-//The ARGP parser
-static struct argp argp = { options, parse_opt, 0, doc };
-
-long update_parameter(long parameter);
-long update_parameter_2();
-long update_parameter_3(long parameter, long increase);
-long update_parameter_4(long parameter);
-void do_work(void* param);
-void do_work_exchanging(void* param);
-void do_work_ordering(void* param);
-
-int main(int argc, char *argv[]){
-  struct arguments arguments;   // A structure used to store the command line arguments
-  int pid;                      // The PID of the process
-  void (*do_work_ptr)(void *);  // A pointer to the job to execute based on the mode selected
-  struct timespec tp;           // A structure needed by the nanosleep to specify the number of sec and nsec to wait
-  exec_info* execution_info;    // A pointer to a structure that contains execution information
-  
-  // Default values of command line arguments
-  arguments.param = DEFAULT_PARAMETER;
-  arguments.inc = DEFAULT_INCREASE;
-  arguments.mode = DEFAULT_MODE;
-  arguments.policy = DEFAULT_POLICY;
-  arguments.priority = DEFAULT_PRIORITY;
-  arguments.jobs = DEFAULT_MAX_JOBS;
-  arguments.respath = DEFAULT_RESPATH;
-  arguments.nowait = DEFAULT_NOWAIT;
-
-  // Parse command line arguments
-  if(argp_parse(&argp, argc, argv, 0, 0, &arguments) != 0){
-    fprintf(stderr, "Parsing command line arguments error ...\n");
-    PRINT_ERROR;
-    exit(EXIT_FAILURE);
-  }
-
-  tp.tv_sec = 1;
-  tp.tv_nsec = 0;
-  pid = getpid();
-
-  printf("*** Starting ...\n");
-
-  // Init the exec_info struct
-  execution_info = create_exec_info(0, arguments.param, NULL);
-
-  if(arguments.mode == 3){
-    do_work_ptr = do_work_ordering;
-    execution_info->details = "ListOrdering";
-  }else if(arguments.mode == 2){
-    do_work_ptr = do_work_exchanging;
-    execution_info->details = "VariablesExchanging";
-  }else{
-    do_work_ptr = do_work;
-    execution_info->details = "EmptyLoop";
-  }
-
-  // Enabling the tracing infrastructure 
-  ENABLE_TRACING;
-
-  // Setting the scheduling policy and priority
-  set_scheduler_policy(0, arguments.policy, arguments.priority, execution_info);
-
-  // Setting up the filter of the sched_switch event
-  set_event_filter(pid, E_SCHED_SWITCH, SET);
-
-  printf("*** Execution ID: %s\n", execution_info->id);
-  printf("*** Job TYPE: %s\n", execution_info->details);
-  printf("*** Scheduling POLICY: %s\n", execution_info->sched_policy);
-  printf("*** Estimated time of some seconds/minutes, be patient ...\n");
-  printf("*** Executing ...\n");
-
-  // Enabling the tracing of the sched_switch event
-  event_record(E_SCHED_SWITCH, ENABLE);
-  for(int i = 0; i<arguments.jobs; i++){
-    // Updates the parameter
-    execution_info->parameter = arguments.param;
-    execution_info->job_number = i+1;
-    // Trace mark that the i-th job started
-    trace_mark_job(i+1, START);
-    // Execute Job
-    do_work_ptr(&arguments.param);
-    // Trace mark that the i-th job ended
-    trace_mark_job(i+1, STOP);
-    // Log the execution informations
-    log_execution_info(arguments.respath, execution_info->id, execution_info, NULL, DEFAULT_INFO);
-    // Wait some time before starting the next job
-    if(!arguments.nowait && nanosleep(&tp, NULL) != 0){
-      fprintf(stderr, "Nanosleep has been interrupted ...\n");
-    }
-    arguments.param = update_parameter_3(arguments.param, arguments.inc);
-  }
-  // Disabling the tracing of the sched_switch event
-  event_record(E_SCHED_SWITCH, DISABLE);
-  // Log the kernel trace
-  log_trace(arguments.respath, execution_info->id, USE_TRACE);
-  // Disabling the tracing infrastructure
-  DISABLE_TRACING;
-  
-  printf("*** DONE. All has been correctly saved under '%s' path\n", arguments.respath);
-  printf("*** Terminating\n");
-  return 0;
-}
-
-
-/**
- * @brief It updates the parameter based on the math function provided
- * @param parameter is the original value
- * @param i is an integer value used to choose the next value calculated by the math function
-*/
-long update_parameter(long parameter){
-  return (parameter%2 == 0) ? parameter/2 : 3*parameter + 1;
-}
-
-/**
- * @brief It updates the parameter based on the math function provided
-*/
-long update_parameter_2(){
-  long num;
-  
-  srand(time(NULL));
-  num = (rand() % (MAX_VALUE - MIN_VALUE + 1)) + MIN_VALUE;
-  return num;
-}
-
-/**
- * @brief It updates the parameter based on the math function provided
-*/
-long update_parameter_3(long parameter, long increase){
-  return parameter + increase;
-}
-
-/**
- * @brief It updates the parameter based on the math function provided
-*/
-long update_parameter_4(long parameter){
-  return parameter*2;
-}
-
-
-/**
- * @brief It performs a basic empty loop.
- * @param param is a void pointer that refers to an integer value. It's used as the upper bound of the loop index.
- */
-void do_work(void* param){
-  int num = *(int *)param;
-  for (int i = 0; i < num; i++){
-  }
-}
-
-/**
- * @brief It performs a loop where some random variables are swapped each other.
- * @param param is a void pointer that refers to an integer value. It's used as the upper bound of the loop index.
- */
-void do_work_exchanging(void * param){
-  int num = *(int *)param;
-  int a, b, temp;
-  srand(time(NULL));
-  for (int i = 0; i < num; i++){
-    a = rand() % 1000 + 1;
-    b = rand() % 1000 + 1;
-    temp = a;
-    a = b;
-    b = temp;
-  }
-}
-
-
-/**
- * @brief It is the comparing function for integers
- * @param a is the pointer to the first integer value to be compared
- * @param b is the pointer to the second integer values to be compared
- * @return an integer greater than 0 if and only if a > b or an integer lower than 0 if and only if a < b,
- * otherwise it return 0 if and only if a == b
-*/
-int compare_integer(void* a, void* b){
-  return *(int *)a - *(int *)b;
-}
-
-/**
- * @brief It performs a loop where it creates, sorts and deletes a list.
- * @param param is a void pointer that refers to an integer value. It's used as the upper bound of the loop index.
- */
-void do_work_ordering(void* param){
-  int n1 = 10, n2 = 30, n3 = 20, n4 = 50, n5 = 40;
-  int num = *(int *)param;
-
-  for(int i = 0; i<num; i++){
-    List * list = list_create();
-    list_add(list, &n1);
-    list_add(list, &n2);
-    list_add(list, &n3);
-    list_add(list, &n4);
-    list_add(list, &n5);
-    list->head = mergesort(list->head, compare_integer);
-    list_destroy(list);
-  }
-}
\ No newline at end of file
+#define _POSIX_C_SOURCE 199309L
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+#include <argp.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include "../include/event_tracing.h"
+#include "../include/trace_stream.h"
+#include "../include/trace_container.h"
+#include "../include/job_metrics.h"
+#include "../include/exec_logger.h"
+#include "../include/hist_aggregation.h"
+#include "../include/perf_counters.h"
+#include "../include/light_metrics.h"
+#include "../include/buffer_monitor.h"
+#include "../include/sched_latency.h"
+#include "../include/deadline_monitor.h"
+#include "../include/periodic_release.h"
+#include "../include/cpu_affinity.h"
+#include "../include/workload.h"
+#include "../include/adaptive_sampling.h"
+#include "jobs.h"
+
+#define DEFAULT_RESPATH "../../results" //Default value of RESPATH command line argument
+#define DEFAULT_PARAMETER 10000 //Default value of PARAM command line argument
+#define DEFAULT_MODE 3 //Default value of MODE command line argument
+#define DEFAULT_MAX_JOBS 50 //Default value of JOBS command line argument
+#define DEFAULT_POLICY SCHED_OTHER //Default value of POLICY command line argument
+#define DEFAULT_PRIORITY 0 //Default value of PRIO command line argument
+#define DEFAULT_NOWAIT 0 //Default flag of NOWAIT command line argument
+#define DEFAULT_INCREASE 10000 //Default value of INC command line argument
+#define DEFAULT_RAWMARKERS 0 //Default flag of RAWMARKERS command line argument
+#define DEFAULT_RAWTRACE 0 //Default flag of RAWTRACE command line argument
+#define DEFAULT_STREAM 0 //Default flag of STREAM command line argument
+#define DEFAULT_CONTAINER 0 //Default flag of CONTAINER command line argument
+#define DEFAULT_METRICS 0 //Default flag of METRICS command line argument
+#define DEFAULT_BINEXEC 0 //Default flag of BINEXEC command line argument
+#define DEFAULT_INSTANCE 0 //Default flag of INSTANCE command line argument
+#define DEFAULT_AGGREGATE 0 //Default flag of AGGREGATE command line argument
+#define DEFAULT_PERF 0 //Default flag of PERF command line argument
+#define DEFAULT_LIGHT 0 //Default flag of LIGHT command line argument
+#define DEFAULT_AUTOTUNE 0 //Default flag of AUTOTUNE command line argument
+#define DEFAULT_LATENCY 0 //Default flag of LATENCY command line argument
+#define DEFAULT_RUNTIME 0 //Default value of RUNTIME command line argument
+#define DEFAULT_DEADLINE 0 //Default value of DEADLINE command line argument
+#define DEFAULT_PERIOD 0 //Default value of PERIOD command line argument
+#define DEFAULT_RELEASE 0 //Default value of RELEASE command line argument
+#define DEFAULT_CPUS NULL //Default value of CPUS command line argument
+#define DEFAULT_IDLECPU 0 //Default flag of IDLECPU command line argument
+#define DEFAULT_WORKERS 0 //Default value of WORKERS command line argument
+#define DEFAULT_MIX NULL //Default value of MIX command line argument
+#define DEFAULT_WORKLOAD NULL //Default value of WORKLOAD command line argument
+#define DEFAULT_WORKLOADS NULL //Default value of WORKLOADS command line argument
+#define DEFAULT_LENGTH ORDERING_DEFAULT_LENGTH //Default value of LENGTH command line argument
+#define DEFAULT_TARGET_CI 0 //Default value of CI command line argument, which disables the repetitions
+#define DEFAULT_WARMUP 1 //Default value of WARMUP command line argument
+#define DEFAULT_MAX_REPS 30 //Default value of MAXREPS command line argument
+#define DEFAULT_CI_METRIC CI_METRIC_CPU //Default value of METRIC command line argument
+#define CI_METRIC_CPU 0 //Value of METRIC command line argument for the effective CPU time of the jobs
+#define CI_METRIC_SWITCHES 1 //Value of METRIC command line argument for the sched switches of the jobs
+#define CI_METRIC_LATENCY 2 //Value of METRIC command line argument for the time the jobs waited on a runqueue
+#define MAX_WORKERS 64 //Maximum value of WORKERS command line argument
+#define MAX_VALUE 1000000
+#define MIN_VALUE 100
+
+/**
+ * @brief A structure used to contain the command line arguments parsed from the user input. These arguments
+ * will be used to set up some options of this execution.
+*/
+struct arguments {
+  long param; //It is a long integer value representing the parameter value to use with the first job
+  long inc; //It is a long integer value representing the increase amount to be added to the PARAM argument for each iteration of a job
+  int mode; //It is an integer value representing the kind of job to perform
+  int policy; //It is an integer value representing the scheduling policy to use with the jobs executed
+  int priority; //It is an integer value representing the scheduler priority to use with the jobs executed
+  int jobs; //It is an integer value representing the number of jobs to perform
+  char* respath; //It is a string value representing the path where to save all the results
+  short nowait; //It is a flag used to specify to omit waiting between each job.
+  short rawmarkers; //It is a flag used to specify to mark jobs with binary records written to the trace_marker_raw file.
+  short rawtrace; //It is a flag used to specify to save the binary per-CPU traces instead of the text trace.
+  short stream; //It is a flag used to specify to drain the kernel trace with a consumer thread while the jobs are running.
+  short container; //It is a flag used to specify to save the kernel trace as a binary trace container with a job index.
+  short metrics; //It is a flag used to specify to compute the metrics of each job in C, writing them to the metrics file.
+  short binexec; //It is a flag used to specify to log the execution information as fixed-width binary records.
+  short instance; //It is a flag used to specify to trace in a private instance of the tracefs instead of the global one.
+  short aggregate; //It is a flag used to specify to aggregate the sched events of each job inside the kernel with hist triggers.
+  short perf; //It is a flag used to specify to count the software and hardware events of each job with perf_event_open().
+  short light; //It is a flag used to specify to measure the jobs without the tracefs, so that root privileges are not needed.
+  short autotune; //It is a flag used to specify to size the ring buffer from the event rate measured during a warm-up job.
+  short latency; //It is a flag used to specify to measure the wakeup-to-run scheduling latency of each job.
+  long long runtime; //It is a long integer value representing the runtime in nanoseconds of the SCHED_DEADLINE reservation
+  long long deadline; //It is a long integer value representing the relative deadline in nanoseconds of the SCHED_DEADLINE reservation
+  long long period; //It is a long integer value representing the period in nanoseconds of the SCHED_DEADLINE reservation
+  long long release; //It is a long integer value representing the period in nanoseconds of the absolute release schedule of the jobs
+  char* cpus; //It is a string value representing the list of CPUs where to run the jobs
+  cpu_set_t cpu_set; //It is the set of CPUs parsed from the CPUS argument
+  short idlecpu; //It is a flag used to specify to run each job on a CPU verified to be idle.
+  int workers; //It is an integer value representing the number of workers that run the jobs concurrently, 0 to run them in this process
+  char* mix; //It is a string value representing the scheduling policies and priorities assigned to the workers in turn
+  int mix_policies[MAX_WORKERS]; //It is the array of the scheduling policies parsed from the MIX argument
+  int mix_priorities[MAX_WORKERS]; //It is the array of the scheduler priorities parsed from the MIX argument
+  int n_mix; //It is an integer value representing the number of policies parsed from the MIX argument
+  char* workload; //It is a string value representing the name of the workload whose jobs are performed instead of the MODE argument
+  char* workloads; //It is a string value representing the path of the directory where to search the workload plugins
+  int length; //It is an integer value representing the number of elements of the lists sorted by the list ordering jobs
+  double target_ci; //It is a double value representing the target half-width of the confidence interval of each parameter, as a fraction of the mean, 0 to run each parameter once
+  int warmup; //It is an integer value representing the number of warm-up repetitions of each parameter, discarded
+  int max_reps; //It is an integer value representing the maximum number of measured repetitions of each parameter
+  int ci_metric; //It is an integer value representing the metric whose confidence interval is checked
+};
+
+//Program version.
+const char *argp_program_version = "Event Tracing Library 1.0";
+
+//Program bug report address.
+const char *argp_program_bug_address = "<riccardo.maino@edu.unito.it>";
+
+// Program documentation.
+static char doc[] = "This program demonstrates the usage of the 'event_tracing' library. Possible [OPTION...] could be the following ones:\
+\vThe arguments of the options MODE, POLICY and PRIO must comply with and respect the following values.\n\n\
+[MODE] possible integer values:\n\
+\t1: Empty loop job.\n\
+\t2: Variables exchanging job.\n\
+\t3: List ordering job.\n\
+\t4: Array ordering job.\n\n\
+[WORKLOAD] possible string values:\n\
+\tEmptyLoop, VariablesExchanging, ListOrdering, ArrayOrdering: The jobs of the MODE argument.\n\
+\tListOrderingPool, ListOrderingArena: The list ordering job, allocating the lists from a free-list pool or a bump arena.\n\
+\tThe lists and the arrays of the ordering jobs have LEN elements.\n\
+\tMemoryBandwidth: STREAM triad over arrays larger than the caches (PARAM KB of each array).\n\
+\tPointerChasing: Dependent loads along a random cycle of 64 MB (PARAM loads).\n\
+\tSyscallHeavy: getppid(), read() and write() system calls (PARAM times each).\n\
+\tSimdCompute: Multiply-add on vectors of floats held in the L1 cache (PARAM passes).\n\
+\tAny other workload exported by a plugin of the WORKLOADS directory.\n\n\
+[POLICY] possible string values:\n\
+\tSCHED_OTHER: Non-real-time scheduling policy.\n\
+\tSCHED_FIFO: Real-time scheduling policy.\n\
+\tSCHED_RR: Real-time scheduling policy.\n\
+\tSCHED_BATCH: Non-real-time scheduling policy.\n\
+\tSCHED_IDLE: Non-real-time scheduling policy.\n\
+\tSCHED_DEADLINE: Deadline scheduling policy.\n\n\
+[PRIO] possible integer values:\n\
+\t1 (low priority) to 99 (high priority): For SCHED_FIFO or SCHED_RR.\n\
+\t0: For all the others policies.\n\n\
+[RUNTIME], [DEADLINE] and [PERIOD] values in nanoseconds:\n\
+\tThey are needed only by SCHED_DEADLINE, and they must satisfy 1024 <= RUNTIME <= DEADLINE <= PERIOD.\n\
+\tIf only one between DEADLINE and PERIOD is given, the other one takes the same value.\n\n\
+[MIX] comma separated list of POLICY[:PRIO] values:\n\
+\tThe i-th worker uses the ((i-1) modulo the length of the list)-th element, e.g. 'SCHED_FIFO:50,SCHED_OTHER,SCHED_OTHER'.\n\n\
+[METRIC] possible string values:\n\
+\tcpu: The effective CPU time of the jobs, in nanoseconds.\n\
+\tswitches: The voluntary and involuntary context switches of the jobs.\n\
+\tlatency: The time the jobs waited on a runqueue, in nanoseconds.\n";
+
+// The command line options accepted to obtain the arguments contained in the 'struc arguments' structure
+static struct argp_option options[] = {
+  {"param", 'p', "PARAM", 0, "A long integer used to set the parameter value to use with the first job. The PARAM argument must be a positive long integer. Default is 10000."},
+  {"mode", 'm', "MODE", 0, "An integer used to set the kind of the job to perform. The MODE argument must be an integer value between the ones specified in the below section. Default is 3."},
+  {"policy", 's', "POLICY", 0, "A string used to set the scheduling policy of the jobs executed. The POLICY argument must be a string value between the ones specified in the below section. Default is SCHED_OTHER."},
+  {"priority", 'l', "PRIO", 0, "An integer used to set the scheduler priority of the jobs executed. The PRIO argument must be an intger value between the ones specified in the below section. Default is 0."},
+  {"jobs", 'j', "JOBS", 0, "An integer used to set the number of jobs executed. The JOBS argument must be a positive integer. Default is 50."},
+  {"respath", 'r', "RESPATH", 0, "A string used to set the path where to save all the tracing related data. Default is '../../results'."},
+  {"nowait", 'w', "NOWAIT", OPTION_ARG_OPTIONAL, "A flag used to specify to omit waiting of one second between each job."},
+  {"rawmarkers", 'b', "RAWMARKERS", OPTION_ARG_OPTIONAL, "A flag used to specify to mark the beginning and the end of each job with binary records written to the trace_marker_raw file instead of strings written to the trace_marker file."},
+  {"rawtrace", 't', "RAWTRACE", OPTION_ARG_OPTIONAL, "A flag used to specify to save the binary per-CPU traces, moved with splice() from the trace_pipe_raw files, instead of the text trace. They can be converted to text with the raw_trace_dump program."},
+  {"stream", 'S', "STREAM", OPTION_ARG_OPTIONAL, "A flag used to specify to drain the kernel trace into RESPATH with a background thread while the jobs are running, so that long executions don't lose the events of the first jobs when the ring buffer is full."},
+  {"container", 'C', "CONTAINER", OPTION_ARG_OPTIONAL, "A flag used to specify to save the kernel trace as a compact binary container ('trace.bin') with fixed-width records and an index of the job boundaries, instead of the text trace. It implies the RAWTRACE flag."},
+  {"metrics", 'M', "METRICS", OPTION_ARG_OPTIONAL, "A flag used to specify to compute the metrics of each job (effective and total CPU time, sched switches and migrations) at the end of the execution, writing them to the 'metrics.txt' file so that the Python module doesn't need to analyze the kernel trace. It implies the RAWTRACE flag."},
+  {"binexec", 'B', "BINEXEC", OPTION_ARG_OPTIONAL, "A flag used to specify to log the execution information of the jobs as fixed-width binary records in the 'exec.bin' file instead of the comma separated lines of the 'exec.txt' file."},
+  {"instance", 'I', "INSTANCE", OPTION_ARG_OPTIONAL, "A flag used to specify to trace in a private instance of the tracefs, named as the execution ID, with its own ring buffer, filters and enable files. It is removed at the end of the execution, and it allows to run several executions at the same time."},
+  {"aggregate", 'A', "AGGREGATE", OPTION_ARG_OPTIONAL, "A flag used to specify to aggregate the sched events of each job inside the kernel with hist triggers, reading only a few numbers per job to write the 'metrics.txt' file instead of exporting every sched_switch event. It can't be used with the METRICS flag."},
+  {"perf", 'P', "PERF", OPTION_ARG_OPTIONAL, "A flag used to specify to count the software events (task-clock, context-switches, cpu-migrations, page-faults) and, if a PMU is available, the hardware events (cycles, instructions, cache-misses) of each job with perf_event_open(), logging them as extra fields of the execution information."},
+  {"light", 'L', "LIGHT", OPTION_ARG_OPTIONAL, "A flag used to specify to measure the jobs without the tracefs and without root privileges, using the thread CPU clock, getrusage() and the scheduler statistics of /proc, and writing the same per-job metrics to the 'metrics.txt' file. It is used automatically when the tracefs is not available, and it can't be combined with the options that need the tracefs."},
+  {"autotune", 'T', "AUTOTUNE", OPTION_ARG_OPTIONAL, "A flag used to specify to run an unmarked warm-up job before the others, measuring the event rate in order to size the per-CPU ring buffer so that it holds the events of all the jobs, or of the longest job if the STREAM flag is used."},
+  {"latency", 'W', "LATENCY", OPTION_ARG_OPTIONAL, "A flag used to specify to trace the sched_wakeup events too, computing at the end of the execution the percentiles (p50, p99, p99.9, max) of the time elapsed from each wakeup of a job to the moment it got a CPU, and writing them to the 'latency.txt' file along with the histogram of all the jobs ('latency_hist.txt'). It implies the RAWTRACE flag and it can't be used with the AGGREGATE flag."},
+  {"runtime", 'R', "RUNTIME", 0, "A long integer used to set the runtime in nanoseconds of the SCHED_DEADLINE reservation, which is the CPU time a job can use in each period. It is required by the SCHED_DEADLINE policy."},
+  {"deadline", 'D', "DEADLINE", 0, "A long integer used to set the relative deadline in nanoseconds of the SCHED_DEADLINE reservation. Each job is checked against it, and the deadline misses and runtime overruns are logged as extra fields of the execution information. Default is the PERIOD argument."},
+  {"period", 'E', "PERIOD", 0, "A long integer used to set the period in nanoseconds of the SCHED_DEADLINE reservation. Default is the DEADLINE argument."},
+  {"release", 'e', "RELEASE", 0, "A long integer used to release the jobs periodically every RELEASE nanoseconds, sleeping until each release with clock_nanosleep(TIMER_ABSTIME) instead of waiting one second between the jobs. The release jitter, the response time and the period overruns of each job are logged as extra fields of the execution information and written to the kernel trace after the end marker of the job. It can't be used with the NOWAIT flag."},
+  {"cpus", 'c', "CPUS", 0, "A string used to set the list of CPUs where to run the jobs, in the format of the cpuset files (e.g. '0-3,6'). The affinity is set with sched_setaffinity() before the jobs, and its mask and the CPUs where each job started and ended are logged as extra fields of the execution information."},
+  {"idlecpu", 'U', "IDLECPU", OPTION_ARG_OPTIONAL, "A flag used to specify to pin each job to the idlest CPU, among the ones of the CPUS argument or all the allowed ones, observing the idle time of the CPUs for 200 milliseconds before the job. A warning is printed when no CPU is idle for at least 95% of the time."},
+  {"workers", 'k', "WORKERS", 0, "An integer used to run the jobs in WORKERS concurrent processes, each of them running all the jobs with its own scheduling policy and priority, so that the jobs compete for the CPUs. The markers of the jobs become 'start_job=<worker>:<job>' and 'end_job=<worker>:<job>', the sched_switch filter matches all the workers, and the worker of each job is logged as an extra field of the execution information. The WORKERS argument must be between 1 and 64."},
+  {"mix", 'x', "MIX", 0, "A string used to set the scheduling policies and priorities of the workers, assigned to them in turn. The MIX argument must be a list as specified in the below section. Default is the POLICY and PRIO arguments for all the workers."},
+  {"workload", 'o', "WORKLOAD", 0, "A string used to set the kind of the job to perform by name, overriding the MODE argument. The WORKLOAD argument must be a name between the ones specified in the below section, and it is logged as the details of the execution information. The workloads other than the ones of the MODE argument are loaded with dlopen() from the plugins of the WORKLOADS directory."},
+  {"length", 'n', "LEN", 0, "An integer used to set the number of elements of the lists or the arrays created and sorted by each iteration of the ordering jobs, so that the size of the data can be scaled besides the number of iterations set by PARAM. It is logged as the 'list_length' extra field of the execution information. The LEN argument must be a positive integer. Default is 5."},
+  {"workloads", 'y', "WORKLOADS", 0, "A string used to set the directory where to search the workload plugins. Default is the 'workloads' directory next to this program."},
+  {"target-ci", 'q', "CI", 0, "A number used to repeat the job of each parameter until the half-width of the 95% confidence interval of the mean of METRIC is at most CI times the mean, or until MAXREPS repetitions, instead of running it once. The first WARMUP repetitions of each parameter are discarded. Each repetition is a job, whose number in its parameter and the bounds of the confidence interval so far are logged as the 'ci_repetition', 'ci_low' and 'ci_high' extra fields of the execution information, along with 'warmup_repetitions' and 'ci_status' (0 while repeating, 1 when CI is reached, 2 when MAXREPS is reached). The CI argument must be between 0 and 1, e.g. 0.05 for 5%. It can't be used with the WORKERS argument."},
+  {"warmup", 'u', "WARMUP", 0, "An integer used to set the number of warm-up repetitions of each parameter, run before the measured ones without being logged nor marked in the kernel trace. It is used only with the CI argument. Default is 1."},
+  {"max-reps", 'X', "MAXREPS", 0, "An integer used to set the maximum number of measured repetitions of each parameter. It is used only with the CI argument, and it must be at least 3. Default is 30."},
+  {"ci-metric", 'Q', "METRIC", 0, "A string used to set the metric whose confidence interval is checked, measured without the tracefs. The METRIC argument must be a string value between the ones specified in the below section. It is used only with the CI argument. Default is cpu."},
+  {"increase", 'i', "INC", 0, "A long integer used to set the increase amount to be added for each iteration to the PARAM argument for each execution iteration of a job. This means that each job will be executed with a different parameter value. Default is 10000."},
+  {0}
+};
+
+/**
+ * @brief It converts the name of a scheduling policy into its value
+ * @param str is the name of the policy, such as "SCHED_FIFO"
+ * @return the value of the policy, or -1 if the name is not valid
+*/
+static int parse_policy(const char* str){
+  if(strcmp("SCHED_OTHER", str) == 0)
+    return SCHED_OTHER;
+  else if(strcmp("SCHED_FIFO", str) == 0)
+    return SCHED_FIFO;
+  else if(strcmp("SCHED_RR", str) == 0)
+    return SCHED_RR;
+  else if(strcmp("SCHED_BATCH", str) == 0)
+    return SCHED_BATCH;
+  else if(strcmp("SCHED_IDLE", str) == 0)
+    return SCHED_IDLE;
+  else if(strcmp("SCHED_DEADLINE", str) == 0)
+    return SCHED_DEADLINE;
+  return -1;
+}
+
+/**
+ * @brief It parses the MIX argument, a comma separated list of POLICY[:PRIO] values, into the arguments structure
+ * @param mix is the string to parse. It is modified by the parsing
+ * @param arguments is the pointer to the structure where to store the policies and the priorities
+ * @return 0 if the list is valid, -1 otherwise
+*/
+static int parse_mix(char* mix, struct arguments* arguments){
+  char *item, *save_ptr, *prio, *end_ptr;
+
+  arguments->n_mix = 0;
+  for(item = strtok_r(mix, ",", &save_ptr); item != NULL; item = strtok_r(NULL, ",", &save_ptr)){
+    if(arguments->n_mix == MAX_WORKERS)
+      return -1;
+    prio = strchr(item, ':');
+    if(prio != NULL)
+      *prio++ = '\0';
+    arguments->mix_policies[arguments->n_mix] = parse_policy(item);
+    arguments->mix_priorities[arguments->n_mix] = prio != NULL ? strtol(prio, &end_ptr, 10) : 0;
+    if(arguments->mix_policies[arguments->n_mix] == -1 || (prio != NULL && (end_ptr == prio || *end_ptr != '\0')))
+      return -1;
+    // The same rules of the POLICY and PRIO arguments
+    if(arguments->mix_policies[arguments->n_mix] == SCHED_FIFO || arguments->mix_policies[arguments->n_mix] == SCHED_RR){
+      if(arguments->mix_priorities[arguments->n_mix] < 1 || arguments->mix_priorities[arguments->n_mix] > 99)
+        return -1;
+    }else if(arguments->mix_priorities[arguments->n_mix] != 0){
+      return -1;
+    }
+    arguments->n_mix++;
+  }
+  return arguments->n_mix > 0 ? 0 : -1;
+}
+
+//Function used by the command line arguments parser to correctly obtain arguments.
+static error_t parse_opt(int key, char *arg, struct argp_state *state) {
+  char *end_ptr;
+  short uses_deadline;
+  //Get the input argument from argp_parse, which we know is a pointer to our arguments structure.
+  struct arguments *arguments = state->input;
+  switch(key){
+    case 'p':
+      arguments->param = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--param' option");
+      }
+      if(arguments->param < 0){
+        argp_error(state, "Invalid argument for '--param' option");
+      }
+      break;
+    case 'm':
+      arguments->mode = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == optarg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--mode' option");
+      }
+      if(arguments->mode < 1 || arguments->mode > 4){
+        argp_error(state, "Invalid argument for '--mode' option");
+      }
+      break;
+    case 'o':
+      arguments->workload = arg;
+      break;
+    case 'y':
+      arguments->workloads = arg;
+      break;
+    case 'n':
+      arguments->length = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == optarg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--length' option");
+      }
+      if(arguments->length <= 0){
+        argp_error(state, "Invalid argument for '--length' option");
+      }
+      break;
+    case 's':
+      arguments->policy = parse_policy(arg);
+      if(arguments->policy == -1)
+        argp_error(state, "Invalid argument for '--policy' option");
+      break;
+    case 'l':
+      arguments->priority = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == optarg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--priority' option");
+      }
+      if(arguments->priority < 0 || arguments->priority > 99){
+        argp_error(state, "Invalid argument for '--priority' option");
+      }
+      break;
+    case 'j':
+      arguments->jobs = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == optarg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--jobs' option");
+      }
+      if(arguments->jobs < 0){
+        argp_error(state, "Invalid argument for '--njobs' option");
+      }
+      break;
+    case 'i':
+      arguments->inc = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == optarg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--increase' option");
+      }
+      break;
+    case 'r':
+      arguments->respath = arg;
+      break;
+    case 'w':
+      arguments->nowait = 1;
+      break;
+    case 'b':
+      arguments->rawmarkers = 1;
+      break;
+    case 't':
+      arguments->rawtrace = 1;
+      break;
+    case 'S':
+      arguments->stream = 1;
+      break;
+    case 'C':
+      arguments->container = 1;
+      arguments->rawtrace = 1;
+      break;
+    case 'M':
+      arguments->metrics = 1;
+      arguments->rawtrace = 1;
+      break;
+    case 'B':
+      arguments->binexec = 1;
+      break;
+    case 'I':
+      arguments->instance = 1;
+      break;
+    case 'A':
+      arguments->aggregate = 1;
+      break;
+    case 'P':
+      arguments->perf = 1;
+      break;
+    case 'L':
+      arguments->light = 1;
+      break;
+    case 'T':
+      arguments->autotune = 1;
+      break;
+    case 'W':
+      arguments->latency = 1;
+      arguments->rawtrace = 1;
+      break;
+    case 'e':
+      arguments->release = strtoll(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--release' option");
+      }
+      if(arguments->release <= 0){
+        argp_error(state, "Invalid argument for '--release' option");
+      }
+      break;
+    case 'c':
+      arguments->cpus = arg;
+      if(parse_cpu_list(arg, &arguments->cpu_set) == -1){
+        argp_error(state, "Invalid argument for '--cpus' option");
+      }
+      break;
+    case 'U':
+      arguments->idlecpu = 1;
+      break;
+    case 'k':
+      arguments->workers = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--workers' option");
+      }
+      if(arguments->workers < 1 || arguments->workers > MAX_WORKERS){
+        argp_error(state, "Invalid argument for '--workers' option");
+      }
+      break;
+    case 'q':
+      arguments->target_ci = strtod(arg, &end_ptr);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to number the argument for '--target-ci' option");
+      }
+      if(!(arguments->target_ci > 0 && arguments->target_ci < 1)){
+        argp_error(state, "Invalid argument for '--target-ci' option. It must be between 0 and 1");
+      }
+      break;
+    case 'u':
+      arguments->warmup = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--warmup' option");
+      }
+      if(arguments->warmup < 0){
+        argp_error(state, "Invalid argument for '--warmup' option");
+      }
+      break;
+    case 'X':
+      arguments->max_reps = strtol(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--max-reps' option");
+      }
+      if(arguments->max_reps < ADAPTIVE_MIN_REPETITIONS){
+        argp_error(state, "Invalid argument for '--max-reps' option. It must be at least 3");
+      }
+      break;
+    case 'Q':
+      if(strcmp(arg, "cpu") == 0)
+        arguments->ci_metric = CI_METRIC_CPU;
+      else if(strcmp(arg, "switches") == 0)
+        arguments->ci_metric = CI_METRIC_SWITCHES;
+      else if(strcmp(arg, "latency") == 0)
+        arguments->ci_metric = CI_METRIC_LATENCY;
+      else
+        argp_error(state, "Invalid argument for '--ci-metric' option");
+      break;
+    case 'x':
+      arguments->mix = arg;
+      if(parse_mix(strdupa(arg), arguments) == -1){
+        argp_error(state, "Invalid argument for '--mix' option");
+      }
+      break;
+    case 'R':
+      arguments->runtime = strtoll(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--runtime' option");
+      }
+      if(arguments->runtime < SCHED_DL_MIN_RUNTIME){
+        argp_error(state, "Invalid argument for '--runtime' option. It must be at least 1024 nanoseconds");
+      }
+      break;
+    case 'D':
+      arguments->deadline = strtoll(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--deadline' option");
+      }
+      if(arguments->deadline <= 0){
+        argp_error(state, "Invalid argument for '--deadline' option");
+      }
+      break;
+    case 'E':
+      arguments->period = strtoll(arg, &end_ptr, 10);
+      if(errno != 0 || end_ptr == arg || *end_ptr != '\0'){
+        argp_error(state, "Error converting to integer the argument for '--period' option");
+      }
+      if(arguments->period <= 0){
+        argp_error(state, "Invalid argument for '--period' option");
+      }
+      break;
+    case ARGP_KEY_END:
+      if(state->arg_num != 0){
+        argp_error(state, "Found one or more no-option arguments");
+      }
+      if((arguments->policy == SCHED_FIFO || arguments->policy == SCHED_RR) && (arguments->priority == 0)){
+        argp_error(state, "Invalid argument for '--priority' option used with SCHED_FIFO or SCHED_RR policy. It must be between 1 and 99");
+      }
+      if((arguments->policy != SCHED_FIFO && arguments->policy != SCHED_RR) && (arguments->priority != 0)){
+        argp_error(state, "Invalid argument for '--priority' option used with a different policy from SCHED_FIFO and SCHED_RR. It must be 0");
+      }
+      uses_deadline = arguments->policy == SCHED_DEADLINE;
+      for(int i = 0; i < arguments->n_mix; i++)
+        uses_deadline |= arguments->mix_policies[i] == SCHED_DEADLINE;
+      if(uses_deadline){
+        if(arguments->deadline == 0)
+          arguments->deadline = arguments->period;
+        if(arguments->period == 0)
+          arguments->period = arguments->deadline;
+        if(arguments->runtime == 0 || arguments->deadline == 0){
+          argp_error(state, "The SCHED_DEADLINE policy needs the '--runtime' option and at least one between the '--deadline' and '--period' options");
+        }
+        if(arguments->runtime > arguments->deadline || arguments->deadline > arguments->period){
+          argp_error(state, "Invalid SCHED_DEADLINE reservation. It must be RUNTIME <= DEADLINE <= PERIOD");
+        }
+        if(arguments->cpus != NULL || arguments->idlecpu){
+          argp_error(state, "The '--cpus' and '--idlecpu' options can't be used with the SCHED_DEADLINE policy, whose tasks must be allowed to run on all the CPUs of their root domain");
+        }
+      }else if(arguments->runtime != 0 || arguments->deadline != 0 || arguments->period != 0){
+        argp_error(state, "The '--runtime', '--deadline' and '--period' options can be used only with the SCHED_DEADLINE policy");
+      }
+      if(arguments->mix != NULL && arguments->workers == 0){
+        argp_error(state, "The '--mix' option can be used only with the '--workers' option");
+      }
+      if(arguments->workers > 0 && (arguments->aggregate || arguments->metrics || arguments->latency || arguments->container)){
+        argp_error(state, "The '--workers' option can't be used with the '--aggregate', '--metrics', '--latency' and '--container' options, whose analyses attribute the events to a single process");
+      }
+      if(arguments->target_ci == 0 && (arguments->warmup != DEFAULT_WARMUP || arguments->max_reps != DEFAULT_MAX_REPS || arguments->ci_metric != DEFAULT_CI_METRIC)){
+        argp_error(state, "The '--warmup', '--max-reps' and '--ci-metric' options can be used only with the '--target-ci' option");
+      }
+      if(arguments->target_ci != 0 && arguments->workers > 0){
+        argp_error(state, "The '--target-ci' option can't be used with the '--workers' option, since the workers would repeat their jobs independently");
+      }
+      if(arguments->release != 0 && arguments->nowait){
+        argp_error(state, "The '--release' and '--nowait' options can't be used together, since the release schedule replaces the wait between the jobs");
+      }
+      if(!arguments->light && !tracefs_available()){
+        arguments->light = 1;
+      }
+      if(arguments->light && (arguments->rawmarkers || arguments->rawtrace || arguments->stream || arguments->aggregate || arguments->instance || arguments->autotune)){
+        argp_error(state, "The options that need the tracefs can't be used with the unprivileged measurement of the '--light' option, which is used automatically when the tracefs is not available");
+      }
+      if(arguments->aggregate && arguments->latency){
+        argp_error(state, "The '--aggregate' and '--latency' options can't be used together, since the sched events aren't exported to the kernel trace");
+      }
+      if(arguments->aggregate && arguments->metrics){
+        argp_error(state, "The '--aggregate' and '--metrics' options can't be used together, since both write the metrics file");
+      }
+      break;
+    default:
+      return ARGP_ERR_UNKNOWN;
+  }
+  return 0;
+}
+
+//The ARGP parser
+static struct argp argp = { options, parse_opt, 0, doc };
+
+long update_parameter(long parameter);
+long update_parameter_2();
+long update_parameter_3(long parameter, long increase);
+long update_parameter_4(long parameter);
+workload_module* open_job_workload(struct arguments* arguments);
+double ci_metric_value(light_metrics* sampler, int metric);
+int fork_workers(int n_workers, pid_t* pids, int* start_fds);
+void wait_start(int* start_fds);
+int wait_workers(int n_workers, pid_t* pids);
+
+int main(int argc, char *argv[]){
+  struct arguments arguments;                // A structure used to store the command line arguments
+  int pid;                                   // The PID of the process
+  workload_module* job_workload;             // A pointer to the job to execute based on the mode or the workload selected
+  struct timespec tp;                        // A structure needed by the nanosleep to specify the number of sec and nsec to wait
+  exec_info* execution_info;                 // A pointer to a structure that contains execution information
+  tracing_session* session = NULL;           // A pointer to a structure that keeps open the tracefs files used during the execution
+  trace_stream* stream = NULL;               // A pointer to a structure that represents the thread draining the kernel trace, if requested
+  char* dir_file_path;                       // The path to the directory of this execution
+  exec_logger* logger;                       // A pointer to a structure that buffers the execution information of the jobs
+  hist_aggregation* aggregation = NULL;      // A pointer to a structure that keeps the hist triggers of the kernel, if requested
+  job_metrics_engine* metrics_engine = NULL; // A pointer to a structure that writes the metrics file of the aggregated or unprivileged jobs
+  job_metrics job;                           // The metrics of a job read from the kernel histograms or measured without the tracefs
+  perf_counters* counters = NULL;            // A pointer to a structure that keeps the perf_event counters of the jobs, if requested
+  light_metrics* light = NULL;               // A pointer to a structure that measures the jobs without the tracefs, if requested
+  buffer_monitor* monitor = NULL;            // A pointer to a structure that reads the statistics of the ring buffers
+  struct timespec warmup_start, warmup_end;  // The beginning and the end of the warm-up job
+  double warmup_seconds, retention_seconds;  // The duration of the warm-up job and the time the ring buffer must hold the events
+  deadline_monitor* dl_monitor = NULL;       // A pointer to a structure that checks the deadline and the runtime of the jobs, if SCHED_DEADLINE is used
+  periodic_release* release = NULL;          // A pointer to a structure that releases the jobs periodically, if requested
+  cpu_set_t candidates;                      // The CPUs among which the idlest one is chosen before each job, if requested
+  int worker = 0;                            // The worker run by this process, 0 for the parent of the workers or if the jobs run in this process
+  pid_t worker_pids[MAX_WORKERS];            // The pids of the workers, if requested
+  int start_fds[2];                          // The pipe closed by the parent to start all the workers at the same time
+  int jobs;                                  // The number of jobs run by this process, none for the parent of the workers
+  adaptive_sampling* sampling = NULL;        // A pointer to a structure that repeats the job of each parameter until its confidence interval is narrow enough, if requested
+  light_metrics* sampler = NULL;             // A pointer to a structure that measures the metric of the repetitions, the LIGHT one if it is used
+  int job_number = 0;                        // The number of the last job, which counts the repetitions of the parameters
+  int n_reached = 0;                         // The number of parameters whose confidence interval reached the target
+  int repetitions;                           // The maximum number of times the job of each parameter is run
+  
+  // Default values of command line arguments
+  arguments.param = DEFAULT_PARAMETER;
+  arguments.inc = DEFAULT_INCREASE;
+  arguments.mode = DEFAULT_MODE;
+  arguments.policy = DEFAULT_POLICY;
+  arguments.priority = DEFAULT_PRIORITY;
+  arguments.jobs = DEFAULT_MAX_JOBS;
+  arguments.respath = DEFAULT_RESPATH;
+  arguments.nowait = DEFAULT_NOWAIT;
+  arguments.rawmarkers = DEFAULT_RAWMARKERS;
+  arguments.rawtrace = DEFAULT_RAWTRACE;
+  arguments.stream = DEFAULT_STREAM;
+  arguments.container = DEFAULT_CONTAINER;
+  arguments.metrics = DEFAULT_METRICS;
+  arguments.binexec = DEFAULT_BINEXEC;
+  arguments.instance = DEFAULT_INSTANCE;
+  arguments.aggregate = DEFAULT_AGGREGATE;
+  arguments.perf = DEFAULT_PERF;
+  arguments.light = DEFAULT_LIGHT;
+  arguments.autotune = DEFAULT_AUTOTUNE;
+  arguments.latency = DEFAULT_LATENCY;
+  arguments.runtime = DEFAULT_RUNTIME;
+  arguments.deadline = DEFAULT_DEADLINE;
+  arguments.period = DEFAULT_PERIOD;
+  arguments.release = DEFAULT_RELEASE;
+  arguments.cpus = DEFAULT_CPUS;
+  arguments.idlecpu = DEFAULT_IDLECPU;
+  arguments.workers = DEFAULT_WORKERS;
+  arguments.mix = DEFAULT_MIX;
+  arguments.n_mix = 0;
+  arguments.workload = DEFAULT_WORKLOAD;
+  arguments.workloads = DEFAULT_WORKLOADS;
+  arguments.length = DEFAULT_LENGTH;
+  arguments.target_ci = DEFAULT_TARGET_CI;
+  arguments.warmup = DEFAULT_WARMUP;
+  arguments.max_reps = DEFAULT_MAX_REPS;
+  arguments.ci_metric = DEFAULT_CI_METRIC;
+
+  // Parse command line arguments
+  if(argp_parse(&argp, argc, argv, 0, 0, &arguments) != 0){
+    fprintf(stderr, "Parsing command line arguments error ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  tp.tv_sec = 1;
+  tp.tv_nsec = 0;
+  pid = getpid();
+
+  printf("*** Starting ...\n");
+
+  // Init the exec_info struct
+  execution_info = create_exec_info(0, arguments.param, NULL);
+
+  job_workload = open_job_workload(&arguments);
+  execution_info->details = (char*)job_workload->workload->name;
+  set_ordering_length(arguments.length);
+  if(is_ordering_job(job_workload->workload)){
+    exec_info_set_metric(execution_info, "list_length", arguments.length);
+  }
+
+  // Opening the tracefs files once for the whole execution, in a private instance if requested, and enabling the tracing infrastructure
+  if(!arguments.light){
+    session = arguments.instance ? create_instance_session(execution_info->id) : create_tracing_session(NULL);
+    ENABLE_TRACING_SESSION(session);
+  }
+
+  // Setting the scheduling policy and priority, or the reservation of SCHED_DEADLINE asking the kernel to signal the runtime overruns.
+  // The workers set their own policy, since a SCHED_DEADLINE process can't fork
+  if(arguments.workers > 0){
+    printf("*** WORKERS: %d with POLICIES: %s\n", arguments.workers, arguments.mix != NULL ? arguments.mix : execution_info->sched_policy);
+  }else if(arguments.policy == SCHED_DEADLINE){
+    set_deadline_policy(0, arguments.runtime, arguments.deadline, arguments.period, SCHED_FLAG_DL_OVERRUN, execution_info);
+    dl_monitor = create_deadline_monitor(arguments.runtime, arguments.deadline, arguments.period);
+  }else{
+    set_scheduler_policy(0, arguments.policy, arguments.priority, execution_info);
+  }
+
+  // Pinning the process to the requested CPUs, which are also the candidates of the idle CPU search
+  if(arguments.cpus != NULL){
+    set_cpu_affinity(0, &arguments.cpu_set, execution_info);
+    candidates = arguments.cpu_set;
+  }else if(arguments.idlecpu && sched_getaffinity(0, sizeof(candidates), &candidates) == -1){
+    fprintf(stderr, "Error retrieving the CPU affinity ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+
+  // Setting up the filter of the sched_switch event
+  if(session != NULL){
+    set_event_filter_session(session, pid, E_SCHED_SWITCH, SET);
+    if(arguments.latency)
+      set_event_filter_session(session, pid, E_SCHED_WAKEUP, SET);
+  }else{
+    printf("*** The jobs are measured without the tracefs\n");
+  }
+
+  printf("*** Execution ID: %s\n", execution_info->id);
+  printf("*** Job TYPE: %s\n", execution_info->details);
+  printf("*** Scheduling POLICY: %s\n", execution_info->sched_policy);
+  printf("*** Estimated time of some seconds/minutes, be patient ...\n");
+  printf("*** Executing ...\n");
+
+  // Opening the execution information file once for the whole execution
+  logger = create_exec_logger(arguments.respath, execution_info->id, arguments.binexec ? EXEC_LOG_BINARY : EXEC_LOG_TEXT, 0);
+
+  // Starting the thread that drains the kernel trace while the jobs are running
+  if(arguments.stream){
+    stream = start_trace_stream(session->tracing_path, arguments.respath, execution_info->id, arguments.rawtrace ? USE_TRACE_RAW : USE_TRACE_PIPE);
+  }
+
+  // Installing the hist triggers that aggregate the sched events of the jobs, opening the unprivileged measurement, or enabling
+  // the tracing of the sched_switch event
+  if(arguments.aggregate || arguments.light){
+    dir_file_path = create_execution_directory(arguments.respath, execution_info->id);
+    metrics_engine = create_job_metrics_engine(dir_file_path, execution_info->id, NULL);
+    free(dir_file_path);
+  }
+  if(arguments.aggregate){
+    aggregation = create_hist_aggregation(session, pid);
+  }else if(arguments.light){
+    // The workers measure their own jobs
+    if(arguments.workers == 0)
+      light = create_light_metrics();
+  }else{
+    event_record_session(session, E_SCHED_SWITCH, ENABLE);
+    if(arguments.latency)
+      event_record_session(session, E_SCHED_WAKEUP, ENABLE);
+  }
+  // Sizing the ring buffer from the events recorded during a warm-up job, then reading its statistics at each job boundary
+  if(session != NULL){
+    monitor = create_buffer_monitor(session);
+  }
+  if(arguments.autotune){
+    workload_init(job_workload);
+    buffer_monitor_warmup_start(monitor);
+    clock_gettime(CLOCK_MONOTONIC, &warmup_start);
+    workload_run(job_workload, arguments.param);
+    clock_gettime(CLOCK_MONOTONIC, &warmup_end);
+    workload_teardown(job_workload);
+    warmup_seconds = (warmup_end.tv_sec - warmup_start.tv_sec) + (warmup_end.tv_nsec - warmup_start.tv_nsec) / 1e9;
+    // The duration of a job is assumed to grow linearly with its parameter, and each parameter can be repeated
+    repetitions = arguments.target_ci > 0 ? arguments.warmup + arguments.max_reps : 1;
+    retention_seconds = 0;
+    for(int i = 0; i<arguments.jobs && arguments.param > 0; i++){
+      if(arguments.stream)
+        retention_seconds = warmup_seconds * (arguments.param + (double)i*arguments.inc) / arguments.param;
+      else
+        retention_seconds += warmup_seconds * (arguments.param + (double)i*arguments.inc) / arguments.param * repetitions;
+    }
+    printf("*** Ring buffer SIZE: %lu KB per CPU\n", buffer_monitor_autotune(monitor, retention_seconds));
+    if(stream == NULL)
+      clean_trace_session(session);
+  }
+  // Forking the workers, which set their own policy and wait until the parent has traced all of them before running the jobs concurrently
+  jobs = arguments.jobs;
+  if(arguments.workers > 0){
+    fflush(stdout);
+    worker = fork_workers(arguments.workers, worker_pids, start_fds);
+    if(worker == 0){
+      if(session != NULL)
+        set_event_filter_pids_session(session, worker_pids, arguments.workers, E_SCHED_SWITCH, SET);
+      close(start_fds[1]);
+      jobs = 0;
+      if(wait_workers(arguments.workers, worker_pids) != 0)
+        fprintf(stderr, "One or more workers failed ...\n");
+    }else{
+      pid = getpid();
+      if(arguments.n_mix > 0){
+        arguments.policy = arguments.mix_policies[(worker - 1) % arguments.n_mix];
+        arguments.priority = arguments.mix_priorities[(worker - 1) % arguments.n_mix];
+      }
+      if(arguments.policy == SCHED_DEADLINE){
+        set_deadline_policy(0, arguments.runtime, arguments.deadline, arguments.period, SCHED_FLAG_DL_OVERRUN, execution_info);
+        dl_monitor = create_deadline_monitor(arguments.runtime, arguments.deadline, arguments.period);
+      }else{
+        set_scheduler_policy(0, arguments.policy, arguments.priority, execution_info);
+      }
+      exec_info_set_metric(execution_info, "worker", worker);
+      if(arguments.light)
+        light = create_light_metrics();
+      // The workers append their jobs to the metrics file opened by the parent, each line with a single write()
+      if(metrics_engine != NULL)
+        job_metrics_reopen_shared(metrics_engine);
+      wait_start(start_fds);
+    }
+  }
+  // Creating the state of the workload in the process that runs the jobs, so that each worker has its own buffers
+  if(jobs > 0){
+    workload_init(job_workload);
+  }
+  // Opening the perf_event counters of the process, disabled until the first job starts
+  if(arguments.perf){
+    counters = create_perf_counters(pid);
+  }
+  // Starting the absolute release schedule one period from now
+  if(arguments.release != 0){
+    release = create_periodic_release(arguments.release);
+  }
+  // Repeating the job of each parameter until the confidence interval of its metric reaches the target, measuring the metric
+  // without the tracefs
+  if(arguments.target_ci > 0){
+    sampling = create_adaptive_sampling(arguments.target_ci, arguments.warmup, arguments.max_reps);
+    sampler = light != NULL ? light : create_light_metrics();
+  }
+  for(int i = 0; i<jobs; i++){
+    if(sampling != NULL)
+      adaptive_sampling_reset(sampling);
+    do{
+      // Run the warm-up repetitions of the i-th parameter without measuring nor logging them
+      if(sampling != NULL && adaptive_sampling_warmup(sampling)){
+        workload_run(job_workload, arguments.param);
+        continue;
+      }
+      job_number++;
+      // Move to the idlest CPU before the i-th job
+      if(arguments.idlecpu)
+        pin_idle_cpu(0, &candidates, execution_info);
+      // Sleep until the release of the i-th job
+      if(release != NULL)
+        periodic_release_wait(release);
+      // Updates the parameter
+      execution_info->parameter = arguments.param;
+      execution_info->job_number = job_number;
+      // Trace mark that the i-th job started
+      if(light != NULL)
+        light_metrics_job_start(light, job_number);
+      else if(arguments.rawmarkers)
+        trace_mark_worker_job_raw_session(session, worker, job_number, START, arguments.param);
+      else if(worker != 0)
+        trace_mark_worker_job_session(session, worker, job_number, START);
+      else
+        trace_mark_job_session(session, job_number, START);
+      if(monitor != NULL)
+        buffer_monitor_job_start(monitor);
+      if(aggregation != NULL)
+        hist_aggregation_job_start(aggregation);
+      if(counters != NULL)
+        perf_counters_job_start(counters);
+      if(dl_monitor != NULL)
+        deadline_monitor_job_start(dl_monitor);
+      if(arguments.cpus != NULL || arguments.idlecpu)
+        record_current_cpu(execution_info, "start_cpu");
+      if(sampler != NULL && sampler != light)
+        light_metrics_job_start(sampler, job_number);
+      // Execute Job
+      workload_run(job_workload, arguments.param);
+      if(sampler != NULL && sampler != light)
+        light_metrics_job_end(sampler, NULL, NULL);
+      // Record the CPU where the i-th job ended, which differs from the starting one if it migrated
+      if(arguments.cpus != NULL || arguments.idlecpu)
+        record_current_cpu(execution_info, "end_cpu");
+      // Check whether the i-th job missed its deadline or overran its runtime
+      if(dl_monitor != NULL)
+        deadline_monitor_job_end(dl_monitor, execution_info);
+      // Measure the response time of the i-th job with respect to its ideal release
+      if(release != NULL)
+        periodic_release_job_end(release, execution_info);
+      // Read the counters of the i-th job into the execution informations
+      if(counters != NULL)
+        perf_counters_job_end(counters, execution_info);
+      // Read the histograms of the i-th job
+      if(aggregation != NULL){
+        hist_aggregation_job_end(aggregation, &job);
+        job.job_number = job_number;
+      }
+      // Trace mark that the i-th job ended
+      if(light != NULL){
+        light_metrics_job_end(light, &job, execution_info);
+        job.worker = worker;
+      }else if(arguments.rawmarkers)
+        trace_mark_worker_job_raw_session(session, worker, job_number, STOP, arguments.param);
+      else if(worker != 0)
+        trace_mark_worker_job_session(session, worker, job_number, STOP);
+      else
+        trace_mark_job_session(session, job_number, STOP);
+      if(release != NULL && session != NULL)
+        periodic_release_mark_session(release, session, job_number);
+      // Account the events lost by the ring buffers during the i-th job
+      if(monitor != NULL)
+        buffer_monitor_job_end(monitor, execution_info);
+      // Add the metric of the i-th job to the repetitions of its parameter, logging the confidence interval so far
+      if(sampling != NULL && adaptive_sampling_add(sampling, ci_metric_value(sampler, arguments.ci_metric), execution_info) &&
+         sampling->status == ADAPTIVE_REACHED)
+        n_reached++;
+      // Log the execution informations, without touching the file system until the end of the execution
+      exec_logger_log(logger, execution_info);
+      if(metrics_engine != NULL)
+        job_metrics_write(metrics_engine, &job);
+      // Give up the runtime left, so that the next job starts at the beginning of a new period
+      if(dl_monitor != NULL)
+        sched_yield();
+      // Wait some time before starting the next job
+      if(!arguments.nowait && release == NULL && nanosleep(&tp, NULL) != 0){
+        fprintf(stderr, "Nanosleep has been interrupted ...\n");
+      }
+    }while(sampling != NULL && sampling->status == ADAPTIVE_RUNNING);
+    arguments.param = update_parameter_3(arguments.param, arguments.inc);
+  }
+  if(jobs > 0){
+    workload_teardown(job_workload);
+  }
+  close_workload(job_workload);
+  if(counters != NULL){
+    destroy_perf_counters(counters);
+  }
+  if(sampling != NULL){
+    printf("*** Confidence interval REACHED: %d out of %d parameters, in %d jobs\n", n_reached, jobs, job_number);
+    destroy_adaptive_sampling(sampling);
+    if(sampler != light)
+      destroy_light_metrics(sampler);
+  }
+  if(monitor != NULL){
+    destroy_buffer_monitor(monitor);
+  }
+  if(release != NULL){
+    printf("*** Period OVERRUNS: %d out of %d jobs\n", release->n_overruns, release->n_jobs);
+    destroy_periodic_release(release);
+  }
+  if(dl_monitor != NULL){
+    printf("*** Deadline MISSES: %d, runtime OVERRUNS: %d out of %d jobs\n", dl_monitor->n_misses, dl_monitor->n_overruns, dl_monitor->n_jobs);
+    destroy_deadline_monitor(dl_monitor);
+  }
+  // Removing the hist triggers, closing the unprivileged measurement, or disabling the tracing of the sched_switch event
+  if(aggregation != NULL){
+    destroy_hist_aggregation(aggregation);
+  }else if(light != NULL){
+    destroy_light_metrics(light);
+  }else if(session != NULL && worker == 0){
+    event_record_session(session, E_SCHED_SWITCH, DISABLE);
+    if(arguments.latency)
+      event_record_session(session, E_SCHED_WAKEUP, DISABLE);
+  }
+  if(metrics_engine != NULL){
+    destroy_job_metrics_engine(metrics_engine);
+  }
+  // Write the execution informations of all the jobs
+  destroy_exec_logger(logger);
+  // The kernel trace and the tracing infrastructure are left to the parent of the workers
+  if(worker != 0){
+    exit(EXIT_SUCCESS);
+  }
+  // Log the kernel trace, or only its tail if it has been drained while the jobs were running
+  if(stream != NULL){
+    stop_trace_stream(stream);
+  }else if(session != NULL){
+    log_trace_session(session, arguments.respath, execution_info->id, arguments.rawtrace ? USE_TRACE_RAW : USE_TRACE);
+  }
+  // Computing the metrics and the scheduling latency of the jobs and converting the raw traces into the binary container, if requested
+  if(arguments.metrics || arguments.latency || arguments.container){
+    dir_file_path = create_execution_directory(arguments.respath, execution_info->id);
+    if(arguments.metrics)
+      compute_job_metrics(dir_file_path, execution_info->id, NULL);
+    if(arguments.latency)
+      compute_sched_latency(dir_file_path, execution_info->id, pid);
+    if(arguments.container)
+      write_trace_container(dir_file_path, 1);
+    free(dir_file_path);
+  }
+  // Disabling the tracing infrastructure, and removing the private instance if it has been used
+  if(session != NULL){
+    DISABLE_TRACING_SESSION(session);
+    destroy_tracing_session(session);
+  }
+  
+  printf("*** DONE. All has been correctly saved under '%s' path\n", arguments.respath);
+  printf("*** Terminating\n");
+  return 0;
+}
+
+
+/**
+ * @brief It opens the job selected by the WORKLOAD argument, searching it among the built-in jobs and then among the plugins
+ * of the WORKLOADS directory, or the built-in job of the MODE argument. If the workload isn't found, the available ones are
+ * printed and the program is terminated
+ * @param arguments is the structure of the command line arguments
+ * @return a pointer to the workload_module struct of the job
+*/
+workload_module* open_job_workload(struct arguments* arguments){
+  workload_module* module = NULL;
+  char* dir_path;
+
+  if(arguments->workload == NULL)
+    return open_workload(&builtin_workloads[arguments->mode - 1]);
+  dir_path = arguments->workloads != NULL ? strdup(arguments->workloads) : default_workload_dir();
+  module = open_job(arguments->workload, dir_path);
+  if(module == NULL){
+    fprintf(stderr, "Workload '%s' not found. The available workloads are:\n", arguments->workload);
+    list_jobs(dir_path, stderr);
+    exit(EXIT_FAILURE);
+  }
+  free(dir_path);
+  return module;
+}
+
+/**
+ * @brief It reads the metric of the last job whose confidence interval is checked
+ * @param sampler is the structure that measured the job
+ * @param metric is the metric, CI_METRIC_CPU, CI_METRIC_SWITCHES or CI_METRIC_LATENCY
+ * @return the value of the metric
+*/
+double ci_metric_value(light_metrics* sampler, int metric){
+  switch(metric){
+    case CI_METRIC_SWITCHES:
+      return sampler->last_job.num_sched_switches;
+    case CI_METRIC_LATENCY:
+      return sampler->last_run_delay;
+    default:
+      return sampler->last_job.effective_cpu_time;
+  }
+}
+
+/**
+ * @brief It forks the workers, which keep the state of the parent, such as the open tracefs files and loggers
+ * @param n_workers is the number of workers to fork
+ * @param pids is the array where to store the pids of the workers
+ * @param start_fds is the pipe the workers block on in "wait_start()" until the parent closes its write end
+ * @return the number of the worker, from 1 to n_workers, in the workers, and 0 in the parent
+*/
+int fork_workers(int n_workers, pid_t* pids, int* start_fds){
+  if(pipe(start_fds) == -1){
+    fprintf(stderr, "Error creating the pipe of the workers ...\n");
+    PRINT_ERROR;
+    exit(EXIT_FAILURE);
+  }
+  for(int w = 1; w <= n_workers; w++){
+    pids[w-1] = fork();
+    if(pids[w-1] == -1){
+      fprintf(stderr, "Error forking the worker %d ...\n", w);
+      PRINT_ERROR;
+      exit(EXIT_FAILURE);
+    }
+    if(pids[w-1] == 0){
+      close(start_fds[1]);
+      return w;
+    }
+  }
+  close(start_fds[0]);
+  return 0;
+}
+
+/**
+ * @brief It blocks a worker until the parent closes the write end of the pipe
+ * @param start_fds is the pipe created by "fork_workers()"
+*/
+void wait_start(int* start_fds){
+  char c;
+
+  while(read(start_fds[0], &c, 1) == -1 && errno == EINTR);
+  close(start_fds[0]);
+}
+
+/**
+ * @brief It waits for the termination of all the workers
+ * @param n_workers is the number of workers
+ * @param pids is the array of the pids of the workers
+ * @return 0 if all the workers exited successfully, -1 otherwise
+*/
+int wait_workers(int n_workers, pid_t* pids){
+  int status, ret = 0;
+
+  for(int w = 0; w < n_workers; w++){
+    while(waitpid(pids[w], &status, 0) == -1){
+      if(errno != EINTR){
+        fprintf(stderr, "Error waiting for the worker %d ...\n", w+1);
+        PRINT_ERROR;
+        exit(EXIT_FAILURE);
+      }
+    }
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+      ret = -1;
+  }
+  return ret;
+}
+
+/**
+ * @brief It updates the parameter based on the math function provided
+ * @param parameter is the original value
+ * @param i is an integer value used to choose the next value calculated by the math function
+*/
+long update_parameter(long parameter){
+  return (parameter%2 == 0) ? parameter/2 : 3*parameter + 1;
+}
+
+/**
+ * @brief It updates the parameter based on the math function provided
+*/
+long update_parameter_2(){
+  long num;
+  
+  srand(time(NULL));
+  num = (rand() % (MAX_VALUE - MIN_VALUE + 1)) + MIN_VALUE;
+  return num;
+}
+
+/**
+ * @brief It updates the parameter based on the math function provided
+*/
+long update_parameter_3(long parameter, long increase){
+  return parameter + increase;
+}
+
+/**
+ * @brief It updates the parameter based on the math function provided
+*/
+long update_parameter_4(long parameter){
+  return parameter*2;
+}
@@ -0,0 +1,91 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/workload.h"
+
+#define MEMBW_ARRAY_SIZE (32 * 1024 * 1024)	///>Size in bytes of each array, larger than the last level caches.
+#define MEMBW_UNIT_SIZE 1024					///>Bytes of each array streamed for each unit of the parameter.
+#define MEMBW_SCALAR 3.0						///>Scalar of the triad.
+
+/**
+ * @brief The state of the memory bandwidth workload: the three arrays of a STREAM triad and the position where the next job starts.
+*/
+typedef struct membw_state{
+	double* a; ///> The array written by the triad.
+	double* b; ///> The first array read by the triad.
+	double* c; ///> The second array read by the triad.
+	size_t n; ///> The number of elements of each array.
+	size_t pos; ///> The element where the next job starts.
+} membw_state;
+
+/**
+ * @brief Allocates the arrays and writes them once, so that their page faults don't happen during the jobs.
+ * @return A pointer to a newly created membw_state struct.
+*/
+static void* membw_init(void){
+  membw_state* state;
+
+  state = (membw_state*)calloc(1, sizeof(*state));
+  if(state == NULL){
+    fprintf(stderr, "membw_init: error allocating memory. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  state->n = MEMBW_ARRAY_SIZE / sizeof(double);
+  state->a = (double*)malloc(MEMBW_ARRAY_SIZE);
+  state->b = (double*)malloc(MEMBW_ARRAY_SIZE);
+  state->c = (double*)malloc(MEMBW_ARRAY_SIZE);
+  if(state->a == NULL || state->b == NULL || state->c == NULL){
+    fprintf(stderr, "membw_init: error allocating memory. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  for(size_t i = 0; i < state->n; i++){
+    state->a[i] = 0.0;
+    state->b[i] = 1.0;
+    state->c[i] = 2.0;
+  }
+  return state;
+}
+
+/**
+ * @brief Runs the triad a = b + s * c on param * MEMBW_UNIT_SIZE bytes of each array, continuing from where the previous job
+ * stopped, so that each job streams memory that is no longer in the caches.
+ * @param state A pointer to a membw_state struct.
+ * @param param The amount of work of the job.
+*/
+static void membw_run(void* state, long param){
+  membw_state* s = (membw_state*)state;
+  size_t remaining = (size_t)param * (MEMBW_UNIT_SIZE / sizeof(double));
+  size_t len;
+
+  while(remaining > 0){
+    len = s->n - s->pos < remaining ? s->n - s->pos : remaining;
+    for(size_t i = s->pos; i < s->pos + len; i++){
+      s->a[i] = s->b[i] + MEMBW_SCALAR * s->c[i];
+    }
+    s->pos = s->pos + len == s->n ? 0 : s->pos + len;
+    remaining -= len;
+  }
+}
+
+/**
+ * @brief Frees up the arrays.
+ * @param state A pointer to a membw_state struct.
+*/
+static void membw_teardown(void* state){
+  membw_state* s = (membw_state*)state;
+
+  free(s->a);
+  free(s->b);
+  free(s->c);
+  free(s);
+}
+
+const workload workload_plugin = {
+  WORKLOAD_API_VERSION,
+  "MemoryBandwidth",
+  "STREAM triad over arrays larger than the caches, PARAM KB of each array per job",
+  membw_init,
+  membw_run,
+  membw_teardown
+};
@@ -0,0 +1,93 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../include/workload.h"
+
+#define PTRCHASE_NODES (1024 * 1024)	///>Number of nodes of the cycle, one per cache line (64 MB).
+#define PTRCHASE_SEED 1					///>Seed of the permutation, fixed so that all the executions chase the same cycle.
+
+/**
+ * @brief A node of the cycle, as large as a cache line, so that each step touches a different line.
+*/
+typedef struct ptrchase_node{
+	struct ptrchase_node* next; ///> The next node of the cycle.
+	char pad[64 - sizeof(struct ptrchase_node*)]; ///> Padding up to the size of a cache line.
+} ptrchase_node;
+
+/**
+ * @brief The state of the pointer chasing workload: the nodes and the one where the next job starts.
+*/
+typedef struct ptrchase_state{
+	ptrchase_node* nodes; ///> The array of the nodes.
+	ptrchase_node* current; ///> The node where the next job starts.
+} ptrchase_state;
+
+/**
+ * @brief Links the nodes in a single cycle that visits them in random order (Sattolo's algorithm), so that the hardware
+ * prefetchers can't predict the next node.
+ * @return A pointer to a newly created ptrchase_state struct.
+*/
+static void* ptrchase_init(void){
+  ptrchase_state* state;
+  size_t* order;
+  size_t j, tmp;
+  unsigned int seed = PTRCHASE_SEED;
+
+  state = (ptrchase_state*)malloc(sizeof(*state));
+  order = (size_t*)malloc(PTRCHASE_NODES * sizeof(size_t));
+  if(state == NULL || order == NULL || (state->nodes = (ptrchase_node*)aligned_alloc(64, PTRCHASE_NODES * sizeof(ptrchase_node))) == NULL){
+    fprintf(stderr, "ptrchase_init: error allocating memory. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  for(size_t i = 0; i < PTRCHASE_NODES; i++){
+    order[i] = i;
+  }
+  for(size_t i = PTRCHASE_NODES - 1; i > 0; i--){
+    j = (((size_t)rand_r(&seed) << 16) ^ (size_t)rand_r(&seed)) % i;
+    tmp = order[i];
+    order[i] = order[j];
+    order[j] = tmp;
+  }
+  for(size_t i = 0; i < PTRCHASE_NODES; i++){
+    state->nodes[order[i]].next = &state->nodes[order[(i + 1) % PTRCHASE_NODES]];
+  }
+  state->current = &state->nodes[order[0]];
+  free(order);
+  return state;
+}
+
+/**
+ * @brief Follows param pointers of the cycle, each load depending on the previous one, so that the job is bound by the memory
+ * latency. It continues from where the previous job stopped.
+ * @param state A pointer to a ptrchase_state struct.
+ * @param param The number of pointers to follow.
+*/
+static void ptrchase_run(void* state, long param){
+  ptrchase_state* s = (ptrchase_state*)state;
+  ptrchase_node* node = s->current;
+
+  for(long i = 0; i < param; i++){
+    node = node->next;
+  }
+  s->current = node;
+}
+
+/**
+ * @brief Frees up the nodes.
+ * @param state A pointer to a ptrchase_state struct.
+*/
+static void ptrchase_teardown(void* state){
+  ptrchase_state* s = (ptrchase_state*)state;
+
+  free(s->nodes);
+  free(s);
+}
+
+const workload workload_plugin = {
+  WORKLOAD_API_VERSION,
+  "PointerChasing",
+  "Dependent loads along a random cycle of 64 MB, PARAM loads per job",
+  ptrchase_init,
+  ptrchase_run,
+  ptrchase_teardown
+};
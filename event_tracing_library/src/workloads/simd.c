@@ -0,0 +1,76 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../include/workload.h"
+
+#define SIMD_VECTORS 64	///>Number of vectors of each array, small enough to stay in the L1 cache.
+#define SIMD_LANES 8	///>Number of floats of each vector.
+
+/**
+ * @brief A vector of SIMD_LANES floats. The GCC vector extensions are compiled to the SIMD instructions of the target (SSE, AVX
+ * or NEON), without depending on the intrinsics of a single architecture.
+*/
+typedef float simd_vector __attribute__((vector_size(SIMD_LANES * sizeof(float))));
+
+/**
+ * @brief The state of the SIMD workload: the arrays of the multiply-add x = x * a + b.
+*/
+typedef struct simd_state{
+	simd_vector x[SIMD_VECTORS]; ///> The array updated by the jobs.
+	simd_vector a[SIMD_VECTORS]; ///> The multipliers.
+	simd_vector b[SIMD_VECTORS]; ///> The addends.
+} simd_state;
+
+/**
+ * @brief Fills the arrays so that x converges to 1, never reaching the slow denormal or infinite values.
+ * @return A pointer to a newly created simd_state struct.
+*/
+static void* simd_init(void){
+  simd_state* state;
+
+  state = (simd_state*)aligned_alloc(64, sizeof(simd_state));
+  if(state == NULL){
+    fprintf(stderr, "simd_init: error allocating memory. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  for(int i = 0; i < SIMD_VECTORS; i++){
+    for(int j = 0; j < SIMD_LANES; j++){
+      state->x[i][j] = 0.0f;
+      state->a[i][j] = 0.999f;
+      state->b[i][j] = 0.001f;
+    }
+  }
+  return state;
+}
+
+/**
+ * @brief Runs the multiply-add on all the vectors param times, so that the job is bound by the SIMD units of the CPU.
+ * @param state A pointer to a simd_state struct.
+ * @param param The number of passes over the arrays.
+*/
+static void simd_run(void* state, long param){
+  simd_state* s = (simd_state*)state;
+
+  for(long i = 0; i < param; i++){
+    for(int j = 0; j < SIMD_VECTORS; j++){
+      s->x[j] = s->x[j] * s->a[j] + s->b[j];
+    }
+  }
+}
+
+/**
+ * @brief Frees up the arrays.
+ * @param state A pointer to a simd_state struct.
+*/
+static void simd_teardown(void* state){
+  free(state);
+}
+
+const workload workload_plugin = {
+  WORKLOAD_API_VERSION,
+  "SimdCompute",
+  "Multiply-add on vectors of 8 floats held in the L1 cache, PARAM passes of 64 vectors per job",
+  simd_init,
+  simd_run,
+  simd_teardown
+};
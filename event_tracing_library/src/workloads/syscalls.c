@@ -0,0 +1,77 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../../include/workload.h"
+
+#define SYSCALLS_IO_SIZE 64	///>Bytes read from /dev/zero and written to /dev/null by each unit of the parameter.
+
+/**
+ * @brief The state of the system call workload: the files used by the jobs.
+*/
+typedef struct syscalls_state{
+	int zero_fd; ///> The file descriptor of /dev/zero.
+	int null_fd; ///> The file descriptor of /dev/null.
+} syscalls_state;
+
+/**
+ * @brief Opens the files used by the jobs.
+ * @return A pointer to a newly created syscalls_state struct.
+*/
+static void* syscalls_init(void){
+  syscalls_state* state;
+
+  state = (syscalls_state*)malloc(sizeof(*state));
+  if(state == NULL){
+    fprintf(stderr, "syscalls_init: error allocating memory. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  state->zero_fd = open("/dev/zero", O_RDONLY);
+  state->null_fd = open("/dev/null", O_WRONLY);
+  if(state->zero_fd == -1 || state->null_fd == -1){
+    fprintf(stderr, "syscalls_init: error opening \"/dev/zero\" and \"/dev/null\" files. Aborting ...\n");
+    exit(EXIT_FAILURE);
+  }
+  return state;
+}
+
+/**
+ * @brief Makes three system calls for each unit of the parameter (getppid(), a read from /dev/zero and a write to /dev/null),
+ * so that the job spends most of its time entering and leaving the kernel.
+ * @param state A pointer to a syscalls_state struct.
+ * @param param The number of units of work.
+*/
+static void syscalls_run(void* state, long param){
+  syscalls_state* s = (syscalls_state*)state;
+  char buffer[SYSCALLS_IO_SIZE];
+
+  for(long i = 0; i < param; i++){
+    getppid();
+    if(read(s->zero_fd, buffer, sizeof(buffer)) == -1 || write(s->null_fd, buffer, sizeof(buffer)) == -1){
+      fprintf(stderr, "syscalls_run: error reading or writing the files. Aborting ...\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+/**
+ * @brief Closes the files.
+ * @param state A pointer to a syscalls_state struct.
+*/
+static void syscalls_teardown(void* state){
+  syscalls_state* s = (syscalls_state*)state;
+
+  close(s->zero_fd);
+  close(s->null_fd);
+  free(s);
+}
+
+const workload workload_plugin = {
+  WORKLOAD_API_VERSION,
+  "SyscallHeavy",
+  "getppid(), read() of /dev/zero and write() of /dev/null, PARAM times per job",
+  syscalls_init,
+  syscalls_run,
+  syscalls_teardown
+};
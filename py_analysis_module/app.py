@@ -59,6 +59,24 @@ def main():
                         help="a flag which if specified allows to delete the plots, related to the dataset, "
                              "previously created. (default: False)",
                         required=False)
+    parser.add_argument("-v", "--validate",
+                        action="store_true",
+                        help="a flag which if specified allows to compare the job metrics computed by the C library "
+                             "(metrics.txt files) with the ones computed by this module on the kernel traces. "
+                             "(default: False)",
+                        required=False)
+    parser.add_argument("-t", "--latency",
+                        action="store_true",
+                        help="a flag which if specified allows to print the percentiles of the wakeup-to-run scheduling "
+                             "latency of each scheduling policy and priority, merging the latency histograms of the "
+                             "executions traced with the --latency option of the C library. (default: False)",
+                        required=False)
+    parser.add_argument("-w", "--workers",
+                        action="store_true",
+                        help="a flag which if specified allows to print, for each worker of the executions run with the "
+                             "--workers option of the C library, its policy and priority along with the mean CPU times and "
+                             "the sched switches, preemptions and migrations of its jobs. (default: False)",
+                        required=False)
     args = parser.parse_args()
     if args.delcsv and os.path.isfile(args.csvpath):
         print("*** Deleting the dataset previously created ...")
@@ -74,6 +92,32 @@ def main():
     print("*** Updating the dataset ...", end='')
     ta.update_data(df=df, dir_result_path=args.respath, process_name=args.name)
     print("DONE")
+    if "lost_events" in df.columns:
+        lost_jobs = df[df["lost_events"].fillna(0) > 0]
+        if not lost_jobs.empty:
+            print(f"*** Warning: {len(lost_jobs)} jobs lost events in the ring buffer, their metrics are not reliable:")
+            print(lost_jobs[["id", "job_number", "lost_events", "lost_cpu_mask"]].to_string(index=False))
+
+    if args.validate:
+        print("*** Validating the job metrics computed by the C library ...", end='')
+        mismatches = ta.validate_job_metrics(dir_result_path=args.respath, process_name=args.name)
+        print("DONE" if mismatches.empty else f"FOUND {len(mismatches)} MISMATCHES")
+        if not mismatches.empty:
+            print(mismatches.to_string(index=False))
+
+    if args.latency:
+        print("*** Summarizing the scheduling latency (nsec) ...", end='')
+        latency_summary = ta.summarize_sched_latency(dir_result_path=args.respath)
+        print("DONE")
+        if not latency_summary.empty:
+            print(latency_summary.to_string(index=False))
+
+    if args.workers:
+        print("*** Summarizing the concurrent workers ...", end='')
+        workers_summary = ta.summarize_workers(df)
+        print("DONE")
+        if not workers_summary.empty:
+            print(workers_summary.to_string(index=False))
 
     if args.savecsv:
         print("*** Saving the dataset ...", end='')
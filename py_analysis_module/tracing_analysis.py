@@ -5,7 +5,8 @@ import decimal as dc
 import matplotlib.pyplot as plt
 import seaborn as sns
 import re
-from typing import Callable, Any, TextIO, List, Tuple
+import struct
+from typing import Callable, Any, TextIO, List, Tuple, Dict
 from datetime import datetime
 
 
@@ -33,10 +34,12 @@ from datetime import datetime
 #   Group 4: Flags
 #   Group 5: Timestamp
 #   Group 6: Start or End signal
-#   Group 7: Job number
+#   Group 7: Worker number, only in the markers of the concurrent workers ("start_job=<worker>:<job>")
+#   Group 8: Job number
 
-TRACE_LINE_PATTERN = r'([A-Za-z_<>./:0-9-]+)-(\d+)\s+(\[\d+\])\s+([A-Za-z0-9\.]+)\s+(\d+\.\d+):\s+sched_switch:\sprev_comm=([A-Za-z_<>.:\s/0-9-]+)\sprev_pid=(\d+)\sprev_prio=(\d+)\sprev_state=[A-Z]\s==>\snext_comm=([A-Za-z_<>.:\s/0-9-]+)\snext_pid=(\d+)\snext_prio=(\d+)'
-TRACE_JOB_LINE_PATTERN = r'(test_app|[<>.]+)-(\d+)\s+(\[\d+\])\s+([A-Za-z0-9\.]+)\s+(\d+\.\d+):\s+tracing_mark_write:\s(start|end)_job=([0-9]+)'
+TRACE_LINE_PATTERN = r'([A-Za-z_<>./:0-9-]+)-(\d+)\s+(\[\d+\])\s+([A-Za-z0-9\.]+)\s+(\d+\.\d+):\s+sched_switch:\sprev_comm=([A-Za-z_<>.:\s/0-9-]+)\sprev_pid=(\d+)\sprev_prio=(\d+)\sprev_state=([A-Za-z+|]+)\s==>\snext_comm=([A-Za-z_<>.:\s/0-9-]+)\snext_pid=(\d+)\snext_prio=(\d+)'
+TRACE_JOB_LINE_PATTERN = r'(test_app|[<>.]+)-(\d+)\s+(\[\d+\])\s+([A-Za-z0-9\.]+)\s+(\d+\.\d+):\s+tracing_mark_write:\s(start|end)_job=(?:([0-9]+):)?([0-9]+)'
+TRACE_RAW_JOB_LINE_PATTERN = r'(test_app|[<>.]+)-(\d+)\s+(\[\d+\])\s+([A-Za-z0-9\.]+)\s+(\d+\.\d+):\s+#\s([0-9a-f]+)\sbuf:((?:\s[0-9a-f]{2})+)'
 JOB_GROUP_MATCHER = {
     "name": 1,
     "pid": 2,
@@ -44,7 +47,17 @@ JOB_GROUP_MATCHER = {
     "flags": 4,
     "timestamp": 5,
     "job_state": 6,
-    "job_number": 7
+    "worker": 7,
+    "job_number": 8
+}
+RAW_JOB_GROUP_MATCHER = {
+    "name": 1,
+    "pid": 2,
+    "cpu_core": 3,
+    "flags": 4,
+    "timestamp": 5,
+    "marker_id": 6,
+    "marker_buf": 7
 }
 LINE_GROUP_MATCHER = {
     "name": 1,
@@ -60,6 +73,41 @@ LINE_GROUP_MATCHER = {
     "next_pid": 11,
     "next_prio": 12
 }
+# Layout of the raw_job_marker struct written by the trace_mark_job_raw_session() function of the C library to the
+# trace_marker_raw file: id (u32), job_number (s32), state (u32), worker (u32), payload (s64), little-endian.
+# In the text kernel trace the id is printed after the '#' character and the remaining bytes after 'buf:'.
+RAW_JOB_MARKER_FORMAT = "<IiIIq"
+RAW_JOB_MARKER_ID = 0x4a4f4221
+RAW_JOB_MARKER_STATES = {1: "start", 0: "end"}
+# Layout of the binary trace container ("trace.bin") written by the write_trace_container() function of the C library,
+# little-endian: a header, fixed-width records with timestamps delta-encoded from the previous record, the table of the
+# interned command names, the job index and a trailer. See the "trace_container.h" file for the meaning of every field.
+CONTAINER_FILENAME = "trace.bin"
+CONTAINER_MAGIC = b"ETRCBIN1"
+CONTAINER_HEADER_FORMAT = "<8sIIQ"
+CONTAINER_SWITCH_FORMAT = "<IBBBBiiHHI"
+CONTAINER_MARKER_FORMAT = "<IBBHiiq"
+CONTAINER_INDEX_FORMAT = "<iIQQQ"
+CONTAINER_TRAILER_FORMAT = "<QQII8s"
+CONTAINER_COMM_LEN = 16
+CONTAINER_RECORD_TYPES = {1: "sched_switch", 2: "start", 3: "end", 4: "time"}
+# Lines of the "metrics.txt" file written by the C library when it computes the default analysis by itself:
+# id, job_number, effective_cpu_time, total_cpu_time, diff_cpu_time, num_sched_switches, num_migrations, followed by the
+# worker that ran the job when the jobs are run by concurrent workers.
+METRICS_FILENAME = "metrics.txt"
+# Layout of the exec_info_record struct written by the exec_logger of the C library to the "exec.bin" file: id, job_number,
+# sched_priority, parameter, sched_policy, details, number of metrics, little-endian with zero-padded strings. Each record is
+# followed by its exec_metric_record structs: name, value.
+EXEC_BINARY_FILENAME = "exec.bin"
+EXEC_RECORD_FORMAT = "<24siiq16s32sII"
+EXEC_METRIC_FORMAT = "<24sq"
+# Lines of the "latency.txt" file written by the C library with the wakeup-to-run scheduling latency of each job, in nanoseconds:
+# id, job_number, number of wakeups, p50, p99, p99.9, max. The "latency_hist.txt" file contains the non-empty buckets of the
+# log-linear histogram of all the jobs of an execution: lowest value, highest value, count.
+LATENCY_FILENAME = "latency.txt"
+LATENCY_HIST_FILENAME = "latency_hist.txt"
+LATENCY_COLUMNS = ["id", "job_number", "sched_latency_count", "sched_latency_p50", "sched_latency_p99", "sched_latency_p999", "sched_latency_max"]
+METRICS_COLUMNS = ["id", "job_number", "effective_cpu_time", "total_cpu_time", "diff_cpu_time", "num_sched_switches", "num_migrations"]
 COLUMNS = ["id", "effective_cpu_time", "total_cpu_time", "diff_cpu_time", "num_sched_switches", "num_migrations", "parameter", "job_number", "mode", "sched_policy", "sched_priority"]
 
 
@@ -149,10 +197,14 @@ def update_data(df: pd.DataFrame, dir_result_path: str, process_name: str, trace
         subfolder must contain the kernel trace file of the execution called as specified by the `trace_filename` parameter
         and a file with the jobs details of that execution called as specified by the `execution_filename` parameter.
         process_name (str): The name of the process within the kernel trace that we want to analyze.
-        trace_filename (str, optional): The name of the kernel trace file. Default is "trace.txt".
+        trace_filename (str, optional): The name of the kernel trace file. Default is "trace.txt". If this file doesn't
+        exist, a binary trace container called "trace.bin" is analyzed instead, only when the DataFrame has the default columns.
+        When the DataFrame has the default columns and the C library already computed the metrics of the jobs in the
+        "metrics.txt" file, that file is loaded and the kernel trace isn't analyzed at all.
         execution_filename (str, optional): The name of the file that contains all the job details related to the kernel
         trace file, line by line for each job that occurred during the execution. These job details are some values that
-        will be stored in the corresponding columns of the new DataFrame records. Default is "exec.txt".
+        will be stored in the corresponding columns of the new DataFrame records. Default is "exec.txt". If the default
+        file doesn't exist, the fixed-width binary records of the "exec.bin" file are read instead.
         execution_data (List[str], optional): A list of strings containing the names, in the corresponding order, of the
         columns in the DataFrame that refer to a line in the 'execution_filename' file. For example assume we have a DataFrame
         with the columns ["A", "B", "C", "D"] and the 'execution_filename' contains lines like this one <abc, xyz, 1>.
@@ -175,18 +227,25 @@ def update_data(df: pd.DataFrame, dir_result_path: str, process_name: str, trace
         Therefore, this function will update the DataFrame with new data records regarding executions times and scheduling
         information of jobs whose start and end are marked on the kernel trace.
     """
-    is_default_dataframe = all(column in df.columns for column in COLUMNS) and len(df.columns) == len(COLUMNS)
+    # The default columns may be followed by the extra metrics of the jobs ("name=value" fields of the execution information)
+    is_default_dataframe = list(df.columns[:len(COLUMNS)]) == COLUMNS
     if os.path.exists(dir_result_path):
         for dir_name in os.listdir(dir_result_path):
             if not df["id"].isin([dir_name]).any():
                 try:
                     execution_file_path = os.path.join(dir_result_path, dir_name, execution_filename)
+                    if not os.path.exists(execution_file_path) and execution_filename == "exec.txt":
+                        execution_file_path = os.path.join(dir_result_path, dir_name, EXEC_BINARY_FILENAME)
                     trace_file_path = os.path.join(dir_result_path, dir_name, trace_filename)
-                    if os.path.exists(execution_file_path) and os.path.exists(trace_file_path):
-                        with open(execution_file_path, "r") as execution_file:
+                    container_file_path = os.path.join(dir_result_path, dir_name, CONTAINER_FILENAME)
+                    metrics_file_path = os.path.join(dir_result_path, dir_name, METRICS_FILENAME)
+                    use_metrics = is_default_dataframe and os.path.exists(metrics_file_path)
+                    use_container = is_default_dataframe and not os.path.exists(trace_file_path) and os.path.exists(container_file_path)
+                    if os.path.exists(execution_file_path) and (os.path.exists(trace_file_path) or use_container or use_metrics):
+                        with open(execution_file_path, "rb") as execution_file:
+                            execution_records = read_execution_records(execution_file.read(), binary=execution_file_path.endswith(EXEC_BINARY_FILENAME))
                             if not is_default_dataframe and execution_data is not None:
-                                for execution_line in execution_file:
-                                    execution_data_values = [data.strip() for data in execution_line.split(",")]
+                                for execution_data_values in execution_records:
                                     row = {}
                                     for index, column_name in enumerate(execution_data):
                                         row[column_name] = execution_data_values[index]
@@ -198,8 +257,7 @@ def update_data(df: pd.DataFrame, dir_result_path: str, process_name: str, trace
                                       f"since the DataFrame columns are not the default ones. Terminating.")
                                 exit(1)
                             else:
-                                for execution_line in execution_file:
-                                    execution_data_values = [data.strip() for data in execution_line.split(",")]
+                                for execution_data_values in execution_records:
                                     id = execution_data_values[0]
                                     job_number = int(execution_data_values[1])
                                     parameter = int(execution_data_values[2])
@@ -207,7 +265,20 @@ def update_data(df: pd.DataFrame, dir_result_path: str, process_name: str, trace
                                     sched_priority = int(execution_data_values[4])
                                     details = execution_data_values[5]
                                     row = {"id": id, "parameter": parameter, "job_number": job_number, "mode": details, "sched_policy": sched_policy, "sched_priority": sched_priority}
+                                    for name, value in read_execution_metrics(execution_data_values).items():
+                                        if name not in df.columns:
+                                            df[name] = None
+                                        row[name] = value
                                     df.loc[len(df)] = row
+                        latency_file_path = os.path.join(dir_result_path, dir_name, LATENCY_FILENAME)
+                        if is_default_dataframe and os.path.exists(latency_file_path):
+                            load_sched_latency(df=df, identifier=dir_name, latency_path=latency_file_path)
+                        if use_metrics:
+                            load_job_metrics(df=df, identifier=dir_name, metrics_path=metrics_file_path)
+                            continue
+                        if use_container:
+                            analyze_trace_container(df=df, identifier=dir_name, container_path=container_file_path, process_name=process_name)
+                            continue
                         with open(trace_file_path) as trace_file:
                             if is_default_dataframe:
                                 analyze_trace(df=df, identifier=dir_name, trace_file=trace_file, process_name=process_name)
@@ -230,6 +301,393 @@ def update_data(df: pd.DataFrame, dir_result_path: str, process_name: str, trace
         exit(1)
 
 
+def read_execution_records(data: bytes, binary: bool = False) -> List[List[str]]:
+    """
+    Splits the content of an execution information file into the values of each job, as strings.
+
+    Parameters:
+        data (bytes): The content of the file.
+        binary (bool, optional): True if the content is made of the exec_info_record structs written by the exec_logger of
+        the C library ("exec.bin" file), False if it is made of comma separated lines ("exec.txt" file). Default is False.
+
+    Returns:
+        List[List[str]]: A list containing, for each job, the list of its values in the order they are written in the
+        "exec.txt" file: id, job_number, parameter, sched_policy, sched_priority, details, followed by the extra metrics
+        as "name=value" strings.
+    """
+    if not binary:
+        return [[value.strip() for value in line.split(",")] for line in data.decode().splitlines() if line.strip()]
+    records = []
+    record_size = struct.calcsize(EXEC_RECORD_FORMAT)
+    metric_size = struct.calcsize(EXEC_METRIC_FORMAT)
+    offset = 0
+    while offset + record_size <= len(data):
+        id, job_number, sched_priority, parameter, sched_policy, details, n_metrics, _ = struct.unpack_from(EXEC_RECORD_FORMAT, data, offset)
+        offset += record_size
+        if offset + n_metrics * metric_size > len(data):
+            break
+        record = [id.split(b"\0", 1)[0].decode(), str(job_number), str(parameter), sched_policy.split(b"\0", 1)[0].decode(),
+                  str(sched_priority), details.split(b"\0", 1)[0].decode() or "No details"]
+        for name, value in struct.iter_unpack(EXEC_METRIC_FORMAT, data[offset:offset + n_metrics * metric_size]):
+            record.append(name.split(b"\0", 1)[0].decode() + "=" + str(value))
+        offset += n_metrics * metric_size
+        records.append(record)
+    return records
+
+
+def read_execution_metrics(values: List[str]) -> Dict[str, int]:
+    """
+    Extracts the extra metrics of a job, such as the perf_event counters, from the values returned by
+    'read_execution_records()'.
+
+    Parameters:
+        values (List[str]): The values of a job.
+
+    Returns:
+        Dict[str, int]: A dictionary that maps the name of each metric to its value, in the order they are written.
+    """
+    metrics = {}
+    for value in values[6:]:
+        name, separator, number = value.partition("=")
+        if separator:
+            metrics[name.strip()] = int(number)
+    return metrics
+
+
+def update_job_record(df: pd.DataFrame, identifier: str, job_number: int, effective_cpu_time: dc.Decimal, total_cpu_time: dc.Decimal, sched_switches_count: int, migrations_count: int, worker: int = None, preemptions_count: int = None):
+    """
+    Updates the record of a job in a DataFrame with the default columns with the values computed by the default analysis,
+    or appends a new record if the job isn't present yet.
+
+    Parameters:
+        df (pandas.DataFrame): The DataFrame to update.
+        identifier (str): The execution identifier of the job.
+        job_number (int): The number of the job.
+        effective_cpu_time (decimal.Decimal): The time in seconds the job actually spent running.
+        total_cpu_time (decimal.Decimal): The time in seconds elapsed between the start and the end of the job.
+        sched_switches_count (int): The number of times the job left the CPU.
+        migrations_count (int): The number of times the job changed CPU.
+        worker (int, optional): The worker that ran the job, when the jobs are run by concurrent workers. The job is
+        matched on the "worker" column too, which is created if needed. Default is None.
+        preemptions_count (int, optional): The number of times the job left the CPU while it was still runnable, stored
+        in the "num_preemptions" column, which is created if needed. Default is None.
+
+    Returns:
+        None
+    """
+    condition = (df["id"] == identifier) & (df["job_number"] == job_number)
+    if worker is not None:
+        if "worker" not in df.columns:
+            df["worker"] = None
+        condition &= df["worker"] == worker
+    new_values = {
+        "effective_cpu_time": float(effective_cpu_time.quantize(dc.Decimal('0.000001'))),
+        "total_cpu_time": float(total_cpu_time.quantize(dc.Decimal('0.000001'))),
+        "diff_cpu_time": float(total_cpu_time.quantize(dc.Decimal('0.000001')) - effective_cpu_time.quantize(dc.Decimal('0.000001'))),
+        "num_sched_switches": sched_switches_count,
+        "num_migrations": migrations_count
+    }
+    if preemptions_count is not None:
+        if "num_preemptions" not in df.columns:
+            df["num_preemptions"] = None
+        new_values["num_preemptions"] = preemptions_count
+    if condition.any():
+        df.loc[condition, new_values.keys()] = new_values.values()
+    else:
+        new_values["id"] = identifier
+        new_values["parameter"] = np.NaN
+        new_values["job_number"] = job_number
+        new_values["mode"] = np.NaN
+        new_values["sched_policy"] = np.NaN
+        new_values["sched_priority"] = np.NaN
+        if worker is not None:
+            new_values["worker"] = worker
+        df.loc[len(df)] = new_values
+
+
+def read_trace_container(container_path: str) -> Tuple[List[str], dict, bytes]:
+    """
+    Loads a binary trace container written by the write_trace_container() function of the C library.
+
+    Parameters:
+        container_path (str): The path to the container file.
+
+    Returns:
+        Tuple[List[str], dict, bytes]: A tuple containing the table of the interned command names, the job index, which
+        maps each job number to a tuple (start_offset, end_offset, base_timestamp), and the whole content of the file.
+        The offsets of the index refer to this content.
+
+    Raises:
+        ValueError: If the file isn't a valid trace container.
+    """
+    with open(container_path, "rb") as container_file:
+        data = container_file.read()
+    header_size = struct.calcsize(CONTAINER_HEADER_FORMAT)
+    trailer_size = struct.calcsize(CONTAINER_TRAILER_FORMAT)
+    if len(data) < header_size + trailer_size:
+        raise ValueError(f"\"{container_path}\" is not a valid trace container")
+    magic, record_size, _, _ = struct.unpack_from(CONTAINER_HEADER_FORMAT, data, 0)
+    comms_offset, index_offset, n_comms, n_jobs, trailer_magic = struct.unpack_from(CONTAINER_TRAILER_FORMAT, data, len(data) - trailer_size)
+    if magic != CONTAINER_MAGIC or trailer_magic != CONTAINER_MAGIC or record_size != struct.calcsize(CONTAINER_SWITCH_FORMAT):
+        raise ValueError(f"\"{container_path}\" is not a valid trace container")
+    comms = [data[comms_offset + i * CONTAINER_COMM_LEN:comms_offset + (i + 1) * CONTAINER_COMM_LEN].split(b"\0", 1)[0].decode(errors="replace") for i in range(n_comms)]
+    index = {}
+    for job_number, _, start_offset, end_offset, base_timestamp in struct.iter_unpack(CONTAINER_INDEX_FORMAT, data[index_offset:index_offset + n_jobs * struct.calcsize(CONTAINER_INDEX_FORMAT)]):
+        index[job_number] = (start_offset, end_offset, base_timestamp)
+    return comms, index, data
+
+
+def analyze_trace_container(df: pd.DataFrame, identifier: str, container_path: str, process_name: str):
+    """
+    Performs the same default analysis of the analyze_trace() function on a binary trace container, without any regular
+    expression: the job index of the container is used to jump straight to the records of each job.
+
+    Parameters:
+        df (pandas.DataFrame): The DataFrame with the default columns to update with the kernel trace information.
+        identifier (str): The execution identifier used to match and update records in the DataFrame. It must be the same
+        as the name of the directory in which the container is contained.
+        container_path (str): The path to the container file.
+        process_name (str): The name of the process to analyze within the kernel trace.
+
+    Returns:
+        None
+    """
+    dc.getcontext().prec = 20
+    comms, index, data = read_trace_container(container_path)
+    record_size = struct.calcsize(CONTAINER_SWITCH_FORMAT)
+    nanoseconds = dc.Decimal(1000000000)
+
+    for job_number, (start_offset, end_offset, base_timestamp) in index.items():
+        timestamp = base_timestamp
+        start_timestamp = previous_timestamp = None
+        previous_core = None
+        effective_cpu_time = 0
+        sched_switches_count = 0
+        migrations_count = 0
+        for offset in range(start_offset, end_offset, record_size):
+            delta, record_type, cpu = struct.unpack_from("<IBB", data, offset)
+            if CONTAINER_RECORD_TYPES.get(record_type) == "time":
+                timestamp = struct.unpack_from(CONTAINER_MARKER_FORMAT, data, offset)[6]
+                continue
+            timestamp += delta
+            if CONTAINER_RECORD_TYPES.get(record_type) == "start":
+                start_timestamp = previous_timestamp = timestamp
+                previous_core = cpu
+            elif CONTAINER_RECORD_TYPES.get(record_type) == "sched_switch" and start_timestamp is not None:
+                prev_comm = struct.unpack_from(CONTAINER_SWITCH_FORMAT, data, offset)[7]
+                if prev_comm < len(comms) and comms[prev_comm] == process_name:
+                    if previous_core != cpu:
+                        migrations_count += 1
+                        previous_core = cpu
+                    sched_switches_count += 1
+                    effective_cpu_time += timestamp - previous_timestamp
+                previous_timestamp = timestamp
+        if start_timestamp is None:
+            continue
+        total_cpu_time = timestamp - start_timestamp
+        effective_cpu_time = total_cpu_time if effective_cpu_time == 0 else effective_cpu_time + (timestamp - previous_timestamp)
+        update_job_record(df, identifier, job_number, dc.Decimal(effective_cpu_time) / nanoseconds, dc.Decimal(total_cpu_time) / nanoseconds, sched_switches_count, migrations_count)
+
+
+def load_job_metrics(df: pd.DataFrame, identifier: str, metrics_path: str):
+    """
+    Updates the job records of a DataFrame with the default columns using the metrics computed by the C library while it
+    consumed the kernel trace, instead of analyzing the kernel trace.
+
+    Parameters:
+        df (pandas.DataFrame): The DataFrame with the default columns to update.
+        identifier (str): The execution identifier of the jobs. It must be the same as the name of the directory in which
+        the metrics file is contained.
+        metrics_path (str): The path to the "metrics.txt" file.
+
+    Returns:
+        None
+    """
+    with open(metrics_path, "r") as metrics_file:
+        for metrics_line in metrics_file:
+            values = [value.strip() for value in metrics_line.split(",")]
+            if len(values) != len(METRICS_COLUMNS) and len(values) != len(METRICS_COLUMNS) + 1:
+                continue
+            worker = int(values[7]) if len(values) > len(METRICS_COLUMNS) else None
+            update_job_record(df, identifier, int(values[1]), dc.Decimal(values[2]), dc.Decimal(values[3]), int(values[5]), int(values[6]), worker=worker)
+
+
+def load_sched_latency(df: pd.DataFrame, identifier: str, latency_path: str):
+    """
+    Adds the wakeup-to-run scheduling latency computed by the C library to the job records of a DataFrame, creating the
+    "sched_latency_*" columns if needed. The latencies are expressed in nanoseconds.
+
+    Parameters:
+        df (pandas.DataFrame): The DataFrame whose job records must be updated.
+        identifier (str): The execution identifier of the jobs. It must be the same as the name of the directory in which
+        the latency file is contained.
+        latency_path (str): The path to the "latency.txt" file.
+
+    Returns:
+        None
+    """
+    for column in LATENCY_COLUMNS[2:]:
+        if column not in df.columns:
+            df[column] = None
+    with open(latency_path, "r") as latency_file:
+        for latency_line in latency_file:
+            values = [value.strip() for value in latency_line.split(",")]
+            if len(values) != len(LATENCY_COLUMNS):
+                continue
+            job_filter = (df["id"] == identifier) & (df["job_number"] == int(values[1]))
+            for index, column in enumerate(LATENCY_COLUMNS[2:], start=2):
+                df.loc[job_filter, column] = int(values[index])
+
+
+def summarize_sched_latency(dir_result_path: str, percentiles: Tuple[float, ...] = (50, 99, 99.9)) -> pd.DataFrame:
+    """
+    Merges the scheduling latency histograms ("latency_hist.txt" files) of all the executions with the same scheduling policy
+    and priority, and computes their percentiles. Merging the histograms, instead of averaging the percentiles of the jobs,
+    keeps the tail of the distribution exact up to the width of a bucket.
+
+    Parameters:
+        dir_result_path (str): The path to the directory that contains a subfolder for each execution.
+        percentiles (Tuple[float, ...], optional): The percentiles to compute. Default is (50, 99, 99.9).
+
+    Returns:
+        pandas.DataFrame: A DataFrame with a record for each policy and priority, containing the number of wakeups, the
+        requested percentiles and the max latency in nanoseconds. Each percentile is the highest value of the bucket that
+        contains it.
+    """
+    histograms = {}
+    max_latencies = {}
+    for dir_name in sorted(os.listdir(dir_result_path)):
+        hist_file_path = os.path.join(dir_result_path, dir_name, LATENCY_HIST_FILENAME)
+        execution_file_path = os.path.join(dir_result_path, dir_name, "exec.txt")
+        binary = not os.path.exists(execution_file_path)
+        if binary:
+            execution_file_path = os.path.join(dir_result_path, dir_name, EXEC_BINARY_FILENAME)
+        if not os.path.exists(hist_file_path) or not os.path.exists(execution_file_path):
+            continue
+        with open(execution_file_path, "rb") as execution_file:
+            records = read_execution_records(execution_file.read(), binary=binary)
+        if not records:
+            continue
+        key = (records[0][3], int(records[0][4]))
+        buckets = histograms.setdefault(key, {})
+        with open(hist_file_path, "r") as hist_file:
+            for hist_line in hist_file:
+                values = [int(value) for value in hist_line.split(",")]
+                if len(values) == 3:
+                    buckets[(values[0], values[1])] = buckets.get((values[0], values[1]), 0) + values[2]
+        latency_file_path = os.path.join(dir_result_path, dir_name, LATENCY_FILENAME)
+        if os.path.exists(latency_file_path):
+            with open(latency_file_path, "r") as latency_file:
+                for latency_line in latency_file:
+                    values = [value.strip() for value in latency_line.split(",")]
+                    if len(values) == len(LATENCY_COLUMNS):
+                        max_latencies[key] = max(max_latencies.get(key, 0), int(values[-1]))
+    columns = ["sched_policy", "sched_priority", "sched_latency_count"] + [f"sched_latency_p{str(p).replace('.', '')}" for p in percentiles] + ["sched_latency_max"]
+    summary = pd.DataFrame(columns=columns)
+    for (sched_policy, sched_priority), buckets in sorted(histograms.items()):
+        ordered = sorted(buckets.items())
+        count = sum(bucket_count for _, bucket_count in ordered)
+        row = [sched_policy, sched_priority, count]
+        for percentile in percentiles:
+            rank, seen = max(1, int(np.ceil(percentile / 100 * count))), 0
+            for (_, upper), bucket_count in ordered:
+                seen += bucket_count
+                if seen >= rank:
+                    row.append(min(upper, max_latencies.get((sched_policy, sched_priority), upper)))
+                    break
+        row.append(max_latencies.get((sched_policy, sched_priority), 0))
+        summary.loc[len(summary)] = row
+    return summary
+
+
+def summarize_workers(df: pd.DataFrame) -> pd.DataFrame:
+    """
+    Summarizes the jobs run by the concurrent workers of each execution (the --workers option of the C library), showing
+    how the jobs of each scheduling policy and priority fared while they competed for the CPUs.
+
+    Parameters:
+        df (pandas.DataFrame): A DataFrame with the default columns, updated with the 'update_data()' function.
+
+    Returns:
+        pandas.DataFrame: A DataFrame with a record for each worker of each execution, containing its scheduling policy and
+        priority, the number of its jobs, the mean effective and total CPU time of its jobs, and the total number of sched
+        switches, preemptions (if computed) and migrations of its jobs. It is empty if no job has been run by a worker.
+    """
+    if "worker" not in df.columns:
+        return pd.DataFrame()
+    workers_df = df[df["worker"].notna()].copy()
+    if workers_df.empty:
+        return pd.DataFrame()
+    workers_df["worker"] = workers_df["worker"].astype(int)
+    aggregations = {"job_number": "count", "effective_cpu_time": "mean", "total_cpu_time": "mean", "num_sched_switches": "sum"}
+    if "num_preemptions" in workers_df.columns:
+        aggregations["num_preemptions"] = "sum"
+    aggregations["num_migrations"] = "sum"
+    summary = workers_df.groupby(["id", "worker", "sched_policy", "sched_priority"], as_index=False).agg(aggregations)
+    return summary.rename(columns={"job_number": "jobs"})
+
+
+def validate_job_metrics(dir_result_path: str, process_name: str, tolerance: float = 0.00001) -> pd.DataFrame:
+    """
+    Compares the metrics computed by the C library ("metrics.txt" files) with the ones computed by the default analysis of
+    this module on the kernel trace of the same executions ("trace.txt" or "trace.bin" files).
+
+    Parameters:
+        dir_result_path (str): The path to the directory that contains a subfolder for each execution.
+        process_name (str): The name of the process within the kernel trace that we want to analyze.
+        tolerance (float, optional): The max difference in seconds accepted between two times. The text trace has a
+        resolution of one microsecond, so small differences are expected with it. Default is 0.00001.
+
+    Returns:
+        pandas.DataFrame: A DataFrame with a record for each job whose metrics don't match, containing the execution
+        identifier, the job number, the name of the metric and the two values. It is empty if all the metrics match.
+    """
+    mismatches = pd.DataFrame(columns=["id", "job_number", "metric", "c_value", "python_value"])
+    for dir_name in sorted(os.listdir(dir_result_path)):
+        metrics_file_path = os.path.join(dir_result_path, dir_name, METRICS_FILENAME)
+        trace_file_path = os.path.join(dir_result_path, dir_name, "trace.txt")
+        container_file_path = os.path.join(dir_result_path, dir_name, CONTAINER_FILENAME)
+        if not os.path.exists(metrics_file_path) or not (os.path.exists(trace_file_path) or os.path.exists(container_file_path)):
+            continue
+        c_df = pd.DataFrame(columns=COLUMNS)
+        python_df = pd.DataFrame(columns=COLUMNS)
+        load_job_metrics(df=c_df, identifier=dir_name, metrics_path=metrics_file_path)
+        if os.path.exists(trace_file_path):
+            with open(trace_file_path) as trace_file:
+                analyze_trace(df=python_df, identifier=dir_name, trace_file=trace_file, process_name=process_name)
+        else:
+            analyze_trace_container(df=python_df, identifier=dir_name, container_path=container_file_path, process_name=process_name)
+        merged = c_df.merge(python_df, on=["id", "job_number"], how="outer", suffixes=("_c", "_python"))
+        for _, row in merged.iterrows():
+            for metric in METRICS_COLUMNS[2:]:
+                c_value, python_value = row[metric + "_c"], row[metric + "_python"]
+                is_time = metric.endswith("_time")
+                if pd.isna(c_value) or pd.isna(python_value) or (abs(c_value - python_value) > tolerance if is_time else c_value != python_value):
+                    mismatches.loc[len(mismatches)] = [row["id"], row["job_number"], metric, c_value, python_value]
+    return mismatches
+
+
+def decode_raw_job_marker(data: bytes) -> Tuple[int, str, int, int]:
+    """
+    Decodes a raw_job_marker binary record written by the trace_mark_job_raw_session() or the
+    trace_mark_worker_job_raw_session() function of the C library.
+
+    Parameters:
+        data (bytes): The bytes of the record, starting from the 'id' field.
+
+    Returns:
+        Tuple[int, str, int, int]: A tuple containing the job number, the job state ('start' or 'end'), the payload of the
+        record and the worker that ran the job (0 if the jobs are not run by concurrent workers), or None if the bytes don't
+        represent a job marker.
+    """
+    if len(data) < struct.calcsize(RAW_JOB_MARKER_FORMAT):
+        return None
+    marker_id, job_number, state, worker, payload = struct.unpack_from(RAW_JOB_MARKER_FORMAT, data)
+    if marker_id != RAW_JOB_MARKER_ID or state not in RAW_JOB_MARKER_STATES:
+        return None
+    return job_number, RAW_JOB_MARKER_STATES[state], payload, worker
+
+
 def analyze_trace(df: pd.DataFrame, identifier: str, trace_file: TextIO, process_name: str, states: Tuple[str, str] = ("start", "end"), re_traceline_job: str = TRACE_JOB_LINE_PATTERN, re_traceline_line: str = TRACE_LINE_PATTERN, re_job_group_matcher: dict = None, re_line_group_matcher: dict = None, analysis_function: Callable[[pd.DataFrame, str, TextIO, str], Any] = None):
     """
     Calculates and updates job records of a given pandas DataFrame with execution times and scheduling information
@@ -274,92 +732,93 @@ def analyze_trace(df: pd.DataFrame, identifier: str, trace_file: TextIO, process
     Note:
         If no optional parameters are provided, the function will perform a default analysis regarding executions times
         and scheduling information of jobs whose start and end are marked on the kernel trace, based on the sched_switch
-        event. All of this using default regular expressions and matchers built-in the module.
+        event. All of this using default regular expressions and matchers built-in the module. In this case jobs marked
+        with binary records using the trace_mark_job_raw_session() function of the C library are recognized too. The jobs
+        of the concurrent workers, marked as "start_job=<worker>:<job>", are followed separately through the pids of the
+        markers and of the sched_switch events, and the number of preemptions of each job (switches that left it runnable)
+        is stored in the "num_preemptions" column.
     """
     if analysis_function is None:
         dc.getcontext().prec = 10
         if re_line_group_matcher is None:
             re_line_group_matcher = LINE_GROUP_MATCHER
+        use_raw_markers = re_job_group_matcher is None
         if re_job_group_matcher is None:
             re_job_group_matcher = JOB_GROUP_MATCHER
             re_traceline_job = re.sub(r'test_app', process_name, re_traceline_job)
+        # The jobs in progress are kept per pid, since the concurrent workers run their jobs at the same time. Without the pids
+        # in the matchers, a single job in progress is assumed and the sched_switch events are attributed by process name.
+        use_pids = "pid" in re_job_group_matcher and "prev_pid" in re_line_group_matcher and "next_pid" in re_line_group_matcher
+        jobs: Dict[int, dict] = {}
 
-        previous_timestamp: dc.Decimal = dc.Decimal("NaN")
-        previous_core: str = ""
-        migrations_count: int = 0
-        sched_switches_count: int = 0
-        effective_cpu_time: dc.Decimal = dc.Decimal('0.0')
-        start_timestamp: dc.Decimal = dc.Decimal('0.0')
-        bool_job_started: bool = False
-        current_job_number: int = -1
+        re_traceline_raw_job = re.sub(r'test_app', process_name, TRACE_RAW_JOB_LINE_PATTERN) if use_raw_markers else None
 
         for line in trace_file:
             line.strip()
             match_job = re.search(re_traceline_job, line)
             match_line = re.search(re_traceline_line, line)
+            job_marker = None
 
             if match_job:
-                job_state = match_job.group(re_job_group_matcher["job_state"])
-                job_number = int(match_job.group(re_job_group_matcher["job_number"]))
+                worker = match_job.group(re_job_group_matcher["worker"]) if "worker" in re_job_group_matcher else None
+                job_marker = (match_job.group(re_job_group_matcher["job_state"]),
+                              int(match_job.group(re_job_group_matcher["job_number"])),
+                              match_job.group(re_job_group_matcher["timestamp"]),
+                              match_job.group(re_job_group_matcher["cpu_core"]),
+                              int(worker) if worker is not None else None,
+                              int(match_job.group(re_job_group_matcher["pid"])) if use_pids else 0)
+            elif re_traceline_raw_job is not None and not match_line:
+                match_raw_job = re.search(re_traceline_raw_job, line)
+                if match_raw_job:
+                    raw_data = struct.pack("<I", int(match_raw_job.group(RAW_JOB_GROUP_MATCHER["marker_id"]), 16))
+                    raw_data += bytes.fromhex(match_raw_job.group(RAW_JOB_GROUP_MATCHER["marker_buf"]))
+                    decoded_marker = decode_raw_job_marker(raw_data)
+                    if decoded_marker is not None:
+                        job_marker = (states[0] if decoded_marker[1] == "start" else states[1],
+                                      decoded_marker[0],
+                                      match_raw_job.group(RAW_JOB_GROUP_MATCHER["timestamp"]),
+                                      match_raw_job.group(RAW_JOB_GROUP_MATCHER["cpu_core"]),
+                                      decoded_marker[3] if decoded_marker[3] != 0 else None,
+                                      int(match_raw_job.group(RAW_JOB_GROUP_MATCHER["pid"])) if use_pids else 0)
+
+            if job_marker is not None:
+                job_state, job_number, job_timestamp, job_core, worker, pid = job_marker
+                job = jobs.pop(pid, None)
                 if job_state == states[0]:
-                    start_timestamp = previous_timestamp = dc.Decimal(match_job.group(re_job_group_matcher["timestamp"]))
-                    previous_core = match_job.group(re_job_group_matcher["cpu_core"])
-                    current_job_number = job_number
-                    bool_job_started = True
-                elif job_state == states[1] and job_number == current_job_number:
-                    end_timestamp = dc.Decimal(match_job.group(re_job_group_matcher["timestamp"]))
-                    total_cpu_time = end_timestamp - start_timestamp
-                    effective_cpu_time = total_cpu_time if effective_cpu_time == dc.Decimal('0.0') else effective_cpu_time + (end_timestamp - previous_timestamp)
-                    condition = (df["id"] == identifier) & (df["job_number"] == job_number)
-                    new_values = {
-                        "effective_cpu_time": float(effective_cpu_time.quantize(dc.Decimal('0.000001'))),
-                        "total_cpu_time": float(total_cpu_time.quantize(dc.Decimal('0.000001'))),
-                        "diff_cpu_time": float(total_cpu_time.quantize(dc.Decimal('0.000001')) - effective_cpu_time.quantize(dc.Decimal('0.000001'))),
-                        "num_sched_switches": sched_switches_count,
-                        "num_migrations": migrations_count
-                    }
-                    if condition.any():
-                        df.loc[condition, new_values.keys()] = new_values.values()
-                    else:
-                        new_values["id"] = identifier
-                        new_values["parameter"] = np.NaN
-                        new_values["job_number"] = job_number
-                        new_values["mode"] = np.NaN
-                        new_values["sched_policy"] = np.NaN
-                        new_values["sched_priority"] = np.NaN
-                        df.loc[len(df)] = new_values
-                    previous_timestamp = dc.Decimal("NaN")
-                    previous_core = ""
-                    effective_cpu_time = dc.Decimal('0.0')
-                    migrations_count = 0
-                    sched_switches_count = 0
-                    start_timestamp = dc.Decimal('0.0')
-                    bool_job_started = False
-                    current_job_number = -1
-                elif job_state == states[1] and job_number != current_job_number:
-                    previous_timestamp = dc.Decimal("NaN")
-                    previous_core = ""
-                    effective_cpu_time = dc.Decimal('0.0')
-                    migrations_count = 0
-                    sched_switches_count = 0
-                    start_timestamp = dc.Decimal('0.0')
-                    bool_job_started = False
-                    current_job_number = -1
-
-            if match_line and bool_job_started:
-                prev_comm = match_line.group(re_line_group_matcher["prev_comm"])
+                    jobs[pid] = {"job_number": job_number, "worker": worker, "start_timestamp": dc.Decimal(job_timestamp),
+                                 "previous_timestamp": dc.Decimal(job_timestamp), "previous_core": job_core,
+                                 "effective_cpu_time": dc.Decimal('0.0'), "sched_switches_count": 0,
+                                 "preemptions_count": 0, "migrations_count": 0}
+                elif job_state == states[1] and job is not None and job["job_number"] == job_number and job["worker"] == worker:
+                    end_timestamp = dc.Decimal(job_timestamp)
+                    total_cpu_time = end_timestamp - job["start_timestamp"]
+                    effective_cpu_time = total_cpu_time if job["effective_cpu_time"] == dc.Decimal('0.0') else job["effective_cpu_time"] + (end_timestamp - job["previous_timestamp"])
+                    update_job_record(df, identifier, job_number, effective_cpu_time, total_cpu_time, job["sched_switches_count"],
+                                      job["migrations_count"], worker=worker, preemptions_count=job["preemptions_count"])
+
+            if match_line and jobs:
                 current_cpu_core = match_line.group(re_line_group_matcher["cpu_core"])
                 current_timestamp = dc.Decimal(match_line.group(re_line_group_matcher["timestamp"]))
-                if prev_comm == process_name:
-                    if previous_core != current_cpu_core:
-                        migrations_count += 1
-                        previous_core = current_cpu_core
-                    sched_switches_count += 1
-                    delta_time = current_timestamp - previous_timestamp
-                    effective_cpu_time += delta_time
-                    previous_timestamp = current_timestamp
-                if prev_comm != process_name:
-                    previous_timestamp = current_timestamp
+                if use_pids:
+                    prev_job = jobs.get(int(match_line.group(re_line_group_matcher["prev_pid"])))
+                    next_job = jobs.get(int(match_line.group(re_line_group_matcher["next_pid"])))
+                else:
+                    single_job = next(iter(jobs.values()))
+                    prev_comm = match_line.group(re_line_group_matcher["prev_comm"])
+                    prev_job = single_job if prev_comm == process_name else None
+                    next_job = single_job if prev_comm != process_name else None
+                if prev_job is not None:
+                    if prev_job["previous_core"] != current_cpu_core:
+                        prev_job["migrations_count"] += 1
+                        prev_job["previous_core"] = current_cpu_core
+                    prev_job["sched_switches_count"] += 1
+                    # A job that leaves the CPU while it is still runnable has been preempted
+                    if "prev_state" in re_line_group_matcher and match_line.group(re_line_group_matcher["prev_state"]).startswith("R"):
+                        prev_job["preemptions_count"] += 1
+                    prev_job["effective_cpu_time"] += current_timestamp - prev_job["previous_timestamp"]
+                    prev_job["previous_timestamp"] = current_timestamp
+                if next_job is not None:
+                    next_job["previous_timestamp"] = current_timestamp
     else:
         analysis_function(df, identifier, trace_file, process_name)
 